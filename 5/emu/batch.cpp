@@ -0,0 +1,185 @@
+#include "batch.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "computer.h"
+#include "loader.h"
+#include "thread_pool.h"
+
+namespace Emu {
+
+static bool
+ParseNumber(const std::string& s, long& v)
+{
+    std::size_t used = 0;
+    try {
+        v = std::stol(s, &used);
+    } catch (const std::exception&) {
+        return false;
+    }
+    return used == s.size();
+}
+
+// "addr=value" or "addr==value"
+static bool
+ParseWord(const std::string& token, BatchJob& job)
+{
+    const auto eq = token.find('=');
+    if (eq == std::string::npos) {
+        return false;
+    }
+
+    const bool check = token.compare(eq, 2, "==") == 0;
+    long addr, value;
+    if (!ParseNumber(token.substr(0, eq), addr) ||
+        !ParseNumber(token.substr(eq + (check ? 2 : 1)), value)) {
+        return false;
+    }
+    if (addr < 0 || addr >= static_cast<long>(Computer::RAM_SIZE) || value < -32768 ||
+        value > 65535) {
+        return false;
+    }
+
+    const BatchJob::Word w{ static_cast<std::uint16_t>(addr),
+                            static_cast<std::int16_t>(static_cast<std::uint16_t>(value)) };
+    (check ? job.expect : job.init).push_back(w);
+    return true;
+}
+
+bool
+ReadBatch(const std::string& path, std::vector<BatchJob>& jobs)
+{
+    std::ifstream in{ path };
+    if (!in) {
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return false;
+    }
+
+    const std::filesystem::path dir = std::filesystem::path(path).parent_path();
+
+    std::string line;
+    for (int nol = 1; std::getline(in, line); nol++) {
+        const auto comment = line.find("//");
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+
+        std::istringstream tokens{ line };
+        BatchJob job;
+        if (!(tokens >> job.rom)) {
+            continue;
+        }
+
+        std::string token;
+        long cycles = 0;
+        bool ok     = tokens >> token && ParseNumber(token, cycles) && cycles > 0;
+        while (ok && tokens >> token) {
+            ok = ParseWord(token, job);
+        }
+        if (!ok) {
+            std::cerr << "Invalid batch job (line " << nol << "): " << line << std::endl;
+            return false;
+        }
+
+        job.rom    = (dir / job.rom).string();
+        job.cycles = static_cast<std::uint64_t>(cycles);
+        jobs.push_back(std::move(job));
+    }
+
+    return true;
+}
+
+BatchResult
+RunJob(const BatchJob& job)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    BatchResult r;
+    Computer computer;
+    Labels labels;
+    r.loaded = LoadProgram(computer, job.rom, labels);
+    if (r.loaded) {
+        for (auto&& w : job.init) {
+            computer.Write(w.addr, static_cast<std::uint16_t>(w.value));
+        }
+
+        computer.Run(job.cycles);
+        r.halted = computer.Halted();
+        r.cycles = computer.Cycles();
+
+        r.passed = true;
+        for (auto&& w : job.expect) {
+            const auto v = static_cast<std::int16_t>(computer.Read(w.addr));
+            r.actual.push_back({ w.addr, v });
+            r.passed = r.passed && v == w.value;
+        }
+    }
+
+    r.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+             .count();
+    return r;
+}
+
+std::vector<BatchResult>
+RunBatch(const std::vector<BatchJob>& jobs, std::size_t threads)
+{
+    std::vector<BatchResult> results(jobs.size());
+
+    ThreadPool pool{ threads };
+    for (std::size_t i = 0; i < jobs.size(); i++) {
+        pool.Submit([&jobs, &results, i] { results[i] = RunJob(jobs[i]); });
+    }
+    pool.Wait();
+
+    return results;
+}
+
+std::size_t
+WriteReport(std::ostream& out, const std::vector<BatchJob>& jobs,
+            const std::vector<BatchResult>& results)
+{
+    std::size_t failed = 0;
+    double total_ms    = 0;
+    std::uint64_t total_cycles = 0;
+
+    for (std::size_t i = 0; i < jobs.size(); i++) {
+        const BatchJob& job  = jobs[i];
+        const BatchResult& r = results[i];
+        total_ms += r.ms;
+        total_cycles += r.cycles;
+
+        if (!r.passed) {
+            failed++;
+        }
+
+        char stats[64];
+        std::snprintf(stats, sizeof(stats), "%10llu cycles %8.2f ms",
+                      static_cast<unsigned long long>(r.cycles), r.ms);
+        out << (r.passed ? "PASS " : "FAIL ") << stats << "  " << job.rom;
+        if (!r.loaded) {
+            out << " (not loaded)";
+        }
+        out << "\n";
+
+        for (std::size_t k = 0; k < r.actual.size(); k++) {
+            if (r.actual[k].value != job.expect[k].value) {
+                out << "     RAM[" << job.expect[k].addr << "] = " << r.actual[k].value
+                    << ", expected " << job.expect[k].value << "\n";
+            }
+        }
+    }
+
+    char summary[96];
+    std::snprintf(summary, sizeof(summary), "%zu/%zu passed, %llu cycles, %.2f ms cpu\n",
+                  jobs.size() - failed, jobs.size(),
+                  static_cast<unsigned long long>(total_cycles), total_ms);
+    out << summary;
+    return failed;
+}
+
+} // namespace Emu
@@ -0,0 +1,62 @@
+#ifndef EMU_BATCH_HH
+#define EMU_BATCH_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Emu {
+
+// One program of a batch manifest
+//
+//   // comment
+//   <rom> <cycles> [addr=value ...] [addr==value ...]
+//
+// `addr=value` sets RAM before the run, `addr==value` is checked after it
+// (like `set RAM[addr] value` and the output-list of a .tst/.cmp pair).
+// <rom> is a .hack or .asm file relative to the manifest.
+struct BatchJob
+{
+    struct Word
+    {
+        std::uint16_t addr;
+        std::int16_t value;
+    };
+
+    std::string rom;
+    std::uint64_t cycles{ 0 };
+    std::vector<Word> init;
+    std::vector<Word> expect;
+};
+
+struct BatchResult
+{
+    bool loaded{ false };
+    bool passed{ false };
+    bool halted{ false };
+    std::uint64_t cycles{ 0 };
+    std::vector<BatchJob::Word> actual; // RAM at every expected address
+    double ms{ 0 };
+};
+
+bool
+ReadBatch(const std::string& path, std::vector<BatchJob>& jobs);
+
+// Runs every job in its own Computer on a ThreadPool of `threads` workers
+// (0 = one per core). Results are in job order.
+std::vector<BatchResult>
+RunBatch(const std::vector<BatchJob>& jobs, std::size_t threads = 0);
+
+BatchResult
+RunJob(const BatchJob& job);
+
+// One line per job and a summary. Returns the number of failed jobs.
+std::size_t
+WriteReport(std::ostream& out, const std::vector<BatchJob>& jobs,
+            const std::vector<BatchResult>& results);
+
+} // namespace Emu
+
+#endif
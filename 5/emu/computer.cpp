@@ -0,0 +1,217 @@
+#include "computer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace Emu {
+
+// instruction bits
+// 15 14 13 12 11 10 9 8 7 6 5 4 3 2 1 0
+// 1  1  1  a  c  c  c c c c d d d j j j
+static constexpr std::uint16_t C_INST = 0x8000;
+static constexpr std::uint16_t DEST_A = 0x0020;
+static constexpr std::uint16_t DEST_D = 0x0010;
+static constexpr std::uint16_t DEST_M = 0x0008;
+static constexpr std::uint16_t JGT    = 0x0001;
+static constexpr std::uint16_t JEQ    = 0x0002;
+static constexpr std::uint16_t JLT    = 0x0004;
+
+std::uint16_t
+Alu(std::uint16_t comp, std::uint16_t d, std::uint16_t a, std::uint16_t m)
+{
+    std::uint16_t x = d;
+    std::uint16_t y = (comp & 0x40) ? m : a;
+
+    if (comp & 0x20) x = 0;  // zx
+    if (comp & 0x10) x = ~x; // nx
+    if (comp & 0x08) y = 0;  // zy
+    if (comp & 0x04) y = ~y; // ny
+
+    std::uint16_t out = (comp & 0x02) ? static_cast<std::uint16_t>(x + y) : (x & y); // f
+    if (comp & 0x01) out = ~out;                                                     // no
+
+    return out;
+}
+
+Computer::Computer()
+  : _traps(ROM_SIZE, false)
+{
+}
+
+bool
+Computer::LoadRom(const std::string& path)
+{
+    std::ifstream in{ path };
+    if (!in) {
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return false;
+    }
+
+    std::vector<std::uint16_t> words;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::uint16_t w = 0;
+        int bits        = 0;
+        for (const char c : line) {
+            if (c == '0' || c == '1') {
+                w = static_cast<std::uint16_t>((w << 1) | (c - '0'));
+                bits++;
+            }
+        }
+
+        if (bits == 0) {
+            continue;
+        }
+
+        if (bits != 16) {
+            std::cerr << "Invalid instruction: " << line << std::endl;
+            return false;
+        }
+        words.push_back(w);
+    }
+
+    LoadRom(words);
+    return true;
+}
+
+void
+Computer::LoadRom(const std::vector<std::uint16_t>& words)
+{
+    _rom.fill(0);
+    for (std::size_t i = 0; i < words.size() && i < ROM_SIZE; i++) {
+        _rom[i] = words[i];
+    }
+    Reset();
+}
+
+void
+Computer::Reset()
+{
+    _a      = 0;
+    _d      = 0;
+    _pc     = 0;
+    _cycles = 0;
+    _halted = false;
+    ClearIdle();
+}
+
+void
+Computer::SetCycles(std::uint64_t v)
+{
+    _cycles = v;
+    ClearIdle();
+}
+
+void
+Computer::ClearIdle()
+{
+    _idle = false;
+    _loop = LoopHead{ 0xFFFF, 0, 0, 0, 0 };
+}
+
+void
+Computer::SetTrap(std::uint16_t addr, bool enable)
+{
+    _traps[addr & 0x7FFF] = enable;
+}
+
+void
+Computer::SetProfiling(bool enable)
+{
+    _counts.assign(enable ? ROM_SIZE : 0, 0);
+}
+
+void
+Computer::LoadRam(const std::uint16_t* words)
+{
+    std::copy(words, words + RAM_SIZE, _ram.begin());
+    _screen_dirty.set();
+}
+
+void
+Computer::Write(std::uint16_t addr, std::uint16_t value)
+{
+    addr &= 0x7FFF;
+    _ram[addr] = value;
+    _writes++;
+
+    if (addr >= SCREEN && addr < KBD) {
+        _screen_dirty.set((addr - SCREEN) / ROW_WORDS);
+    }
+}
+
+void
+Computer::Step()
+{
+    const std::uint16_t inst = _rom[_pc];
+    _cycles++;
+    if (!_counts.empty()) {
+        _counts[_pc]++;
+    }
+
+    // A-instruction: @value
+    if (!(inst & C_INST)) {
+        _a = inst;
+        _pc = (_pc + 1) & 0x7FFF;
+        return;
+    }
+
+    const std::uint16_t out = Alu((inst >> 6) & 0x7F, _d, _a, _ram[_a & 0x7FFF]);
+
+    // M is addressed by the A value before this instruction
+    if (inst & DEST_M) {
+        Write(_a, out);
+    }
+    if (inst & DEST_D) {
+        _d = out;
+    }
+
+    const std::uint16_t target = _a; // jump target is the A value before this instruction
+    if (inst & DEST_A) {
+        _a = out;
+    }
+
+    const auto value = static_cast<std::int16_t>(out);
+    const bool jump  = ((inst & JLT) && value < 0) || ((inst & JEQ) && value == 0) ||
+                      ((inst & JGT) && value > 0);
+
+    if (!jump) {
+        _pc = (_pc + 1) & 0x7FFF;
+        return;
+    }
+
+    // `(END) @END 0;JMP` or a jump to itself without side effects never leaves the loop
+    const std::uint16_t dest = target & 0x7FFF;
+    const bool pure          = !(inst & (DEST_A | DEST_D | DEST_M));
+    const bool backward      = dest <= _pc;
+    _halted = pure && (dest == _pc || (dest + 1 == _pc && _rom[dest] == dest));
+    _pc     = dest;
+
+    if (_traps[dest] && _on_trap && _on_trap(*this, dest)) {
+        _halted = false;
+        return;
+    }
+
+    if (_detect_idle && backward) {
+        const LoopHead head{ _pc, _a, _d, _writes, _cycles };
+        if (head.pc == _loop.pc && head.a == _loop.a && head.d == _loop.d &&
+            head.writes == _loop.writes) {
+            _idle        = true;
+            _idle_period = head.cycles - _loop.cycles;
+        }
+        _loop = head;
+    }
+}
+
+std::uint64_t
+Computer::Run(std::uint64_t cycles)
+{
+    const std::uint64_t start = _cycles;
+    while (_cycles - start < cycles && !_halted && !_idle) {
+        Step();
+    }
+    return _cycles - start;
+}
+
+} // namespace Emu
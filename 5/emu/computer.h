@@ -0,0 +1,129 @@
+#ifndef EMU_COMPUTER_HH
+#define EMU_COMPUTER_HH
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Emu {
+
+// Hack computer (CPU + ROM32K + RAM with memory-mapped I/O)
+class Computer
+{
+  public:
+    static constexpr std::size_t ROM_SIZE    = 32768;
+    static constexpr std::size_t RAM_SIZE    = 32768;
+    static constexpr std::uint16_t SCREEN    = 16384;
+    static constexpr std::uint16_t KBD       = 24576;
+    static constexpr std::size_t SCREEN_ROWS = 256;
+    static constexpr std::size_t ROW_WORDS   = 32; // 512 pixels / 16 bits
+
+    Computer();
+
+    // .hack text file: one 16-digit binary word per line
+    bool LoadRom(const std::string& path);
+    void LoadRom(const std::vector<std::uint16_t>& words);
+
+    // PC=0, registers cleared. RAM and ROM are kept.
+    void Reset();
+
+    // 1 instruction = 1 cycle
+    void Step();
+
+    // Runs at most `cycles` instructions. Stops early when halted or idle.
+    // Returns the number of executed instructions.
+    std::uint64_t Run(std::uint64_t cycles);
+
+    // Set when the last instruction jumped to itself (`(END) @END 0;JMP`)
+    bool Halted() const { return _halted; }
+
+    // Idle loop detection (off by default).
+    // A backward jump that lands on the same PC with the same A and D and no
+    // RAM write since the previous landing means the machine repeats the same
+    // IdlePeriod() cycles until some input (KBD) changes, e.g. a poll on KBD.
+    void SetIdleDetection(bool enable) { _detect_idle = enable; }
+    bool Idle() const { return _idle; }
+    std::uint64_t IdlePeriod() const { return _idle_period; }
+    void ClearIdle();
+
+    // Execution count of every ROM address (off by default, see profile.h).
+    // Turning it on starts the counts from zero.
+    void SetProfiling(bool enable);
+    const std::vector<std::uint64_t>& Counts() const { return _counts; }
+
+    std::uint16_t Read(std::uint16_t addr) const { return _ram[addr & 0x7FFF]; }
+    void Write(std::uint16_t addr, std::uint16_t value);
+
+    std::uint16_t A() const { return _a; }
+    std::uint16_t D() const { return _d; }
+    std::uint16_t PC() const { return _pc; }
+    std::uint64_t Cycles() const { return _cycles; }
+
+    void SetA(std::uint16_t v) { _a = v; }
+    void SetD(std::uint16_t v) { _d = v; }
+    void SetPC(std::uint16_t v)
+    {
+        _pc     = v & 0x7FFF;
+        _halted = false;
+        ClearIdle();
+    }
+
+    // Moves the clock without executing (fast-forward, snapshots)
+    void SetCycles(std::uint64_t v);
+
+    const std::uint16_t* Ram() const { return _ram.data(); }
+    const std::uint16_t* Rom() const { return _rom.data(); }
+
+    // Replaces the whole RAM (RAM_SIZE words). Every SCREEN row becomes dirty.
+    void LoadRam(const std::uint16_t* words);
+
+    // Called when a jump lands on an address marked with SetTrap().
+    // The handler returns true when it has taken over the jump (and set the PC itself).
+    using TrapHandler = std::function<bool(Computer&, std::uint16_t addr)>;
+    void SetTrap(std::uint16_t addr, bool enable);
+    void SetTrapHandler(TrapHandler handler) { _on_trap = std::move(handler); }
+
+    // Rows of SCREEN written since the last ClearScreenDirty()
+    const std::bitset<SCREEN_ROWS>& ScreenDirty() const { return _screen_dirty; }
+    void ClearScreenDirty() { _screen_dirty.reset(); }
+
+  private:
+    std::array<std::uint16_t, ROM_SIZE> _rom{};
+    std::array<std::uint16_t, RAM_SIZE> _ram{};
+    std::uint16_t _a{ 0 };
+    std::uint16_t _d{ 0 };
+    std::uint16_t _pc{ 0 };
+    std::uint64_t _cycles{ 0 };
+    bool _halted{ false };
+    std::bitset<SCREEN_ROWS> _screen_dirty{};
+    std::vector<bool> _traps;
+    TrapHandler _on_trap;
+    std::vector<std::uint64_t> _counts; // empty unless profiling
+
+    struct LoopHead
+    {
+        std::uint16_t pc;
+        std::uint16_t a;
+        std::uint16_t d;
+        std::uint64_t writes;
+        std::uint64_t cycles;
+    };
+
+    bool _detect_idle{ false };
+    bool _idle{ false };
+    std::uint64_t _idle_period{ 0 };
+    std::uint64_t _writes{ 0 };
+    LoopHead _loop{ 0xFFFF, 0, 0, 0, 0 };
+};
+
+// ALU of the Hack CPU. `comp` is the 7 bit field "a c1..c6".
+std::uint16_t
+Alu(std::uint16_t comp, std::uint16_t d, std::uint16_t a, std::uint16_t m);
+
+} // namespace Emu
+
+#endif
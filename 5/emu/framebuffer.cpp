@@ -0,0 +1,159 @@
+#include "framebuffer.h"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace Emu {
+
+static constexpr std::uint8_t BLACK = 0x00;
+static constexpr std::uint8_t WHITE = 0xFF;
+
+// 1 byte (8 pixels) -> 8 gray bytes
+static constexpr auto EXPAND_TABLE = [] {
+    std::array<std::array<std::uint8_t, 8>, 256> tbl{};
+    for (std::size_t b = 0; b < 256; b++) {
+        for (std::size_t i = 0; i < 8; i++) {
+            tbl[b][i] = (b >> i) & 1 ? BLACK : WHITE;
+        }
+    }
+    return tbl;
+}();
+
+void
+ExpandWordsScalar(const std::uint16_t* words, std::size_t n, std::uint8_t* out)
+{
+    for (std::size_t i = 0; i < n; i++) {
+        std::memcpy(out + i * 16, EXPAND_TABLE[words[i] & 0xFF].data(), 8);
+        std::memcpy(out + i * 16 + 8, EXPAND_TABLE[words[i] >> 8].data(), 8);
+    }
+}
+
+void
+ExpandWords(const std::uint16_t* words, std::size_t n, std::uint8_t* out)
+{
+#if defined(__SSE2__)
+    // byte k of the register tests bit (k % 8) of the low/high byte of the word
+    const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m128i zero = _mm_setzero_si128();
+
+    for (std::size_t i = 0; i < n; i++) {
+        const __m128i lo = _mm_set1_epi8(static_cast<char>(words[i] & 0xFF));
+        const __m128i hi = _mm_set1_epi8(static_cast<char>(words[i] >> 8));
+        const __m128i v  = _mm_unpacklo_epi64(lo, hi);
+
+        // cleared bit -> 0xFF (white), set bit -> 0x00 (black)
+        const __m128i px = _mm_cmpeq_epi8(_mm_and_si128(v, bits), zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 16), px);
+    }
+#else
+    ExpandWordsScalar(words, n, out);
+#endif
+}
+
+Framebuffer::Framebuffer(Format format)
+  : _format(format)
+  , _pixels(WIDTH * HEIGHT * BytesPerPixel(), WHITE)
+{
+}
+
+void
+Framebuffer::ExpandRow(const std::uint16_t* words, std::size_t row)
+{
+    if (_format == Format::Gray) {
+        ExpandWords(words, Computer::ROW_WORDS, &_pixels[row * WIDTH]);
+        return;
+    }
+
+    std::array<std::uint8_t, WIDTH> gray;
+    ExpandWords(words, Computer::ROW_WORDS, gray.data());
+
+    std::uint8_t* dst = &_pixels[row * WIDTH * 4];
+    for (std::size_t x = 0; x < WIDTH; x++) {
+        dst[x * 4 + 0] = gray[x];
+        dst[x * 4 + 1] = gray[x];
+        dst[x * 4 + 2] = gray[x];
+        dst[x * 4 + 3] = 0xFF;
+    }
+}
+
+std::size_t
+Framebuffer::Update(Computer& computer)
+{
+    const auto& dirty = computer.ScreenDirty();
+    if (dirty.none()) {
+        return 0;
+    }
+
+    const std::uint16_t* screen = computer.Ram() + Computer::SCREEN;
+
+    std::size_t n = 0;
+    for (std::size_t row = 0; row < HEIGHT; row++) {
+        if (dirty.test(row)) {
+            ExpandRow(screen + row * Computer::ROW_WORDS, row);
+            n++;
+        }
+    }
+
+    computer.ClearScreenDirty();
+    return n;
+}
+
+void
+Framebuffer::Redraw(const Computer& computer)
+{
+    const std::uint16_t* screen = computer.Ram() + Computer::SCREEN;
+    for (std::size_t row = 0; row < HEIGHT; row++) {
+        ExpandRow(screen + row * Computer::ROW_WORDS, row);
+    }
+}
+
+bool
+Framebuffer::Write(const std::string& path) const
+{
+    std::ofstream out{ path, std::ios::out | std::ios::binary | std::ios::trunc };
+    if (!out) {
+        std::cerr << "Failed to open the file(" << path << ")\n";
+        return false;
+    }
+
+    if (_format == Format::Gray) {
+        out << "P5\n" << WIDTH << " " << HEIGHT << "\n255\n";
+        out.write(reinterpret_cast<const char*>(_pixels.data()), _pixels.size());
+        return static_cast<bool>(out);
+    }
+
+    std::vector<std::uint8_t> rgb(WIDTH * HEIGHT * 3);
+    for (std::size_t i = 0; i < WIDTH * HEIGHT; i++) {
+        rgb[i * 3 + 0] = _pixels[i * 4 + 0];
+        rgb[i * 3 + 1] = _pixels[i * 4 + 1];
+        rgb[i * 3 + 2] = _pixels[i * 4 + 2];
+    }
+
+    out << "P6\n" << WIDTH << " " << HEIGHT << "\n255\n";
+    out.write(reinterpret_cast<const char*>(rgb.data()), rgb.size());
+    return static_cast<bool>(out);
+}
+
+std::uint64_t
+ScreenChecksum(const Computer& computer)
+{
+    constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    constexpr std::uint64_t FNV_PRIME  = 1099511628211ULL;
+
+    const std::uint16_t* screen = computer.Ram() + Computer::SCREEN;
+
+    std::uint64_t h = FNV_OFFSET;
+    for (std::size_t i = 0; i < Computer::KBD - Computer::SCREEN; i++) {
+        h = (h ^ (screen[i] & 0xFF)) * FNV_PRIME;
+        h = (h ^ (screen[i] >> 8)) * FNV_PRIME;
+    }
+    return h;
+}
+
+} // namespace Emu
@@ -0,0 +1,62 @@
+#ifndef EMU_FRAMEBUFFER_HH
+#define EMU_FRAMEBUFFER_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "computer.h"
+
+namespace Emu {
+
+// Headless capture of the SCREEN memory map (512x256, 1 bit per pixel)
+class Framebuffer
+{
+  public:
+    static constexpr std::size_t WIDTH  = 512;
+    static constexpr std::size_t HEIGHT = 256;
+
+    enum class Format
+    {
+        Gray, // 1 byte per pixel
+        Rgba  // 4 bytes per pixel
+    };
+
+    explicit Framebuffer(Format format = Format::Gray);
+
+    // Expands the rows written since the last update and clears the dirty set.
+    // Returns the number of rows expanded.
+    std::size_t Update(Computer& computer);
+
+    // Expands every row regardless of the dirty set
+    void Redraw(const Computer& computer);
+
+    Format GetFormat() const { return _format; }
+    std::size_t BytesPerPixel() const { return _format == Format::Rgba ? 4 : 1; }
+    const std::vector<std::uint8_t>& Pixels() const { return _pixels; }
+
+    // .pgm for Gray, .ppm (alpha dropped) for Rgba
+    bool Write(const std::string& path) const;
+
+  private:
+    void ExpandRow(const std::uint16_t* words, std::size_t row);
+
+    Format _format;
+    std::vector<std::uint8_t> _pixels;
+};
+
+// FNV-1a over the 8K words of SCREEN. Independent of the pixel format.
+std::uint64_t
+ScreenChecksum(const Computer& computer);
+
+// bit-to-byte kernels: 16 pixels of one word -> 16 gray bytes
+// (bit 0 is the left-most pixel, 1 = black = 0x00, 0 = white = 0xFF)
+void
+ExpandWordsScalar(const std::uint16_t* words, std::size_t n, std::uint8_t* out);
+void
+ExpandWords(const std::uint16_t* words, std::size_t n, std::uint8_t* out);
+
+} // namespace Emu
+
+#endif
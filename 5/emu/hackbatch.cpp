@@ -0,0 +1,52 @@
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "batch.h"
+
+static void
+Usage()
+{
+    std::cout << "Usage: hackbatch <manifest> [--threads N]\n";
+    std::cout << "  manifest lines: <rom> <cycles> [addr=value ...] [addr==value ...]\n";
+    std::cout << "  --threads N      : worker threads (default: one per core)\n";
+}
+
+int
+main(int argc, char const* argv[])
+{
+    std::string manifest;
+    std::size_t threads = 0;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            threads = std::stoul(argv[++i]);
+        } else if (manifest.empty() && !arg.empty() && arg.front() != '-') {
+            manifest = arg;
+        } else {
+            Usage();
+            return -1;
+        }
+    }
+    if (manifest.empty()) {
+        Usage();
+        return -1;
+    }
+
+    std::vector<Emu::BatchJob> jobs;
+    if (!Emu::ReadBatch(manifest, jobs)) {
+        return -1;
+    }
+
+    const auto start   = std::chrono::steady_clock::now();
+    const auto results = Emu::RunBatch(jobs, threads);
+    const double ms =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    const std::size_t failed = Emu::WriteReport(std::cout, jobs, results);
+    std::printf("wall %.2f ms\n", ms);
+
+    return failed == 0 ? 0 : 1;
+}
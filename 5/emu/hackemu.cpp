@@ -0,0 +1,188 @@
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "computer.h"
+#include "framebuffer.h"
+#include "input_script.h"
+#include "intrinsics.h"
+#include "loader.h"
+#include "profile.h"
+#include "snapshot.h"
+
+static void
+Usage()
+{
+    std::cout << "Usage: hackemu <in.hack|in.asm> [options]\n";
+    std::cout << "  --cycles N       : max number of instructions (default 10000000)\n";
+    std::cout << "  --frame-every N  : capture the screen every N cycles\n";
+    std::cout << "  --frames DIR     : write captured frames to DIR/frame_NNNNN.pgm\n";
+    std::cout << "  --rgba           : write frames as .ppm instead of .pgm\n";
+    std::cout << "  --checksum       : print a checksum of every captured frame\n";
+    std::cout << "  --load-snapshot F: restore RAM/PC/A/D from F before running\n";
+    std::cout << "  --save-snapshot F: save RAM/PC/A/D to F after running\n";
+    std::cout << "  --compress       : compress the saved snapshot\n";
+    std::cout << "  --symbols F      : label addresses for .hack input (hackasm sym-path)\n";
+    std::cout << "  --intrinsics     : run known Jack OS functions natively\n";
+    std::cout << "  --input F        : replay keyboard events (<cycle> <key> per line)\n";
+    std::cout << "  --fast-forward   : skip idle loops (e.g. polling KBD) to the next event\n";
+    std::cout << "  --profile F      : write execution counts by label to F, for vm --profile\n";
+}
+
+struct Options
+{
+    std::string rom;
+    std::uint64_t cycles      = 10'000'000;
+    std::uint64_t frame_every = 0;
+    std::string frames_dir;
+    bool rgba     = false;
+    bool checksum = false;
+    std::string load_snapshot;
+    std::string save_snapshot;
+    bool compress = false;
+    std::string symbols;
+    bool intrinsics = false;
+    std::string input;
+    bool fast_forward = false;
+    std::string profile;
+};
+
+static bool
+ParseArgs(int argc, char const* argv[], Options& opt)
+{
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool has_value  = i + 1 < argc;
+
+        if (arg == "--cycles" && has_value) {
+            opt.cycles = std::stoull(argv[++i]);
+        } else if (arg == "--frame-every" && has_value) {
+            opt.frame_every = std::stoull(argv[++i]);
+        } else if (arg == "--frames" && has_value) {
+            opt.frames_dir = argv[++i];
+        } else if (arg == "--rgba") {
+            opt.rgba = true;
+        } else if (arg == "--checksum") {
+            opt.checksum = true;
+        } else if (arg == "--load-snapshot" && has_value) {
+            opt.load_snapshot = argv[++i];
+        } else if (arg == "--save-snapshot" && has_value) {
+            opt.save_snapshot = argv[++i];
+        } else if (arg == "--compress") {
+            opt.compress = true;
+        } else if (arg == "--symbols" && has_value) {
+            opt.symbols = argv[++i];
+        } else if (arg == "--intrinsics") {
+            opt.intrinsics = true;
+        } else if (arg == "--input" && has_value) {
+            opt.input = argv[++i];
+        } else if (arg == "--fast-forward") {
+            opt.fast_forward = true;
+        } else if (arg == "--profile" && has_value) {
+            opt.profile = argv[++i];
+        } else if (opt.rom.empty() && !arg.empty() && arg.front() != '-') {
+            opt.rom = arg;
+        } else {
+            return false;
+        }
+    }
+
+    return !opt.rom.empty();
+}
+
+int
+main(int argc, char const* argv[])
+{
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        Usage();
+        return -1;
+    }
+
+    Emu::Computer computer;
+    Emu::Labels labels;
+    if (!Emu::LoadProgram(computer, opt.rom, labels)) {
+        return -1;
+    }
+
+    if (!opt.symbols.empty() && !Emu::ReadSymbols(opt.symbols, labels)) {
+        return -1;
+    }
+
+    // counts are only worth writing against names
+    if (!opt.profile.empty() && labels.empty()) {
+        std::cerr << "--profile needs labels: .asm input or --symbols\n";
+        return -1;
+    }
+    computer.SetProfiling(!opt.profile.empty());
+
+    Emu::Intrinsics intrinsics;
+    if (opt.intrinsics) {
+        std::cout << "intrinsics: " << intrinsics.Install(computer, labels) << "\n";
+    }
+
+    if (!opt.load_snapshot.empty() && !Emu::LoadSnapshot(computer, opt.load_snapshot)) {
+        return -1;
+    }
+
+    Emu::InputScript script;
+    if (!opt.input.empty() && !script.Load(opt.input)) {
+        return -1;
+    }
+    Emu::InputScript* input = opt.input.empty() ? nullptr : &script;
+    computer.SetIdleDetection(opt.fast_forward);
+
+    const bool capture = opt.frame_every > 0 && (opt.checksum || !opt.frames_dir.empty());
+    const auto format  = opt.rgba ? Emu::Framebuffer::Format::Rgba : Emu::Framebuffer::Format::Gray;
+    Emu::Framebuffer fb{ format };
+
+    std::uint64_t frame = 0;
+    bool waiting        = false;
+    while (computer.Cycles() < opt.cycles && !computer.Halted() && !waiting) {
+        const std::uint64_t left  = opt.cycles - computer.Cycles();
+        const std::uint64_t slice = capture && opt.frame_every < left ? opt.frame_every : left;
+        waiting = !Emu::RunWithInput(computer, input, computer.Cycles() + slice);
+
+        if (!capture) {
+            continue;
+        }
+
+        if (opt.checksum) {
+            std::printf("frame %05llu cycle %llu checksum %016llx\n",
+                        static_cast<unsigned long long>(frame),
+                        static_cast<unsigned long long>(computer.Cycles()),
+                        static_cast<unsigned long long>(Emu::ScreenChecksum(computer)));
+        }
+
+        if (!opt.frames_dir.empty()) {
+            fb.Update(computer);
+
+            char name[32];
+            std::snprintf(name, sizeof(name), "/frame_%05llu.%s",
+                          static_cast<unsigned long long>(frame), opt.rgba ? "ppm" : "pgm");
+            fb.Write(opt.frames_dir + name);
+        }
+
+        frame++;
+    }
+
+    if (!opt.save_snapshot.empty() &&
+        !Emu::SaveSnapshot(computer, opt.save_snapshot, opt.compress)) {
+        return -1;
+    }
+
+    if (!opt.profile.empty() && !Emu::SaveProfile(computer, labels, opt.profile)) {
+        return -1;
+    }
+
+    std::cout << "cycles: " << computer.Cycles() << (computer.Halted() ? " (halted)" : "")
+              << (waiting ? " (waiting for input)" : "") << "\n";
+    if (opt.intrinsics) {
+        std::cout << "intrinsic calls: " << intrinsics.Calls() << "\n";
+    }
+    std::cout << "PC: " << computer.PC() << " A: " << computer.A() << " D: " << computer.D()
+              << "\n";
+
+    return 0;
+}
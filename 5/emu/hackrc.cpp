@@ -0,0 +1,82 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <string>
+
+#include "computer.h"
+#include "loader.h"
+#include "recompile.h"
+
+static void
+Usage()
+{
+    std::cout << "Usage: hackrc <in.hack|in.asm> [options]\n";
+    std::cout << "  writes the program as C++ to build natively, e.g. c++ -O2 out.cpp -o prog\n";
+    std::cout << "  --symbols F      : label addresses for .hack input (hackasm sym-path)\n";
+    std::cout << "  -o out.cpp       : output (default: <in>.cpp)\n";
+}
+
+int
+main(int argc, char const* argv[])
+{
+    std::string rom;
+    std::string symbols;
+    std::string out_path;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--symbols" && i + 1 < argc) {
+            symbols = argv[++i];
+        } else if (arg == "-o" && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (rom.empty() && !arg.empty() && arg.front() != '-') {
+            rom = arg;
+        } else {
+            Usage();
+            return -1;
+        }
+    }
+    if (rom.empty()) {
+        Usage();
+        return -1;
+    }
+    if (out_path.empty()) {
+        out_path = std::filesystem::path(rom).replace_extension(".cpp").string();
+    }
+
+    Emu::Computer computer;
+    Emu::Labels labels;
+    if (!Emu::LoadProgram(computer, rom, labels)) {
+        return -1;
+    }
+    if (!symbols.empty() && !Emu::ReadSymbols(symbols, labels)) {
+        return -1;
+    }
+    // return addresses are only known as labels
+    if (labels.empty()) {
+        std::cerr << "hackrc needs labels: .asm input or --symbols\n";
+        return -1;
+    }
+
+    // the image without the cleared ROM after it
+    std::size_t size = Emu::Computer::ROM_SIZE;
+    while (size > 0 && computer.Rom()[size - 1] == 0) {
+        size--;
+    }
+
+    std::ofstream out{ out_path };
+    if (!out) {
+        std::cerr << "Failed to open file: " << out_path << std::endl;
+        return -1;
+    }
+    const Emu::Recompiled stats = Emu::Recompile(std::span{ computer.Rom(), size }, labels, out);
+    if (!out) {
+        return -1;
+    }
+
+    std::cout << size << " instructions, " << stats.blocks << " blocks, " << stats.direct << " direct and "
+              << stats.indirect << " indirect jumps\n";
+    std::cout << "out: " << out_path << "\n";
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "test_script.h"
+#include "thread_pool.h"
+
+static void
+Usage()
+{
+    std::cout << "Usage: hacktst <script.tst>... [--threads N]\n";
+    std::cout << "  runs CPU emulator and VM emulator test scripts against their .cmp files\n";
+    std::cout << "  --threads N      : worker threads (default: one per core)\n";
+}
+
+int
+main(int argc, char const* argv[])
+{
+    std::vector<std::string> scripts;
+    std::size_t threads = 0;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            threads = std::stoul(argv[++i]);
+        } else if (!arg.empty() && arg.front() != '-') {
+            scripts.push_back(arg);
+        } else {
+            Usage();
+            return -1;
+        }
+    }
+    if (scripts.empty()) {
+        Usage();
+        return -1;
+    }
+
+    std::vector<Emu::ScriptResult> results(scripts.size());
+    {
+        Emu::ThreadPool pool{ threads };
+        for (std::size_t i = 0; i < scripts.size(); i++) {
+            pool.Submit([&scripts, &results, i] { results[i] = Emu::RunTestScript(scripts[i]); });
+        }
+        pool.Wait();
+    }
+
+    std::size_t failed = 0;
+    for (std::size_t i = 0; i < scripts.size(); i++) {
+        const Emu::ScriptResult& r = results[i];
+        const double rate          = r.ms > 0 ? r.steps / r.ms / 1000.0 : 0;
+
+        std::printf("%s %s %10llu %s %8.2f ms %8.2f M/s %3zu lines  %s\n",
+                    r.passed ? "PASS" : "FAIL", r.vm ? "vm " : "cpu",
+                    static_cast<unsigned long long>(r.steps), r.vm ? "steps " : "cycles", r.ms,
+                    rate, r.compared, scripts[i].c_str());
+        if (!r.passed) {
+            std::printf("     %s\n", r.error.c_str());
+            failed++;
+        }
+    }
+    std::printf("%zu/%zu passed\n", scripts.size() - failed, scripts.size());
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,145 @@
+#include "input_script.h"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+namespace Emu {
+
+// Hack character set (Figure 5.5)
+static const std::map<std::string, std::uint16_t> KEY_NAMES = {
+    { "NONE", 0 },       { "SPACE", 32 },     { "NEWLINE", 128 }, { "BACKSPACE", 129 },
+    { "LEFT", 130 },     { "UP", 131 },       { "RIGHT", 132 },   { "DOWN", 133 },
+    { "HOME", 134 },     { "END", 135 },      { "PAGEUP", 136 },  { "PAGEDOWN", 137 },
+    { "INSERT", 138 },   { "DELETE", 139 },   { "ESC", 140 },     { "F1", 141 },
+    { "F2", 142 },       { "F3", 143 },       { "F4", 144 },      { "F5", 145 },
+    { "F6", 146 },       { "F7", 147 },       { "F8", 148 },      { "F9", 149 },
+    { "F10", 150 },      { "F11", 151 },      { "F12", 152 },
+};
+
+// The whole of `token` as a decimal number that fits T
+template <class T>
+static bool
+ParseNumber(const std::string& token, T& value)
+{
+    const char* end = token.data() + token.size();
+    const auto r    = std::from_chars(token.data(), end, value);
+    return r.ec == std::errc{} && r.ptr == end;
+}
+
+static bool
+ParseKey(const std::string& token, std::uint16_t& key)
+{
+    if (token.size() == 3 && token.front() == '\'' && token.back() == '\'') {
+        key = static_cast<unsigned char>(token[1]);
+        return true;
+    }
+
+    if (std::ranges::all_of(token, [](const char c) { return std::isdigit(c) != 0; })) {
+        return ParseNumber(token, key);
+    }
+
+    const auto it = KEY_NAMES.find(token);
+    if (it != KEY_NAMES.end()) {
+        key = it->second;
+        return true;
+    }
+
+    return false;
+}
+
+bool
+InputScript::Load(const std::string& path)
+{
+    std::ifstream in{ path };
+    if (!in) {
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return false;
+    }
+
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return Parse(ss.str());
+}
+
+bool
+InputScript::Parse(const std::string& text)
+{
+    _events.clear();
+    _next = 0;
+
+    std::istringstream in{ text };
+    std::string line;
+    for (int nol = 1; std::getline(in, line); nol++) {
+        const auto comment = line.find("//");
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+
+        std::istringstream tokens{ line };
+        std::string cycle, key;
+        if (!(tokens >> cycle)) {
+            continue;
+        }
+
+        Event e{};
+        const bool ok = tokens >> key && ParseNumber(cycle, e.cycle) && ParseKey(key, e.key);
+        if (!ok || (!_events.empty() && e.cycle < _events.back().cycle)) {
+            std::cerr << "Invalid input event (line " << nol << "): " << line << std::endl;
+            return false;
+        }
+
+        _events.push_back(e);
+    }
+
+    return true;
+}
+
+bool
+InputScript::Apply(Computer& computer)
+{
+    bool written = false;
+    while (HasMore() && _events[_next].cycle <= computer.Cycles()) {
+        computer.Write(Computer::KBD, _events[_next].key);
+        written = true;
+        _next++;
+    }
+    return written;
+}
+
+bool
+RunWithInput(Computer& computer, InputScript* script, std::uint64_t until)
+{
+    while (computer.Cycles() < until && !computer.Halted()) {
+        if (script && script->Apply(computer)) {
+            computer.ClearIdle();
+        }
+
+        const std::uint64_t next = script ? std::min(script->NextCycle(), until) : until;
+        computer.Run(next - computer.Cycles());
+
+        if (!computer.Idle()) {
+            continue;
+        }
+
+        // waiting for input that never comes
+        if (!script || !script->HasMore()) {
+            return false;
+        }
+
+        // skip whole loop periods: the state at the loop head is the same every time
+        const std::uint64_t target = std::min(script->NextCycle(), until);
+        const std::uint64_t period = computer.IdlePeriod();
+        computer.SetCycles(computer.Cycles() + (target - computer.Cycles()) / period * period);
+    }
+
+    if (script) {
+        script->Apply(computer);
+    }
+    return true;
+}
+
+} // namespace Emu
@@ -0,0 +1,60 @@
+#ifndef EMU_INPUT_SCRIPT_HH
+#define EMU_INPUT_SCRIPT_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "computer.h"
+
+namespace Emu {
+
+// Recorded keyboard input
+//
+//   // comment
+//   <cycle> <key>
+//
+// <key> is a Hack key code (0 = released), a quoted character ('q') or a
+// key name (NEWLINE, BACKSPACE, LEFT, UP, RIGHT, DOWN, HOME, END, PAGEUP,
+// PAGEDOWN, INSERT, DELETE, ESC, F1-F12, SPACE, NONE).
+// Events must be sorted by cycle.
+class InputScript
+{
+  public:
+    struct Event
+    {
+        std::uint64_t cycle;
+        std::uint16_t key;
+    };
+
+    static constexpr std::uint64_t NEVER = std::numeric_limits<std::uint64_t>::max();
+
+    bool Load(const std::string& path);
+    bool Parse(const std::string& text);
+
+    // Writes KBD for every event due at the current cycle.
+    // Returns true when KBD was written.
+    bool Apply(Computer& computer);
+
+    bool HasMore() const { return _next < _events.size(); }
+    std::uint64_t NextCycle() const { return HasMore() ? _events[_next].cycle : NEVER; }
+
+    const std::vector<Event>& Events() const { return _events; }
+
+  private:
+    std::vector<Event> _events;
+    std::size_t _next{ 0 };
+};
+
+// Runs until `until` cycles, replaying `script` (may be null).
+// With idle detection on, a loop that waits for input is skipped ahead in whole
+// loop periods to the next scripted event, so the cycle count stays exact.
+// Returns false when the machine is idle and no more input will come.
+bool
+RunWithInput(Computer& computer, InputScript* script, std::uint64_t until);
+
+} // namespace Emu
+
+#endif
@@ -0,0 +1,266 @@
+#include "intrinsics.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace Emu {
+
+// VM segment pointers
+static constexpr std::uint16_t SP   = 0;
+static constexpr std::uint16_t LCL  = 1;
+static constexpr std::uint16_t ARG  = 2;
+static constexpr std::uint16_t THIS = 3;
+static constexpr std::uint16_t THAT = 4;
+static constexpr std::uint16_t R13  = 13;
+static constexpr std::uint16_t R14  = 14;
+
+static constexpr std::size_t MAX_ARGS = 4;
+
+static std::int16_t
+Signed(std::uint16_t v)
+{
+    return static_cast<std::int16_t>(v);
+}
+
+static std::uint16_t
+Word(int v)
+{
+    return static_cast<std::uint16_t>(v);
+}
+
+std::optional<CallFrame>
+EnteredFrame(const Computer& computer, std::size_t n_args)
+{
+    // the sizes of retAddr [LCL] ARG [THIS THAT]
+    const int size = computer.Read(SP) - computer.Read(ARG) - static_cast<int>(n_args);
+    if (size < 2 || size > 5) {
+        return std::nullopt;
+    }
+    return CallFrame{ static_cast<std::uint16_t>(n_args), static_cast<std::uint16_t>(size), size % 2 == 1,
+                      size >= 4 };
+}
+
+void
+ReturnFromFunction(Computer& computer, std::uint16_t value, const CallFrame& frame)
+{
+    // same steps (and R13/R14/D side effects) as CodeWriter::WriteReturn
+    const std::uint16_t arg = computer.Read(ARG);
+    std::uint16_t end       = frame.lcl ? computer.Read(LCL) : arg + frame.n_args + frame.size;
+    const std::uint16_t ret = computer.Read(end - frame.size);
+
+    computer.Write(arg, value);
+    computer.Write(SP, arg + 1);
+
+    // walk down the saved registers; D keeps the last one
+    std::uint16_t d = 0;
+    auto restore    = [&computer, &end, &d](std::uint16_t reg) {
+        d = computer.Read(--end);
+        computer.Write(reg, d);
+    };
+    if (frame.this_that) {
+        restore(THAT);
+        restore(THIS);
+    }
+    restore(ARG);
+    if (frame.lcl) {
+        restore(LCL);
+    }
+    computer.Write(R13, end);
+    computer.Write(R14, ret);
+
+    computer.SetD(d);
+    computer.SetA(ret);
+    computer.SetPC(ret);
+}
+
+using Result = std::optional<std::uint16_t>;
+
+// Math
+static Result
+MathMultiply(Computer&, const std::uint16_t* a)
+{
+    return Word(Signed(a[0]) * Signed(a[1]));
+}
+
+static Result
+MathDivide(Computer&, const std::uint16_t* a)
+{
+    // let the Jack code report the error
+    if (a[1] == 0) {
+        return std::nullopt;
+    }
+    return Word(Signed(a[0]) / Signed(a[1]));
+}
+
+static Result
+MathSqrt(Computer&, const std::uint16_t* a)
+{
+    if (Signed(a[0]) < 0) {
+        return std::nullopt;
+    }
+
+    int y = static_cast<int>(std::sqrt(static_cast<double>(a[0])));
+    while (y * y > a[0]) {
+        y--;
+    }
+    while ((y + 1) * (y + 1) <= a[0]) {
+        y++;
+    }
+    return Word(y);
+}
+
+static Result
+MathMin(Computer&, const std::uint16_t* a)
+{
+    return Word(std::min(Signed(a[0]), Signed(a[1])));
+}
+
+static Result
+MathMax(Computer&, const std::uint16_t* a)
+{
+    return Word(std::max(Signed(a[0]), Signed(a[1])));
+}
+
+static Result
+MathAbs(Computer&, const std::uint16_t* a)
+{
+    return Word(Signed(a[0]) < 0 ? -Signed(a[0]) : Signed(a[0]));
+}
+
+// Memory
+static Result
+MemoryPeek(Computer& c, const std::uint16_t* a)
+{
+    return c.Read(a[0]);
+}
+
+static Result
+MemoryPoke(Computer& c, const std::uint16_t* a)
+{
+    c.Write(a[0], a[1]);
+    return 0;
+}
+
+// Screen
+static Result
+ScreenClearScreen(Computer& c, const std::uint16_t*)
+{
+    for (std::uint16_t addr = Computer::SCREEN; addr < Computer::KBD; addr++) {
+        c.Write(addr, 0);
+    }
+    return 0;
+}
+
+// String: the character constants; everything else needs the heap
+static Result
+StringNewLine(Computer&, const std::uint16_t*)
+{
+    return 128;
+}
+
+static Result
+StringBackSpace(Computer&, const std::uint16_t*)
+{
+    return 129;
+}
+
+static Result
+StringDoubleQuote(Computer&, const std::uint16_t*)
+{
+    return 34;
+}
+
+// Sys
+static Result
+SysWait(Computer&, const std::uint16_t* a)
+{
+    // the only effect of a busy wait is time: return at once
+    if (Signed(a[0]) < 0) {
+        return std::nullopt;
+    }
+    return 0;
+}
+
+Intrinsics::Intrinsics()
+  : _known{
+      { "Math.multiply", { 2, MathMultiply } },
+      { "Math.divide", { 2, MathDivide } },
+      { "Math.sqrt", { 1, MathSqrt } },
+      { "Math.min", { 2, MathMin } },
+      { "Math.max", { 2, MathMax } },
+      { "Math.abs", { 1, MathAbs } },
+      { "Memory.peek", { 1, MemoryPeek } },
+      { "Memory.poke", { 2, MemoryPoke } },
+      { "Screen.clearScreen", { 0, ScreenClearScreen } },
+      { "String.newLine", { 0, StringNewLine } },
+      { "String.backSpace", { 0, StringBackSpace } },
+      { "String.doubleQuote", { 0, StringDoubleQuote } },
+      { "Sys.wait", { 1, SysWait } },
+  }
+{
+}
+
+std::size_t
+Intrinsics::Install(Computer& computer, const std::map<std::string, std::size_t>& labels)
+{
+    for (auto&& [name, entry] : _known) {
+        const auto it = labels.find(name);
+        if (it == labels.end()) {
+            continue;
+        }
+
+        const auto addr = static_cast<std::uint16_t>(it->second);
+        _installed[addr] = &entry;
+        computer.SetTrap(addr, true);
+    }
+
+    computer.SetTrapHandler(
+      [this](Computer& c, std::uint16_t addr) { return this->OnTrap(c, addr); });
+
+    return _installed.size();
+}
+
+std::optional<std::uint16_t>
+Intrinsics::Call(const std::string& name, Computer& computer, const std::uint16_t* args,
+                 std::size_t n_args) const
+{
+    const auto it = _known.find(name);
+    if (it == _known.end() || it->second.n_args != n_args) {
+        return std::nullopt;
+    }
+    return it->second.fn(computer, args);
+}
+
+bool
+Intrinsics::OnTrap(Computer& computer, std::uint16_t addr)
+{
+    const auto it = _installed.find(addr);
+    if (it == _installed.end()) {
+        return false;
+    }
+
+    const Entry& entry = *it->second;
+    const auto frame   = EnteredFrame(computer, entry.n_args);
+    if (!frame) {
+        return false;
+    }
+
+    const std::uint16_t arg = computer.Read(ARG);
+
+    std::array<std::uint16_t, MAX_ARGS> args{};
+    for (std::size_t i = 0; i < entry.n_args && i < MAX_ARGS; i++) {
+        args[i] = computer.Read(arg + i);
+    }
+
+    const auto value = entry.fn(computer, args.data());
+    if (!value) {
+        return false;
+    }
+
+    ReturnFromFunction(computer, *value, *frame);
+    _calls++;
+    return true;
+}
+
+} // namespace Emu
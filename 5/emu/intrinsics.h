@@ -0,0 +1,86 @@
+#ifndef EMU_INTRINSICS_HH
+#define EMU_INTRINSICS_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "computer.h"
+
+namespace Emu {
+
+// Native replacements for Jack OS functions.
+//
+// A function label emitted by the VM translator (`(Math.multiply)`) is trapped.
+// When a `call` jumps there, the native version reads its arguments from ARG,
+// writes the return value and unwinds the frame exactly like `return` does, so
+// the caller continues at its return address. The frame may be the full one or
+// one reduced by the translator's calling conventions.
+//
+// Only functions that are pure over RAM are replaced. String's constructor and
+// appendChar/setInt allocate through Memory.alloc, and its methods read fields
+// whose layout is the Jack code's own; Screen's drawing routines depend on the
+// color kept in a static variable, which has no label to find it by. Those run
+// as Hack code; of String only the character constants are native.
+class Intrinsics
+{
+  public:
+    // Returns the value to push, or nullopt to fall back to the Hack code
+    // (e.g. Math.divide by zero, so that Sys.error still runs).
+    using Function = std::function<std::optional<std::uint16_t>(Computer&, const std::uint16_t* args)>;
+
+    Intrinsics();
+
+    // Traps every known function found in `labels` (label -> ROM address).
+    // Returns the number of installed intrinsics.
+    std::size_t Install(Computer& computer, const std::map<std::string, std::size_t>& labels);
+
+    // Runs `name` directly, for a VM-level caller that manages its own frames.
+    // nullopt when the function is unknown, takes a different number of
+    // arguments or gives up.
+    std::optional<std::uint16_t> Call(const std::string& name, Computer& computer,
+                                      const std::uint16_t* args, std::size_t n_args) const;
+
+    std::uint64_t Calls() const { return _calls; }
+
+  private:
+    struct Entry
+    {
+        std::size_t n_args;
+        Function fn;
+    };
+
+    bool OnTrap(Computer& computer, std::uint16_t addr);
+
+    std::map<std::string, Entry> _known;
+    std::unordered_map<std::uint16_t, const Entry*> _installed;
+    std::uint64_t _calls{ 0 };
+};
+
+// What a `call` saved below the arguments of a function: the full frame
+// retAddr LCL ARG THIS THAT, or retAddr [LCL] ARG [THIS THAT] as the VM
+// translator reduces it (Vm::Frame)
+struct CallFrame
+{
+    std::uint16_t n_args;
+    std::uint16_t size;
+    bool lcl;
+    bool this_that;
+};
+
+// The frame of the function a `call` has just entered, told by its size
+// SP - ARG - n_args; nullopt when no calling convention has that size
+std::optional<CallFrame>
+EnteredFrame(const Computer& computer, std::size_t n_args);
+
+// Pops `frame` like the VM `return` command
+void
+ReturnFromFunction(Computer& computer, std::uint16_t value, const CallFrame& frame);
+
+} // namespace Emu
+
+#endif
@@ -0,0 +1,45 @@
+#include "loader.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "../../6/asm/assembler.h"
+
+namespace Emu {
+
+bool
+LoadProgram(Computer& computer, const std::string& path, Labels& labels)
+{
+    if (std::filesystem::path(path).extension() != ".asm") {
+        return computer.LoadRom(path);
+    }
+
+    Asm::Program program;
+    if (!Asm::Assemble(path, program)) {
+        return false;
+    }
+
+    computer.LoadRom(program.words);
+    labels.insert(program.labels.begin(), program.labels.end());
+    return true;
+}
+
+bool
+ReadSymbols(const std::string& path, Labels& labels)
+{
+    std::ifstream in{ path };
+    if (!in) {
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return false;
+    }
+
+    std::string label;
+    std::size_t addr;
+    while (in >> label >> addr) {
+        labels[label] = addr;
+    }
+    return in.eof();
+}
+
+} // namespace Emu
@@ -0,0 +1,25 @@
+#ifndef EMU_LOADER_HH
+#define EMU_LOADER_HH
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+#include "computer.h"
+
+namespace Emu {
+
+using Labels = std::map<std::string, std::size_t>;
+
+// Loads a .hack image, or assembles an .asm file in-process.
+// Labels are only known for .asm input.
+bool
+LoadProgram(Computer& computer, const std::string& path, Labels& labels);
+
+// "label address" per line, as written by `hackasm <in> <out> <sym>`
+bool
+ReadSymbols(const std::string& path, Labels& labels);
+
+} // namespace Emu
+
+#endif
@@ -0,0 +1,71 @@
+#include "profile.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace Emu {
+
+bool
+IsFunctionLabel(const std::string& label)
+{
+    return label.find('.') != std::string::npos && label.find('$') == std::string::npos;
+}
+
+void
+WriteProfile(const Computer& computer, const Labels& labels, std::ostream& out)
+{
+    const std::vector<std::uint64_t>& counts = computer.Counts();
+    auto count = [&counts](std::size_t addr) { return addr < counts.size() ? counts[addr] : 0; };
+
+    // functions by address: each runs up to the next
+    std::vector<std::pair<std::size_t, const std::string*>> functions;
+    for (const auto& [name, addr] : labels) {
+        if (IsFunctionLabel(name)) {
+            functions.emplace_back(addr, &name);
+        }
+    }
+    std::ranges::sort(functions);
+
+    out << "hackprof " << PROFILE_VERSION << "\n";
+    out << "cycles " << std::accumulate(counts.begin(), counts.end(), std::uint64_t{ 0 }) << "\n";
+
+    // by name, as `labels` is
+    std::vector<std::pair<const std::string*, std::uint64_t>> cycles;
+    for (std::size_t f = 0; f < functions.size(); f++) {
+        const std::size_t begin = std::min(functions[f].first, counts.size());
+        const std::size_t end   = f + 1 < functions.size() ? std::min(functions[f + 1].first, counts.size()) : counts.size();
+        cycles.emplace_back(functions[f].second, std::accumulate(counts.begin() + static_cast<std::ptrdiff_t>(begin),
+                                                                 counts.begin() + static_cast<std::ptrdiff_t>(end),
+                                                                 std::uint64_t{ 0 }));
+    }
+    std::ranges::sort(cycles, [](const auto& l, const auto& r) { return *l.first < *r.first; });
+    for (const auto& [name, n] : cycles) {
+        out << "function " << *name << " " << count(labels.at(*name)) << " " << n << "\n";
+    }
+
+    for (const auto& [name, addr] : labels) {
+        if (!IsFunctionLabel(name)) {
+            out << "label " << name << " " << count(addr) << "\n";
+        }
+    }
+}
+
+bool
+SaveProfile(const Computer& computer, const Labels& labels, const std::string& path)
+{
+    std::ofstream out{ path };
+    if (!out) {
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return false;
+    }
+    WriteProfile(computer, labels, out);
+    return static_cast<bool>(out);
+}
+
+} // namespace Emu
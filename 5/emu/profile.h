@@ -0,0 +1,41 @@
+#ifndef EMU_PROFILE_HH
+#define EMU_PROFILE_HH
+
+#include <ostream>
+#include <string>
+
+#include "computer.h"
+#include "loader.h"
+
+namespace Emu {
+
+// Execution counts of a run by label, for `vm --profile`. Text, one record
+// per line, sorted by name so that profiles of two runs diff well:
+//
+//   hackprof 1
+//   cycles <counted>
+//   function <name> <entries> <cycles>
+//   label <name> <count>
+//
+// A function is a label with a '.' and no '$', as the VM translator names
+// them. Its entries count every arrival at its label, and its cycles are
+// those of the instructions from its label up to the next function's. A
+// label's count is how often execution reached it: the count of the label
+// an if-goto jumps to, against that of the if-goto's own block, gives the
+// odds of the branch. Labels that never ran are listed with 0.
+constexpr int PROFILE_VERSION = 1;
+
+// `computer` must have profiling on; `labels` are those of its program
+void
+WriteProfile(const Computer& computer, const Labels& labels, std::ostream& out);
+
+bool
+SaveProfile(const Computer& computer, const Labels& labels, const std::string& path);
+
+// A label the VM translator writes for a function
+bool
+IsFunctionLabel(const std::string& label);
+
+} // namespace Emu
+
+#endif
@@ -0,0 +1,283 @@
+#include "recompile.h"
+
+#include <map>
+#include <string>
+
+namespace Emu {
+
+// instruction bits, as in computer.cpp
+static constexpr std::uint16_t C_INST = 0x8000;
+static constexpr std::uint16_t DEST_A = 0x0020;
+static constexpr std::uint16_t DEST_D = 0x0010;
+static constexpr std::uint16_t DEST_M = 0x0008;
+static constexpr std::uint16_t JUMP   = 0x0007;
+
+static bool
+IsJump(std::uint16_t inst)
+{
+    return (inst & C_INST) && (inst & JUMP);
+}
+
+// The jump at `p` goes where the A-instruction before it says, unless a
+// jump lands on it with some other A
+static bool
+IsDirect(std::span<const std::uint16_t> rom, const std::vector<bool>& starts, std::size_t p)
+{
+    return p > 0 && !(rom[p - 1] & C_INST) && !starts[p];
+}
+
+static std::vector<bool>
+Starts(std::span<const std::uint16_t> rom, const Labels& labels)
+{
+    const std::size_t n = rom.size();
+    std::vector<bool> starts(n + 1, false);
+    starts[0] = true;
+    starts[n] = true;
+    for (const auto& [name, addr] : labels) {
+        if (addr < n) {
+            starts[addr] = true;
+        }
+    }
+    // a new start can make a direct jump indirect, which adds no target
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (std::size_t p = 0; p < n; p++) {
+            if (!IsJump(rom[p])) {
+                continue;
+            }
+            starts[p + 1] = true;
+            if (IsDirect(rom, starts, p) && rom[p - 1] < n && !starts[rom[p - 1]]) {
+                starts[rom[p - 1]] = true;
+                changed            = true;
+            }
+        }
+    }
+    return starts;
+}
+
+std::vector<std::uint16_t>
+BlockStarts(std::span<const std::uint16_t> rom, const Labels& labels)
+{
+    const std::vector<bool> starts = Starts(rom, labels);
+    std::vector<std::uint16_t> out;
+    for (std::size_t p = 0; p < rom.size(); p++) {
+        if (starts[p]) {
+            out.push_back(static_cast<std::uint16_t>(p));
+        }
+    }
+    return out;
+}
+
+// The value of `comp`, "a c1..c6", as a C++ expression of d, a and m
+static std::string
+Comp(std::uint16_t comp)
+{
+    const std::string x = "d";
+    const std::string y = comp & 0x40 ? "m" : "a";
+    switch (comp & 0x3F) {
+        case 0b101010: return "0";
+        case 0b111111: return "1";
+        case 0b111010: return "0xFFFF";
+        case 0b001100: return x;
+        case 0b110000: return y;
+        case 0b001101: return "~" + x;
+        case 0b110001: return "~" + y;
+        case 0b001111: return "-" + x;
+        case 0b110011: return "-" + y;
+        case 0b011111: return x + " + 1";
+        case 0b110111: return y + " + 1";
+        case 0b001110: return x + " - 1";
+        case 0b110010: return y + " - 1";
+        case 0b000010: return x + " + " + y;
+        case 0b010011: return x + " - " + y;
+        case 0b000111: return y + " - " + x;
+        case 0b000000: return x + " & " + y;
+        case 0b010101: return x + " | " + y;
+        default: return "Alu(" + std::to_string(comp) + ", d, a, m)";
+    }
+}
+
+// The test of the jump bits on out
+static std::string
+Condition(std::uint16_t jump)
+{
+    static const char* const TESTS[] = { "", "> 0", "== 0", ">= 0", "< 0", "!= 0", "<= 0", "" };
+    return std::string{ "static_cast<std::int16_t>(out) " } + TESTS[jump];
+}
+
+static constexpr const char* PROLOGUE = R"cpp(#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static std::uint16_t ram[32768];
+
+// for the comp fields that have no mnemonic
+[[maybe_unused]] static std::uint16_t
+Alu(std::uint16_t comp, std::uint16_t d, std::uint16_t a, std::uint16_t m)
+{
+    std::uint16_t x = d;
+    std::uint16_t y = (comp & 0x40) ? m : a;
+    if (comp & 0x20) x = 0;
+    if (comp & 0x10) x = ~x;
+    if (comp & 0x08) y = 0;
+    if (comp & 0x04) y = ~y;
+    std::uint16_t out = (comp & 0x02) ? static_cast<std::uint16_t>(x + y) : (x & y);
+    if (comp & 0x01) out = ~out;
+    return out;
+}
+
+struct State
+{
+    std::uint16_t a, d, pc;
+    std::uint64_t cycles;
+    bool halted; // as Computer::Halted()
+    bool lost;   // jumped to an address that starts no block
+};
+
+static State
+Run(std::uint64_t limit)
+{
+    std::uint16_t a = 0, d = 0, pc = 0;
+    std::uint64_t cycles = 0;
+    bool halted = false, lost = false;
+)cpp";
+
+static constexpr const char* EPILOGUE = R"cpp(
+int
+main(int argc, char* argv[])
+{
+    std::uint64_t limit = 10000000;
+    long from = 0, to = -1;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--cycles") == 0 && i + 1 < argc) {
+            limit = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--ram") == 0 && i + 2 < argc) {
+            from = std::strtol(argv[++i], nullptr, 10);
+            to   = std::strtol(argv[++i], nullptr, 10);
+        } else {
+            std::printf("Usage: %s [--cycles N] [--ram FROM TO]\n", argv[0]);
+            return -1;
+        }
+    }
+
+    const State s = Run(limit);
+    if (s.lost) {
+        std::fprintf(stderr, "jump to %u, which starts no block\n", s.pc);
+    }
+    std::printf("cycles: %llu%s\n", static_cast<unsigned long long>(s.cycles), s.halted ? " (halted)" : "");
+    std::printf("PC: %u A: %u D: %u\n", s.pc, s.a, s.d);
+    for (long i = from; i <= to && i < 32768; i++) {
+        std::printf("RAM[%ld]: %u\n", i, ram[i]);
+    }
+    return s.lost ? 1 : 0;
+}
+)cpp";
+
+Recompiled
+Recompile(std::span<const std::uint16_t> rom, const Labels& labels, std::ostream& out)
+{
+    const std::size_t n            = rom.size();
+    const std::vector<bool> starts = Starts(rom, labels);
+    std::map<std::size_t, std::vector<const std::string*>> names;
+    for (const auto& [name, addr] : labels) {
+        names[addr].push_back(&name);
+    }
+
+    Recompiled stats;
+    out << "// Generated by hackrc: the Hack program as C++, see 5/emu/recompile.h\n" << PROLOGUE;
+    for (std::size_t p = 0; p < n; p++) {
+        if (starts[p]) {
+            std::size_t end = p + 1;
+            while (!starts[end]) {
+                end++;
+            }
+            out << "L_" << p << ":";
+            const char* sep = " //";
+            for (const std::string* name : names[p]) {
+                out << sep << " " << *name;
+                sep = ",";
+            }
+            out << "\n    if (cycles + " << end - p << " > limit) { pc = " << p << "; goto stop; }\n";
+            out << "    cycles += " << end - p << ";\n";
+            stats.blocks++;
+        }
+
+        const std::uint16_t inst = rom[p];
+        if (!(inst & C_INST)) {
+            out << "    a = " << inst << ";\n";
+            continue;
+        }
+        const std::uint16_t jump = inst & JUMP;
+        const bool pure          = !(inst & (DEST_A | DEST_D | DEST_M));
+        if (pure && !jump) {
+            continue;
+        }
+
+        const std::string value = Comp((inst >> 6) & 0x7F);
+        out << "    {\n";
+        // 0;JMP needs no value
+        if (!pure || jump != JUMP) {
+            if (value.find('m') != std::string::npos) {
+                out << "        const std::uint16_t m = ram[a & 0x7FFF];\n";
+            }
+            out << "        const std::uint16_t out = static_cast<std::uint16_t>(" << value << ");\n";
+        }
+        const bool direct = jump && IsDirect(rom, starts, p);
+        if (jump && !direct) {
+            out << "        const std::uint16_t target = a & 0x7FFF;\n";
+        }
+        if (inst & DEST_M) {
+            out << "        ram[a & 0x7FFF] = out;\n";
+        }
+        if (inst & DEST_D) {
+            out << "        d = out;\n";
+        }
+        if (inst & DEST_A) {
+            out << "        a = out;\n";
+        }
+
+        if (jump) {
+            out << "        ";
+            if (jump != JUMP) {
+                out << "if (" << Condition(jump) << ") ";
+            }
+            // a jump to itself, or to the @ of itself, without side effects
+            const bool to_at = p > 0 && rom[p - 1] == p - 1;
+            if (direct) {
+                const std::size_t target = rom[p - 1];
+                if (pure && (target == p || (target + 1 == p && to_at))) {
+                    out << "{ pc = " << target << "; halted = true; goto stop; }\n";
+                } else if (target < n) {
+                    out << "goto L_" << target << ";\n";
+                } else {
+                    out << "{ pc = " << target << "; goto dispatch; }\n";
+                }
+                stats.direct++;
+            } else {
+                out << "{\n            pc = target;\n";
+                if (pure) {
+                    out << "            if (pc == " << p << (to_at ? " || pc + 1 == " + std::to_string(p) : "")
+                        << ") { halted = true; goto stop; }\n";
+                }
+                out << "            goto dispatch;\n        }\n";
+                stats.indirect++;
+            }
+        }
+        out << "    }\n";
+    }
+
+    // off the end of the program
+    out << "    pc = " << n << ";\n";
+    out << "dispatch:\n    switch (pc) {\n";
+    for (std::size_t p = 0; p < n; p++) {
+        if (starts[p]) {
+            out << "        case " << p << ": goto L_" << p << ";\n";
+        }
+    }
+    out << "        default: break;\n    }\n    lost = true;\n";
+    out << "stop:\n    return State{ a, d, pc, cycles, halted, lost };\n}\n" << EPILOGUE;
+    return stats;
+}
+
+} // namespace Emu
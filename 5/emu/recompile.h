@@ -0,0 +1,47 @@
+#ifndef EMU_RECOMPILE_HH
+#define EMU_RECOMPILE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <vector>
+
+#include "loader.h"
+
+namespace Emu {
+
+// Static recompilation of a Hack program into one C++ translation unit,
+// for the host compiler to build into a standalone executable.
+//
+// Each basic block becomes a labelled region of a single function, with the
+// Hack registers in locals. A jump whose target the A-instruction right
+// before it names becomes a goto; any other jump (a return through R14, or
+// a comparison routine's return through R13) goes through a switch over the
+// block starts. Blocks start at address 0, at every label and at every
+// direct target, so with the labels of the program every return address is
+// a case. A jump to an address that starts no block stops the run.
+//
+// The executable runs from a cleared machine until the program halts as
+// Computer::Halted() has it, or until the next block would take it past its
+// cycle budget; it then prints what hackemu prints, and the RAM words asked
+// for:
+//
+//   prog [--cycles N] [--ram FROM TO]
+struct Recompiled
+{
+    std::size_t blocks{ 0 };
+    std::size_t direct{ 0 };   // jumps written as goto
+    std::size_t indirect{ 0 }; // jumps through the switch
+};
+
+// Addresses the basic blocks of `rom` start at, in order
+std::vector<std::uint16_t>
+BlockStarts(std::span<const std::uint16_t> rom, const Labels& labels);
+
+Recompiled
+Recompile(std::span<const std::uint16_t> rom, const Labels& labels, std::ostream& out);
+
+} // namespace Emu
+
+#endif
@@ -0,0 +1,258 @@
+#include "script.h"
+
+#include <sstream>
+
+namespace Emu {
+
+static std::vector<std::string>
+Tokenize(const std::string& text)
+{
+    std::vector<std::string> tokens;
+    std::string word;
+    const auto flush = [&] {
+        if (!word.empty()) {
+            tokens.push_back(word);
+            word.clear();
+        }
+    };
+
+    for (std::size_t i = 0; i < text.size(); i++) {
+        const char c = text[i];
+        if (c == '/' && i + 1 < text.size() && text[i + 1] == '/') {
+            flush();
+            i = text.find('\n', i);
+            if (i == std::string::npos) {
+                break;
+            }
+        } else if (c == '/' && i + 1 < text.size() && text[i + 1] == '*') {
+            flush();
+            i = text.find("*/", i + 2);
+            if (i == std::string::npos) {
+                break;
+            }
+            i++;
+        } else if (c == '"') {
+            const auto end = text.find('"', i + 1);
+            word += text.substr(i, end == std::string::npos ? end : end - i + 1);
+            if (end == std::string::npos) {
+                break;
+            }
+            i = end;
+        } else if (c == ',' || c == ';' || c == '{' || c == '}') {
+            flush();
+            tokens.emplace_back(1, c);
+        } else if (std::isspace(static_cast<unsigned char>(c))) {
+            flush();
+        } else {
+            word += c;
+        }
+    }
+    flush();
+    return tokens;
+}
+
+// Parses commands up to the matching `}` (or the end of the script)
+static bool
+Parse(const std::vector<std::string>& tokens, std::size_t& pos, std::vector<ScriptCommand>& out,
+      std::string& error)
+{
+    ScriptCommand cmd;
+    while (pos < tokens.size()) {
+        const std::string& t = tokens[pos++];
+
+        if (t == "," || t == ";") {
+            if (!cmd.words.empty()) {
+                out.push_back(std::move(cmd));
+                cmd = {};
+            }
+        } else if (t == "}") {
+            if (!cmd.words.empty()) {
+                out.push_back(std::move(cmd));
+            }
+            return true;
+        } else if (t == "repeat" && cmd.words.empty()) {
+            if (pos < tokens.size() && tokens[pos] == "{") {
+                error = "repeat without a count (interactive script)";
+                return false;
+            }
+            if (pos + 1 >= tokens.size() || tokens[pos + 1] != "{" ||
+                tokens[pos].find_first_not_of("0123456789") != std::string::npos) {
+                error = "invalid repeat";
+                return false;
+            }
+            cmd.repeat = std::stoull(tokens[pos]);
+            cmd.words  = { "repeat" };
+            pos += 2;
+            if (!Parse(tokens, pos, cmd.body, error)) {
+                return false;
+            }
+            out.push_back(std::move(cmd));
+            cmd = {};
+        } else if (t == "{") {
+            error = "unsupported block before '{'";
+            return false;
+        } else {
+            cmd.words.push_back(t);
+        }
+    }
+
+    if (!cmd.words.empty()) {
+        out.push_back(std::move(cmd));
+    }
+    return true;
+}
+
+bool
+ParseScript(const std::string& text, std::vector<ScriptCommand>& commands, std::string& error)
+{
+    std::size_t pos = 0;
+    return Parse(Tokenize(text), pos, commands, error);
+}
+
+bool
+ParseValue(const std::string& s, std::uint16_t& v)
+{
+    int base          = 10;
+    std::size_t start = 0;
+    if (s.size() > 2 && s[0] == '%') {
+        base  = s[1] == 'X' ? 16 : s[1] == 'B' ? 2 : 10;
+        start = 2;
+    }
+
+    std::size_t used = 0;
+    try {
+        v = static_cast<std::uint16_t>(std::stol(s.substr(start), &used, base));
+    } catch (const std::exception&) {
+        return false;
+    }
+    return start + used == s.size();
+}
+
+bool
+ParseColumn(const std::string& s, Column& col)
+{
+    const auto pct = s.find('%');
+    col.name       = s.substr(0, pct);
+    if (pct == std::string::npos) {
+        return true;
+    }
+
+    char dot1 = 0, dot2 = 0;
+    std::istringstream in{ s.substr(pct + 1) };
+    in >> col.format >> col.left >> dot1 >> col.width >> dot2 >> col.right;
+    return in && dot1 == '.' && dot2 == '.' &&
+           (col.format == 'D' || col.format == 'X' || col.format == 'B' || col.format == 'S');
+}
+
+std::string
+FormatValue(const Column& col, std::uint16_t v, std::size_t width)
+{
+    std::string s;
+    if (col.format == 'X' || col.format == 'B') {
+        const int bits  = col.format == 'X' ? 4 : 1;
+        const int count = 16 / bits;
+        for (int i = count - 1; i >= 0; i--) {
+            s += "0123456789ABCDEF"[(v >> (i * bits)) & ((1 << bits) - 1)];
+        }
+        if (s.size() > col.width) {
+            s.erase(0, s.size() - col.width);
+        }
+    } else if (width == 16) {
+        s = std::to_string(static_cast<std::int16_t>(v));
+    } else {
+        s = std::to_string(v);
+    }
+
+    if (s.size() < col.width) {
+        s.insert(0, col.width - s.size(), ' ');
+    }
+    return std::string(col.left, ' ') + s + std::string(col.right, ' ');
+}
+
+std::string
+FormatString(const Column& col, const std::string& s)
+{
+    std::string t = s.substr(0, col.width);
+    t.append(col.width - t.size(), ' ');
+    return std::string(col.left, ' ') + t + std::string(col.right, ' ');
+}
+
+std::string
+FormatHeader(const Column& col)
+{
+    const std::size_t w    = col.left + col.width + col.right;
+    const std::string name = col.name.substr(0, w);
+    const std::size_t pad  = w - name.size();
+    return std::string(pad / 2, ' ') + name + std::string(pad - pad / 2, ' ');
+}
+
+static std::string
+TrimRight(std::string s)
+{
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) {
+        s.pop_back();
+    }
+    return s;
+}
+
+static bool
+Matches(const std::string& expected, const std::string& actual)
+{
+    if (expected.size() != actual.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < expected.size(); i++) {
+        if (expected[i] != '*' && expected[i] != actual[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+CompareFile::Open(const std::string& path)
+{
+    _in.open(path);
+    _open = static_cast<bool>(_in);
+    _line = 0;
+    return _open;
+}
+
+bool
+CompareFile::Check(const std::string& line, std::string& error)
+{
+    if (!_open) {
+        return true;
+    }
+
+    std::string expected;
+    if (!std::getline(_in, expected)) {
+        error = "more output than compare lines: " + line;
+        return false;
+    }
+    _line++;
+
+    expected = TrimRight(expected);
+    const std::string actual = TrimRight(line);
+    if (!Matches(expected, actual)) {
+        error = "comparison failure at line " + std::to_string(_line) + ": expected '" + expected +
+                "', got '" + actual + "'";
+        return false;
+    }
+    return true;
+}
+
+bool
+CompareFile::Finish(std::string& error)
+{
+    std::string rest;
+    while (_open && std::getline(_in, rest)) {
+        if (!TrimRight(rest).empty()) {
+            error = "missing output for compare line " + std::to_string(_line + 1);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace Emu
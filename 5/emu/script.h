@@ -0,0 +1,75 @@
+#ifndef EMU_SCRIPT_HH
+#define EMU_SCRIPT_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Emu {
+
+// Common syntax of the course's .tst scripts (hardware, CPU and VM emulators)
+
+// A simple command (`set RAM[0] 256`) or a `repeat N { ... }` block
+struct ScriptCommand
+{
+    std::vector<std::string> words;
+    std::uint64_t repeat{ 0 };
+    std::vector<ScriptCommand> body{};
+};
+
+// output-list entry: name%Fl.w.r
+struct Column
+{
+    std::string name;
+    char format{ 'B' };
+    std::size_t left{ 1 };
+    std::size_t width{ 16 };
+    std::size_t right{ 1 };
+};
+
+// Splits commands on ',' and ';'. Comments and "quoted strings" are handled.
+bool
+ParseScript(const std::string& text, std::vector<ScriptCommand>& commands, std::string& error);
+
+// 123, -5, %D-5, %XFF, %B0101
+bool
+ParseValue(const std::string& s, std::uint16_t& v);
+
+bool
+ParseColumn(const std::string& s, Column& col);
+
+// `width` is the number of meaningful bits (D prints 16 bit values signed)
+std::string
+FormatValue(const Column& col, std::uint16_t v, std::size_t width = 16);
+std::string
+FormatString(const Column& col, const std::string& s);
+std::string
+FormatHeader(const Column& col);
+
+// Streams output lines against a compare file. `*` in the compare file
+// matches any character, as in the course's .cmp files.
+class CompareFile
+{
+  public:
+    bool Open(const std::string& path);
+    bool IsOpen() const { return _open; }
+
+    // Compares with the next line. On failure `error` tells where.
+    bool Check(const std::string& line, std::string& error);
+
+    // Fails when compare lines are left over
+    bool Finish(std::string& error);
+
+    std::size_t Compared() const { return _line; }
+
+  private:
+    std::ifstream _in;
+    bool _open{ false };
+    std::size_t _line{ 0 };
+};
+
+} // namespace Emu
+
+#endif
@@ -0,0 +1,219 @@
+#include "snapshot.h"
+
+#include <bit>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace Emu {
+
+static constexpr char MAGIC[8]            = { 'H', 'A', 'C', 'K', 'S', 'N', 'A', 'P' };
+static constexpr std::size_t HEADER_SIZE = 8 + 2 * 6 + 8 + 8;
+
+static void
+PutU16(std::vector<std::uint8_t>& buf, std::uint16_t v)
+{
+    buf.push_back(v & 0xFF);
+    buf.push_back(v >> 8);
+}
+
+static void
+PutU64(std::vector<std::uint8_t>& buf, std::uint64_t v)
+{
+    for (int i = 0; i < 8; i++) {
+        buf.push_back((v >> (i * 8)) & 0xFF);
+    }
+}
+
+static std::uint16_t
+GetU16(const std::uint8_t* p)
+{
+    return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+}
+
+static std::uint64_t
+GetU64(const std::uint8_t* p)
+{
+    std::uint64_t v = 0;
+    for (int i = 7; i >= 0; i--) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+std::uint64_t
+RomChecksum(const Computer& computer)
+{
+    constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    constexpr std::uint64_t FNV_PRIME  = 1099511628211ULL;
+
+    std::uint64_t h = FNV_OFFSET;
+    for (std::size_t i = 0; i < Computer::ROM_SIZE; i++) {
+        h = (h ^ computer.Rom()[i]) * FNV_PRIME;
+    }
+    return h;
+}
+
+// (zero run, literal count, literals...) records
+static void
+Compress(const std::uint16_t* ram, std::vector<std::uint8_t>& buf)
+{
+    constexpr std::size_t MAX_RUN = 0xFFFF;
+
+    std::size_t i = 0;
+    while (i < Computer::RAM_SIZE) {
+        std::size_t zeros = 0;
+        while (i + zeros < Computer::RAM_SIZE && ram[i + zeros] == 0 && zeros < MAX_RUN) {
+            zeros++;
+        }
+        i += zeros;
+
+        // literals end at a pair of zeros (a single zero is cheaper as a literal)
+        std::size_t lits = 0;
+        while (i + lits < Computer::RAM_SIZE && lits < MAX_RUN) {
+            const bool pair = ram[i + lits] == 0 &&
+                              (i + lits + 1 == Computer::RAM_SIZE || ram[i + lits + 1] == 0);
+            if (pair) {
+                break;
+            }
+            lits++;
+        }
+
+        PutU16(buf, static_cast<std::uint16_t>(zeros));
+        PutU16(buf, static_cast<std::uint16_t>(lits));
+        for (std::size_t k = 0; k < lits; k++) {
+            PutU16(buf, ram[i + k]);
+        }
+        i += lits;
+    }
+}
+
+static bool
+Decompress(const std::uint8_t* p, std::size_t size, std::uint16_t* ram)
+{
+    std::size_t i = 0;
+    const std::uint8_t* end = p + size;
+    while (p + 4 <= end) {
+        const std::size_t zeros = GetU16(p);
+        const std::size_t lits  = GetU16(p + 2);
+        p += 4;
+
+        if (i + zeros + lits > Computer::RAM_SIZE || p + lits * 2 > end) {
+            return false;
+        }
+
+        std::fill(ram + i, ram + i + zeros, 0);
+        i += zeros;
+        for (std::size_t k = 0; k < lits; k++, p += 2) {
+            ram[i++] = GetU16(p);
+        }
+    }
+
+    return i == Computer::RAM_SIZE && p == end;
+}
+
+bool
+SaveSnapshot(const Computer& computer, const std::string& path, bool compress)
+{
+    std::vector<std::uint8_t> buf;
+    buf.reserve(HEADER_SIZE + Computer::RAM_SIZE * 2);
+
+    buf.insert(buf.end(), std::begin(MAGIC), std::end(MAGIC));
+    PutU16(buf, SNAPSHOT_VERSION);
+    PutU16(buf, compress ? SNAPSHOT_COMPRESSED : 0);
+    PutU16(buf, computer.PC());
+    PutU16(buf, computer.A());
+    PutU16(buf, computer.D());
+    PutU16(buf, 0);
+    PutU64(buf, computer.Cycles());
+    PutU64(buf, RomChecksum(computer));
+
+    if (compress) {
+        Compress(computer.Ram(), buf);
+    } else {
+        for (std::size_t i = 0; i < Computer::RAM_SIZE; i++) {
+            PutU16(buf, computer.Ram()[i]);
+        }
+    }
+
+    std::ofstream out{ path, std::ios::out | std::ios::binary | std::ios::trunc };
+    if (!out) {
+        std::cerr << "Failed to open the file(" << path << ")\n";
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(buf.data()), buf.size());
+    return static_cast<bool>(out);
+}
+
+bool
+LoadSnapshot(Computer& computer, const std::string& path)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return false;
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < HEADER_SIZE) {
+        std::cerr << "Invalid snapshot: " << path << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    const std::size_t size = st.st_size;
+    void* map              = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        std::cerr << "Failed to map file: " << path << std::endl;
+        return false;
+    }
+
+    const auto* p = static_cast<const std::uint8_t*>(map);
+
+    std::vector<std::uint16_t> ram(Computer::RAM_SIZE);
+    const std::uint8_t* payload = p + HEADER_SIZE;
+    const std::size_t n         = size - HEADER_SIZE;
+    const std::uint16_t flags   = GetU16(p + 10);
+
+    bool ok = std::memcmp(p, MAGIC, sizeof(MAGIC)) == 0 && GetU16(p + 8) == SNAPSHOT_VERSION;
+    if (ok && GetU64(p + 28) != RomChecksum(computer)) {
+        std::cerr << "Snapshot was taken with a different ROM: " << path << std::endl;
+        ::munmap(map, size);
+        return false;
+    }
+
+    if (ok && (flags & SNAPSHOT_COMPRESSED)) {
+        ok = Decompress(payload, n, ram.data());
+    } else if (ok && n == Computer::RAM_SIZE * 2) {
+        if (std::endian::native == std::endian::little) {
+            std::memcpy(ram.data(), payload, n);
+        } else {
+            for (std::size_t i = 0; i < Computer::RAM_SIZE; i++) {
+                ram[i] = GetU16(payload + i * 2);
+            }
+        }
+    } else {
+        ok = false;
+    }
+
+    if (ok) {
+        computer.LoadRam(ram.data());
+        computer.SetPC(GetU16(p + 12));
+        computer.SetA(GetU16(p + 14));
+        computer.SetD(GetU16(p + 16));
+        computer.SetCycles(GetU64(p + 20));
+    } else {
+        std::cerr << "Invalid snapshot: " << path << std::endl;
+    }
+
+    ::munmap(map, size);
+    return ok;
+}
+
+} // namespace Emu
@@ -0,0 +1,36 @@
+#ifndef EMU_SNAPSHOT_HH
+#define EMU_SNAPSHOT_HH
+
+#include <cstdint>
+#include <string>
+
+#include "computer.h"
+
+namespace Emu {
+
+// Machine state file (RAM, PC, A, D, cycle count)
+//
+// | magic "HACKSNAP" | version u16 | flags u16 | pc u16 | a u16 | d u16 | pad u16 |
+// | cycles u64 | rom checksum u64 | payload ...                               |
+//
+// All values are little-endian. The payload is the raw 32K words of RAM, or
+// with SNAPSHOT_COMPRESSED a list of (zero run u16, literal count u16, literals...)
+// records. ROM is not stored: the checksum makes sure the snapshot is restored
+// on top of the same program.
+constexpr std::uint16_t SNAPSHOT_VERSION    = 1;
+constexpr std::uint16_t SNAPSHOT_COMPRESSED = 0x0001;
+
+bool
+SaveSnapshot(const Computer& computer, const std::string& path, bool compress);
+
+// Maps the file and copies the state into `computer`.
+// Fails when the file is broken or was taken with a different ROM.
+bool
+LoadSnapshot(Computer& computer, const std::string& path);
+
+std::uint64_t
+RomChecksum(const Computer& computer);
+
+} // namespace Emu
+
+#endif
@@ -0,0 +1,148 @@
+// Tests for Emu::ThreadPool and the batch runner
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "../batch.h"
+#include "../thread_pool.h"
+
+TEST(ThreadPool, RunsEveryTask)
+{
+    std::atomic<int> sum{ 0 };
+    {
+        Emu::ThreadPool pool{ 4 };
+        for (int i = 1; i <= 1000; i++) {
+            pool.Submit([&sum, i] { sum += i; });
+        }
+        pool.Wait();
+        EXPECT_EQ(sum, 500500);
+
+        // reusable after Wait
+        pool.Submit([&sum] { sum = 0; });
+        pool.Wait();
+        EXPECT_EQ(sum, 0);
+    }
+}
+
+TEST(ThreadPool, StealsFromBusyWorkers)
+{
+    Emu::ThreadPool pool{ 2 };
+
+    // every other task lands on the same worker; the long one blocks it
+    std::atomic<int> done{ 0 };
+    pool.Submit([&done] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        done++;
+    });
+    for (int i = 0; i < 21; i++) {
+        pool.Submit([&done] { done++; });
+    }
+    pool.Wait();
+
+    EXPECT_EQ(done, 22);
+    EXPECT_GT(pool.Steals(), 0u);
+}
+
+// Test fixture for batch tests. Creates a temporary manifest and program.
+class BatchTest : public ::testing::Test
+{
+  protected:
+    std::string manifest;
+    std::string program;
+
+    void SetUp() override
+    {
+        const std::string base = std::string("/tmp/emu_batch_test_") + std::to_string(::getpid()) +
+                                 "_" + std::to_string(::rand());
+        manifest = base + ".batch";
+        program  = base + ".asm";
+
+        // R2 = R0 + R1
+        std::ofstream out(program);
+        out << "@R0\nD=M\n@R1\nD=D+M\n@R2\nM=D\n(END)\n@END\n0;JMP\n";
+    }
+
+    void TearDown() override
+    {
+        std::remove(manifest.c_str());
+        std::remove(program.c_str());
+    }
+
+    void WriteManifest(const std::string& text)
+    {
+        std::ofstream out(manifest);
+        out << text;
+    }
+
+    std::string Name() const { return program.substr(program.rfind('/') + 1); }
+};
+
+TEST_F(BatchTest, ReadBatch)
+{
+    WriteManifest("// sums\n" + Name() + " 100 0=2 1=-3 2==-1 // 2 + -3\n\n" + Name() +
+                  " 5 0=65535 2==-1\n");
+
+    std::vector<Emu::BatchJob> jobs;
+    ASSERT_TRUE(Emu::ReadBatch(manifest, jobs));
+    ASSERT_EQ(jobs.size(), 2u);
+
+    EXPECT_EQ(jobs[0].rom, program);
+    EXPECT_EQ(jobs[0].cycles, 100u);
+    ASSERT_EQ(jobs[0].init.size(), 2u);
+    EXPECT_EQ(jobs[0].init[1].addr, 1);
+    EXPECT_EQ(jobs[0].init[1].value, -3);
+    ASSERT_EQ(jobs[0].expect.size(), 1u);
+    EXPECT_EQ(jobs[0].expect[0].addr, 2);
+    EXPECT_EQ(jobs[0].expect[0].value, -1);
+    EXPECT_EQ(jobs[1].init[0].value, -1);
+}
+
+TEST_F(BatchTest, InvalidManifest)
+{
+    std::vector<Emu::BatchJob> jobs;
+    for (const char* bad : { " x\n", " 0\n", " 10 0:1\n", " 10 40000=1\n", " 10 0=70000\n" }) {
+        WriteManifest(Name() + bad);
+        EXPECT_FALSE(Emu::ReadBatch(manifest, jobs)) << bad;
+    }
+}
+
+TEST_F(BatchTest, RunBatch)
+{
+    std::string text;
+    for (int i = 0; i < 50; i++) {
+        text += Name() + " 100 0=" + std::to_string(i) + " 1=" + std::to_string(i) +
+                " 2==" + std::to_string(2 * i) + "\n";
+    }
+    text += Name() + " 100 0=1 1=1 2==3\n";  // wrong expectation
+    text += Name() + " 3 0=1 1=1 2==2\n";    // out of cycles
+    text += "missing.asm 100\n";
+
+    WriteManifest(text);
+    std::vector<Emu::BatchJob> jobs;
+    ASSERT_TRUE(Emu::ReadBatch(manifest, jobs));
+
+    const auto results = Emu::RunBatch(jobs, 4);
+    ASSERT_EQ(results.size(), jobs.size());
+    for (int i = 0; i < 50; i++) {
+        EXPECT_TRUE(results[i].passed) << i;
+        EXPECT_TRUE(results[i].halted) << i;
+    }
+    EXPECT_FALSE(results[50].passed);
+    EXPECT_EQ(results[50].actual[0].value, 2);
+    EXPECT_FALSE(results[51].passed);
+    EXPECT_EQ(results[51].cycles, 3u);
+    EXPECT_FALSE(results[52].loaded);
+
+    std::ostringstream report;
+    EXPECT_EQ(Emu::WriteReport(report, jobs, results), 3u);
+    EXPECT_NE(report.str().find("RAM[2] = 2, expected 3"), std::string::npos);
+    EXPECT_NE(report.str().find("50/53 passed"), std::string::npos);
+}
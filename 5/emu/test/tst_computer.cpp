@@ -0,0 +1,126 @@
+// Tests for Emu::Computer
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "../computer.h"
+
+using Emu::Computer;
+
+// 5/Add.hack: RAM[0] = 2 + 3
+static const std::vector<std::uint16_t> ADD = {
+    0b0000000000000010, 0b1110110000010000, 0b0000000000000011,
+    0b1110000010010000, 0b0000000000000000, 0b1110001100001000,
+};
+
+// 5/Rect.hack: draws a 16 pixel wide rectangle, RAM[0] rows high
+static const std::vector<std::uint16_t> RECT = {
+    0b0000000000000000, 0b1111110000010000, 0b0000000000010111, 0b1110001100000110,
+    0b0000000000010000, 0b1110001100001000, 0b0100000000000000, 0b1110110000010000,
+    0b0000000000010001, 0b1110001100001000, 0b0000000000010001, 0b1111110000100000,
+    0b1110111010001000, 0b0000000000010001, 0b1111110000010000, 0b0000000000100000,
+    0b1110000010010000, 0b0000000000010001, 0b1110001100001000, 0b0000000000010000,
+    0b1111110010011000, 0b0000000000001010, 0b1110001100000001, 0b0000000000010111,
+    0b1110101010000111,
+};
+
+TEST(ComputerTest, Add)
+{
+    Computer c;
+    c.LoadRom(ADD);
+    c.Run(ADD.size());
+
+    EXPECT_EQ(c.Read(0), 5);
+    EXPECT_EQ(c.D(), 5);
+    EXPECT_EQ(c.PC(), ADD.size());
+    EXPECT_EQ(c.Cycles(), ADD.size());
+}
+
+TEST(ComputerTest, AluComputations)
+{
+    // comp bits "a c1..c6" from the Hack specification
+    const std::uint16_t d = 12, a = 5, m = 7;
+    EXPECT_EQ(Emu::Alu(0b0101010, d, a, m), 0);
+    EXPECT_EQ(Emu::Alu(0b0111111, d, a, m), 1);
+    EXPECT_EQ(Emu::Alu(0b0111010, d, a, m), 0xFFFF);
+    EXPECT_EQ(Emu::Alu(0b0001100, d, a, m), d);
+    EXPECT_EQ(Emu::Alu(0b0110000, d, a, m), a);
+    EXPECT_EQ(Emu::Alu(0b1110000, d, a, m), m);
+    EXPECT_EQ(Emu::Alu(0b0001101, d, a, m), static_cast<std::uint16_t>(~d));
+    EXPECT_EQ(Emu::Alu(0b0001111, d, a, m), static_cast<std::uint16_t>(-d));
+    EXPECT_EQ(Emu::Alu(0b0011111, d, a, m), d + 1);
+    EXPECT_EQ(Emu::Alu(0b1110010, d, a, m), m - 1);
+    EXPECT_EQ(Emu::Alu(0b0000010, d, a, m), d + a);
+    EXPECT_EQ(Emu::Alu(0b1010011, d, a, m), d - m);
+    EXPECT_EQ(Emu::Alu(0b1000111, d, a, m), static_cast<std::uint16_t>(m - d));
+    EXPECT_EQ(Emu::Alu(0b0000000, d, a, m), d & a);
+    EXPECT_EQ(Emu::Alu(0b1010101, d, a, m), d | m);
+}
+
+TEST(ComputerTest, MemoryIsAddressedByOldA)
+{
+    // @10, AM=M+1 -> RAM[10] = 1, A = 1
+    Computer c;
+    c.LoadRom(std::vector<std::uint16_t>{ 0b0000000000001010, 0b1111110111101000 });
+    c.Run(2);
+
+    EXPECT_EQ(c.Read(10), 1);
+    EXPECT_EQ(c.A(), 1);
+}
+
+TEST(ComputerTest, HaltsOnEndLoop)
+{
+    Computer c;
+    c.LoadRom(RECT);
+    c.Write(0, 4);
+    c.Run(1000);
+
+    EXPECT_TRUE(c.Halted());
+    EXPECT_EQ(c.PC(), 23);
+    for (std::uint16_t row = 0; row < 4; row++) {
+        EXPECT_EQ(c.Read(Computer::SCREEN + row * 32), 0xFFFF);
+    }
+    EXPECT_EQ(c.Read(Computer::SCREEN + 4 * 32), 0);
+
+    // setting the PC resumes execution
+    c.SetPC(0);
+    EXPECT_FALSE(c.Halted());
+}
+
+TEST(ComputerTest, ScreenDirtyRows)
+{
+    Computer c;
+    EXPECT_TRUE(c.ScreenDirty().none());
+
+    c.Write(Computer::SCREEN + 31, 1);
+    c.Write(Computer::SCREEN + 32 * 200, 1);
+    c.Write(Computer::KBD, 1);
+    c.Write(100, 1);
+
+    EXPECT_EQ(c.ScreenDirty().count(), 2u);
+    EXPECT_TRUE(c.ScreenDirty().test(0));
+    EXPECT_TRUE(c.ScreenDirty().test(200));
+
+    c.ClearScreenDirty();
+    EXPECT_TRUE(c.ScreenDirty().none());
+}
+
+TEST(ComputerTest, LoadRomFromFile)
+{
+    const std::string path = std::string("/tmp/emu_rom_test_") + std::to_string(::getpid());
+    {
+        std::ofstream out(path);
+        out << "0000000000000010\n1110110000010000\r\n\n";
+    }
+
+    Computer c;
+    EXPECT_TRUE(c.LoadRom(path));
+    c.Run(2);
+    EXPECT_EQ(c.D(), 2);
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,82 @@
+// Tests for Emu::Framebuffer
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "../computer.h"
+#include "../framebuffer.h"
+
+using Emu::Computer;
+using Emu::Framebuffer;
+
+TEST(FramebufferTest, KernelsAgree)
+{
+    std::mt19937 rng{ 1 };
+    std::vector<std::uint16_t> words(Computer::ROW_WORDS);
+    for (auto& w : words) {
+        w = static_cast<std::uint16_t>(rng());
+    }
+
+    std::vector<std::uint8_t> simd(words.size() * 16), scalar(words.size() * 16);
+    Emu::ExpandWords(words.data(), words.size(), simd.data());
+    Emu::ExpandWordsScalar(words.data(), words.size(), scalar.data());
+
+    EXPECT_EQ(simd, scalar);
+}
+
+TEST(FramebufferTest, BitZeroIsLeftMostPixel)
+{
+    const std::uint16_t word = 0x8001;
+    std::uint8_t px[16];
+    Emu::ExpandWords(&word, 1, px);
+
+    EXPECT_EQ(px[0], 0x00);
+    EXPECT_EQ(px[1], 0xFF);
+    EXPECT_EQ(px[14], 0xFF);
+    EXPECT_EQ(px[15], 0x00);
+}
+
+TEST(FramebufferTest, UpdateOnlyDirtyRows)
+{
+    Computer c;
+    Framebuffer fb;
+
+    EXPECT_EQ(fb.Update(c), 0u);
+
+    c.Write(Computer::SCREEN + 32 * 3 + 1, 0x0001); // row 3, pixel 16
+    EXPECT_EQ(fb.Update(c), 1u);
+    EXPECT_EQ(fb.Pixels()[3 * Framebuffer::WIDTH + 16], 0x00);
+    EXPECT_EQ(fb.Pixels()[3 * Framebuffer::WIDTH + 17], 0xFF);
+
+    // dirty set is cleared by the update
+    EXPECT_EQ(fb.Update(c), 0u);
+}
+
+TEST(FramebufferTest, Rgba)
+{
+    Computer c;
+    Framebuffer fb{ Framebuffer::Format::Rgba };
+    c.Write(Computer::SCREEN, 0x0002);
+    fb.Update(c);
+
+    const auto& px = fb.Pixels();
+    ASSERT_EQ(px.size(), Framebuffer::WIDTH * Framebuffer::HEIGHT * 4);
+    EXPECT_EQ(px[0], 0xFF);
+    EXPECT_EQ(px[4], 0x00);
+    EXPECT_EQ(px[5], 0x00);
+    EXPECT_EQ(px[6], 0x00);
+    EXPECT_EQ(px[7], 0xFF);
+}
+
+TEST(FramebufferTest, Checksum)
+{
+    Computer a, b;
+    EXPECT_EQ(Emu::ScreenChecksum(a), Emu::ScreenChecksum(b));
+
+    a.Write(Computer::SCREEN + 100, 0x1234);
+    EXPECT_NE(Emu::ScreenChecksum(a), Emu::ScreenChecksum(b));
+
+    b.Write(Computer::SCREEN + 100, 0x1234);
+    EXPECT_EQ(Emu::ScreenChecksum(a), Emu::ScreenChecksum(b));
+}
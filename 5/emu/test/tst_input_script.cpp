@@ -0,0 +1,169 @@
+// Tests for Emu::InputScript and the idle fast-forward of Emu::RunWithInput
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+
+#include "../computer.h"
+#include "../input_script.h"
+#include "../loader.h"
+
+using Emu::Computer;
+using Emu::InputScript;
+
+// Counts key presses in R1 and keeps the last key in R0
+static const std::string KEY_COUNTER = "(WAIT)\n@KBD\nD=M\n@WAIT\nD;JEQ\n"
+                                       "@R0\nM=D\n"
+                                       "(RELEASE)\n@KBD\nD=M\n@RELEASE\nD;JNE\n"
+                                       "@R1\nM=M+1\n"
+                                       "@WAIT\n0;JMP\n";
+
+// Test fixture for input replay tests. Creates a temporary file for each test.
+class InputScriptTest : public ::testing::Test
+{
+  protected:
+    std::string tmp_filename;
+
+    void SetUp() override
+    {
+        tmp_filename = std::string("/tmp/emu_input_test_") + std::to_string(::getpid()) + "_" +
+                       std::to_string(::rand()) + ".asm";
+    }
+
+    void TearDown() override { std::remove(tmp_filename.c_str()); }
+
+    void Load(Computer& c, const std::string& source)
+    {
+        {
+            std::ofstream out(tmp_filename);
+            out << source;
+        }
+        Emu::Labels labels;
+        ASSERT_TRUE(Emu::LoadProgram(c, tmp_filename, labels));
+    }
+};
+
+TEST(InputScript, Parse)
+{
+    InputScript s;
+    ASSERT_TRUE(s.Parse("// header\n"
+                        "10 65\n"
+                        "\n"
+                        "20 'q'   // quit\n"
+                        "20 NEWLINE\n"
+                        "30 F12\n"
+                        "40 NONE\n"));
+
+    ASSERT_EQ(s.Events().size(), 5u);
+    EXPECT_EQ(s.Events()[0].cycle, 10u);
+    EXPECT_EQ(s.Events()[0].key, 65);
+    EXPECT_EQ(s.Events()[1].key, 'q');
+    EXPECT_EQ(s.Events()[2].key, 128);
+    EXPECT_EQ(s.Events()[3].key, 152);
+    EXPECT_EQ(s.Events()[4].key, 0);
+    EXPECT_EQ(s.NextCycle(), 10u);
+}
+
+TEST(InputScript, Invalid)
+{
+    InputScript s;
+    EXPECT_FALSE(s.Parse("20 65\n10 66\n"));
+    EXPECT_FALSE(s.Parse("10 SHIFT\n"));
+    EXPECT_FALSE(s.Parse("-5 65\n"));
+    EXPECT_FALSE(s.Parse("10\n"));
+    // numbers that do not fit a cycle or a key code
+    EXPECT_FALSE(s.Parse("99999999999999999999999 65\n"));
+    EXPECT_FALSE(s.Parse("10 70000\n"));
+    EXPECT_FALSE(s.Parse("10 99999999999999999999999\n"));
+    EXPECT_TRUE(s.Parse("18446744073709551615 65535\n"));
+}
+
+TEST(InputScript, Apply)
+{
+    InputScript s;
+    ASSERT_TRUE(s.Parse("0 65\n5 66\n5 67\n"));
+
+    Computer c;
+    EXPECT_TRUE(s.Apply(c));
+    EXPECT_EQ(c.Read(Computer::KBD), 65);
+    EXPECT_FALSE(s.Apply(c));
+
+    // later events at the same cycle win
+    c.SetCycles(7);
+    EXPECT_TRUE(s.Apply(c));
+    EXPECT_EQ(c.Read(Computer::KBD), 67);
+    EXPECT_FALSE(s.HasMore());
+    EXPECT_EQ(s.NextCycle(), InputScript::NEVER);
+}
+
+TEST_F(InputScriptTest, DetectsPollLoop)
+{
+    Computer c;
+    Load(c, KEY_COUNTER);
+    c.SetIdleDetection(true);
+
+    EXPECT_LT(c.Run(1000), 1000u);
+    EXPECT_TRUE(c.Idle());
+    EXPECT_EQ(c.IdlePeriod(), 4u);
+
+    // a key press is a change from outside the loop
+    c.Write(Computer::KBD, 65);
+    c.ClearIdle();
+    c.Run(100);
+    EXPECT_EQ(c.Read(0), 65);
+    EXPECT_TRUE(c.Idle());
+}
+
+TEST_F(InputScriptTest, FastForwardIsExact)
+{
+    const std::string events = "1000 'a'\n5003 NONE\n9001 66\n12000 0\n";
+
+    Computer slow;
+    Load(slow, KEY_COUNTER);
+    InputScript slow_input;
+    ASSERT_TRUE(slow_input.Parse(events));
+
+    Computer fast;
+    Load(fast, KEY_COUNTER);
+    fast.SetIdleDetection(true);
+    InputScript fast_input;
+    ASSERT_TRUE(fast_input.Parse(events));
+
+    for (const std::uint64_t until : { 999u, 1000u, 3333u, 9002u, 11999u }) {
+        ASSERT_TRUE(Emu::RunWithInput(slow, &slow_input, until));
+        ASSERT_TRUE(Emu::RunWithInput(fast, &fast_input, until));
+
+        EXPECT_EQ(fast.Cycles(), until);
+        EXPECT_EQ(fast.Cycles(), slow.Cycles());
+        EXPECT_EQ(fast.PC(), slow.PC()) << until;
+        EXPECT_EQ(fast.A(), slow.A()) << until;
+        EXPECT_EQ(fast.D(), slow.D()) << until;
+        EXPECT_EQ(fast.Read(0), slow.Read(0)) << until;
+        EXPECT_EQ(fast.Read(1), slow.Read(1)) << until;
+        EXPECT_EQ(fast.Read(Computer::KBD), slow.Read(Computer::KBD)) << until;
+    }
+    EXPECT_EQ(fast.Read(0), 66);
+    EXPECT_EQ(fast.Read(1), 1); // 'B' is released at 12000
+}
+
+TEST_F(InputScriptTest, FastForwardSkipsLongWaits)
+{
+    Computer c;
+    Load(c, KEY_COUNTER);
+    c.SetIdleDetection(true);
+
+    InputScript s;
+    ASSERT_TRUE(s.Parse("1000000000000 'x'\n2000000000000 NONE\n"));
+
+    ASSERT_TRUE(Emu::RunWithInput(c, &s, 1000000000100));
+    EXPECT_EQ(c.Cycles(), 1000000000100u);
+    EXPECT_EQ(c.Read(0), 'x');
+
+    // no more input: stops as soon as the loop is recognised
+    EXPECT_FALSE(Emu::RunWithInput(c, &s, InputScript::NEVER));
+    EXPECT_TRUE(c.Idle());
+    EXPECT_GT(c.Cycles(), 2000000000000u);
+    EXPECT_EQ(c.Read(1), 1);
+}
@@ -0,0 +1,421 @@
+// Differential tests for Emu::Intrinsics
+//
+// The OS functions are written in VM code the way the Jack compiler emits
+// them and translated by Vm::Pipeline, as vm does. Every function is run
+// twice from the same call in Sys.init: once through the translated code,
+// once through the native intrinsic. Both must leave the same registers,
+// stack, return value and PC, with the full frames of a plain translation
+// and with the frames vm reduces after analyzing the whole program.
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../../6/asm/assembler.h"
+#include "../../../8/vm/code_writer.h"
+#include "../../../8/vm/pipeline.h"
+#include "../computer.h"
+#include "../intrinsics.h"
+#include "../loader.h"
+
+using Emu::Computer;
+
+// Math, Memory and the String constants as a Jack compiler writes them; divide and sqrt loop on
+// an error, where Sys.error would halt
+static constexpr std::string_view LIBRARY = R"vm(
+function Math.multiply 2
+push constant 1
+pop local 1
+label MUL_LOOP
+push local 1
+if-goto MUL_BIT
+push local 0
+return
+label MUL_BIT
+push argument 1
+push local 1
+and
+if-goto MUL_ADD
+goto MUL_SHIFT
+label MUL_ADD
+push local 0
+push argument 0
+add
+pop local 0
+label MUL_SHIFT
+push argument 0
+push argument 0
+add
+pop argument 0
+push local 1
+push local 1
+add
+pop local 1
+goto MUL_LOOP
+
+function Math.divide 2
+push argument 1
+push constant 0
+eq
+if-goto DIV_ERROR
+push argument 0
+push constant 0
+lt
+if-goto DIV_NEG_X
+goto DIV_Y
+label DIV_NEG_X
+push argument 0
+neg
+pop argument 0
+push local 1
+not
+pop local 1
+label DIV_Y
+push argument 1
+push constant 0
+lt
+if-goto DIV_NEG_Y
+goto DIV_LOOP
+label DIV_NEG_Y
+push argument 1
+neg
+pop argument 1
+push local 1
+not
+pop local 1
+label DIV_LOOP
+push argument 0
+push argument 1
+lt
+if-goto DIV_END
+push argument 0
+push argument 1
+sub
+pop argument 0
+push local 0
+push constant 1
+add
+pop local 0
+goto DIV_LOOP
+label DIV_END
+push local 1
+if-goto DIV_NEGATE
+push local 0
+return
+label DIV_NEGATE
+push local 0
+neg
+return
+label DIV_ERROR
+goto DIV_ERROR
+
+function Math.sqrt 2
+push argument 0
+push constant 0
+lt
+if-goto SQRT_ERROR
+push constant 1
+pop local 1
+label SQRT_LOOP
+push argument 0
+push local 1
+lt
+if-goto SQRT_END
+push argument 0
+push local 1
+sub
+pop argument 0
+push local 1
+push constant 2
+add
+pop local 1
+push local 0
+push constant 1
+add
+pop local 0
+goto SQRT_LOOP
+label SQRT_END
+push local 0
+return
+label SQRT_ERROR
+goto SQRT_ERROR
+
+function Math.abs 0
+push argument 0
+push constant 0
+lt
+if-goto ABS_NEG
+push argument 0
+return
+label ABS_NEG
+push argument 0
+neg
+return
+
+function Math.min 0
+push argument 0
+push argument 1
+lt
+if-goto MIN_A
+push argument 1
+return
+label MIN_A
+push argument 0
+return
+
+function Math.max 0
+push argument 0
+push argument 1
+gt
+if-goto MAX_A
+push argument 1
+return
+label MAX_A
+push argument 0
+return
+
+function Memory.peek 0
+push static 0
+push argument 0
+add
+pop pointer 1
+push that 0
+return
+
+function Memory.poke 0
+push static 0
+push argument 0
+add
+push argument 1
+pop temp 0
+pop pointer 1
+push temp 0
+pop that 0
+push constant 0
+return
+
+function String.newLine 0
+push constant 128
+return
+
+function String.backSpace 0
+push constant 129
+return
+
+function String.doubleQuote 0
+push constant 34
+return
+)vm";
+
+// Sys.init with locals and THIS/THAT set, calling `fn(args)` and halting
+// with the result on the stack
+static std::string
+Driver(const std::string& fn, const std::vector<std::int16_t>& args)
+{
+    std::string s = "function Sys.init 2\n"
+                    "push constant 3000\npop pointer 0\npush constant 4000\npop pointer 1\n"
+                    "push constant 11\npop local 0\npush constant 22\npop local 1\n";
+    for (const int a : args) {
+        s += "push constant " + std::to_string(a < 0 ? -a : a) + "\n" + (a < 0 ? "neg\n" : "");
+    }
+    s += "call " + fn + " " + std::to_string(args.size()) + "\n";
+    s += "label HALT\ngoto HALT\n";
+    return s;
+}
+
+// Test fixture for Intrinsics tests. Translates and loads the program for each call.
+class IntrinsicsTest : public ::testing::Test
+{
+  protected:
+    void Load(Computer& c, Emu::Labels& labels, const std::string& fn, const std::vector<std::int16_t>& args,
+              bool reduced)
+    {
+        const std::string sys = Driver(fn, args);
+        Asm::Listing listing;
+        {
+            Vm::CodeWriter writer{ listing };
+            Vm::Pipeline pipeline{ writer };
+            if (reduced) {
+                pipeline.Analyze(std::span<const char>{ sys });
+                pipeline.Analyze(LIBRARY);
+            }
+            pipeline.Translate(sys, "Sys");
+            pipeline.Translate(LIBRARY, "Memory");
+        }
+        Asm::Program program;
+        Asm::Assemble(listing, program);
+        c.LoadRom(program.words);
+        labels = std::move(program.labels);
+    }
+
+    // Runs `fn(args)` with and without the intrinsic and compares the result,
+    // in full and in reduced frames
+    void Compare(const std::string& fn, const std::vector<std::int16_t>& args, std::uint16_t watch = 0)
+    {
+        for (const bool reduced : { false, true }) {
+            SCOPED_TRACE(reduced ? "reduced frames" : "full frames");
+            Compare(fn, args, watch, reduced);
+        }
+    }
+
+    void Compare(const std::string& fn, const std::vector<std::int16_t>& args, std::uint16_t watch, bool reduced)
+    {
+        Computer hack, native;
+        Emu::Labels hack_labels, native_labels;
+        Load(hack, hack_labels, fn, args, reduced);
+        Load(native, native_labels, fn, args, reduced);
+
+        Emu::Intrinsics intrinsics;
+        ASSERT_GT(intrinsics.Install(native, native_labels), 0u);
+
+        hack.Run(1000000);
+        native.Run(1000000);
+        ASSERT_TRUE(hack.Halted()) << fn;
+        ASSERT_TRUE(native.Halted()) << fn;
+        EXPECT_EQ(intrinsics.Calls(), 1u) << fn;
+
+        // SP LCL ARG THIS THAT, R13 R14 as `return` leaves them
+        for (const std::uint16_t addr : { 0, 1, 2, 3, 4, 13, 14 }) {
+            EXPECT_EQ(native.Read(addr), hack.Read(addr)) << fn << " RAM[" << addr << "]";
+        }
+        // the stack with the return value on top
+        for (std::uint16_t addr = 256; addr < hack.Read(0); addr++) {
+            EXPECT_EQ(native.Read(addr), hack.Read(addr)) << fn << " RAM[" << addr << "]";
+        }
+        EXPECT_EQ(native.Read(watch), hack.Read(watch)) << fn << " RAM[" << watch << "]";
+        EXPECT_EQ(native.PC(), hack.PC());
+        EXPECT_LT(native.Cycles(), hack.Cycles());
+    }
+
+    // The value fn(args) leaves on the stack, through the intrinsic
+    std::int16_t Result(const Computer& c) { return static_cast<std::int16_t>(c.Read(c.Read(0) - 1)); }
+};
+
+TEST_F(IntrinsicsTest, MathMultiply)
+{
+    for (const auto& [x, y] : std::vector<std::pair<std::int16_t, std::int16_t>>{
+           { 0, 0 }, { 3, 7 }, { -3, 7 }, { 181, 181 }, { -1, -1 }, { 300, 300 }, { 12345, -2 } }) {
+        Compare("Math.multiply", { x, y });
+    }
+}
+
+TEST_F(IntrinsicsTest, MathAbsMinMax)
+{
+    for (const std::int16_t x : { 0, 1, -1, 1000, -32767 }) {
+        Compare("Math.abs", { x });
+    }
+    for (const auto& [a, b] : std::vector<std::pair<std::int16_t, std::int16_t>>{
+           { 0, 0 }, { 1, 2 }, { 2, 1 }, { -5, 3 }, { 3, -5 }, { -100, -200 } }) {
+        Compare("Math.min", { a, b });
+        Compare("Math.max", { a, b });
+    }
+}
+
+TEST_F(IntrinsicsTest, Memory)
+{
+    Compare("Memory.peek", { 0 });
+    Compare("Memory.peek", { 256 });
+    Compare("Memory.poke", { 8000, -42 }, 8000);
+    Compare("Memory.poke", { Computer::SCREEN, 7 }, Computer::SCREEN);
+}
+
+TEST_F(IntrinsicsTest, StringConstants)
+{
+    Compare("String.newLine", {});
+    Compare("String.backSpace", {});
+    Compare("String.doubleQuote", {});
+}
+
+TEST_F(IntrinsicsTest, DivideAndSqrt)
+{
+    struct Case
+    {
+        const char* fn;
+        std::vector<std::int16_t> args;
+        std::int16_t expected;
+    };
+
+    const std::vector<Case> cases = {
+        { "Math.divide", { 7, 2 }, 3 },        { "Math.divide", { -7, 2 }, -3 },
+        { "Math.divide", { 7, -2 }, -3 },      { "Math.divide", { 32767, 1000 }, 32 },
+        { "Math.sqrt", { 0 }, 0 },             { "Math.sqrt", { 15 }, 3 },
+        { "Math.sqrt", { 16 }, 4 },            { "Math.sqrt", { 32767 }, 181 },
+    };
+
+    for (const auto& c : cases) {
+        Compare(c.fn, c.args);
+
+        for (const bool reduced : { false, true }) {
+            Computer computer;
+            Emu::Labels labels;
+            Load(computer, labels, c.fn, c.args, reduced);
+            Emu::Intrinsics intrinsics;
+            intrinsics.Install(computer, labels);
+            computer.Run(1000);
+            EXPECT_EQ(Result(computer), c.expected) << c.fn;
+        }
+    }
+}
+
+TEST_F(IntrinsicsTest, FallsBackToHackCode)
+{
+    for (const bool reduced : { false, true }) {
+        Computer computer;
+        Emu::Labels labels;
+        Load(computer, labels, "Math.divide", { 1, 0 }, reduced);
+
+        // Math.divide(1, 0) is left to the Hack code, which stops in its error loop
+        Emu::Intrinsics intrinsics;
+        intrinsics.Install(computer, labels);
+
+        computer.Run(10000);
+        EXPECT_EQ(intrinsics.Calls(), 0u);
+        EXPECT_TRUE(computer.Halted());
+        EXPECT_EQ(computer.PC(), labels.at("DIV_ERROR"));
+    }
+}
+
+// Every frame a call may build: Math.abs saves neither LCL nor THIS/THAT,
+// Math.multiply only LCL, Memory.peek only THIS/THAT, Sys.init all of them
+TEST_F(IntrinsicsTest, EnteredFrame)
+{
+    struct Case
+    {
+        const char* fn;
+        std::vector<std::int16_t> args;
+        std::uint16_t size;
+        bool lcl;
+        bool this_that;
+    };
+
+    const std::vector<Case> cases = {
+        { "Math.abs", { -3 }, 2, false, false },
+        { "Math.multiply", { 6, 7 }, 3, true, false },
+        { "Memory.peek", { 256 }, 4, false, true },
+        { "Sys.init", {}, 5, true, true },
+    };
+
+    for (const auto& c : cases) {
+        Computer computer;
+        Emu::Labels labels;
+        Load(computer, labels, c.fn == std::string{ "Sys.init" } ? "Math.abs" : c.fn, c.args, true);
+
+        // look at the frame where a trap would, then run the Hack code
+        std::optional<Emu::CallFrame> frame;
+        computer.SetTrap(static_cast<std::uint16_t>(labels.at(c.fn)), true);
+        computer.SetTrapHandler([&](Computer& at, std::uint16_t) {
+            frame = Emu::EnteredFrame(at, c.args.size());
+            return false;
+        });
+        computer.Run(100000);
+
+        ASSERT_TRUE(frame) << c.fn;
+        EXPECT_EQ(frame->size, c.size) << c.fn;
+        EXPECT_EQ(frame->lcl, c.lcl) << c.fn;
+        EXPECT_EQ(frame->this_that, c.this_that) << c.fn;
+        EXPECT_TRUE(computer.Halted()) << c.fn;
+    }
+}
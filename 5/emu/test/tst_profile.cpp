@@ -0,0 +1,55 @@
+// Tests for Emu::WriteProfile
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+
+#include "../computer.h"
+#include "../profile.h"
+
+using Emu::Computer;
+
+// Sys.init jumps to Main.f, which counts D = 2 down to 0 in LOOP
+static const std::vector<std::uint16_t> LOOP = {
+    2,  0b1110110000010000, // (Sys.init) @2 D=A
+    4,  0b1110101010000111, // @Main.f 0;JMP
+    5,                      // (Main.f) @LOOP
+    0b1110001110010000,     // (LOOP) D=D-1
+    5,  0b1110001100000001, // @LOOP D;JGT
+    8,  0b1110101010000111, // (END) @END 0;JMP
+};
+
+TEST(ProfileTest, OffByDefault)
+{
+    Computer c;
+    c.LoadRom(LOOP);
+    c.Run(100);
+    EXPECT_TRUE(c.Counts().empty());
+}
+
+TEST(ProfileTest, CountsByLabel)
+{
+    Computer c;
+    c.LoadRom(LOOP);
+    c.SetProfiling(true);
+    c.Run(100);
+    ASSERT_TRUE(c.Halted());
+    EXPECT_EQ(c.Counts()[5], 2u);
+
+    const Emu::Labels labels{ { "Sys.init", 0 }, { "Main.f", 4 }, { "LOOP", 5 }, { "END", 8 } };
+    std::ostringstream out;
+    Emu::WriteProfile(c, labels, out);
+    EXPECT_EQ(out.str(), "hackprof 1\n"
+                         "cycles 13\n"
+                         "function Main.f 1 9\n"
+                         "function Sys.init 1 4\n"
+                         "label END 1\n"
+                         "label LOOP 2\n");
+}
+
+TEST(ProfileTest, FunctionLabels)
+{
+    EXPECT_TRUE(Emu::IsFunctionLabel("Main.main"));
+    EXPECT_FALSE(Emu::IsFunctionLabel("Main.main$ret.3"));
+    EXPECT_FALSE(Emu::IsFunctionLabel("WHILE_EXP0"));
+}
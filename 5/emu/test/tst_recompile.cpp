@@ -0,0 +1,45 @@
+// Tests for Emu::Recompile
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../recompile.h"
+
+// Calls ROUTINE with its return address in R13, which returns to RET
+static const std::vector<std::uint16_t> CALL = {
+    6,  0b1110110000010000, // @RET D=A
+    13, 0b1110001100001000, // @R13 M=D
+    8,  0b1110101010000111, // @ROUTINE 0;JMP
+    6,  0b1110101010000111, // (RET) @RET 0;JMP
+    13, 0b1111110000100000, // (ROUTINE) @R13 A=M
+    0b1110101010000111,     // 0;JMP
+};
+static const Emu::Labels LABELS{ { "RET", 6 }, { "ROUTINE", 8 } };
+
+TEST(RecompileTest, BlockStarts)
+{
+    const std::vector<std::uint16_t> expected{ 0, 6, 8 };
+    EXPECT_EQ(Emu::BlockStarts(CALL, LABELS), expected);
+
+    // a direct target starts a block without a label
+    EXPECT_EQ(Emu::BlockStarts(CALL, {}), (std::vector<std::uint16_t>{ 0, 6, 8 }));
+}
+
+TEST(RecompileTest, JumpsAndHalt)
+{
+    std::ostringstream out;
+    const Emu::Recompiled stats = Emu::Recompile(CALL, LABELS, out);
+    EXPECT_EQ(stats.blocks, 3u);
+    EXPECT_EQ(stats.direct, 2u);
+    EXPECT_EQ(stats.indirect, 1u);
+
+    const std::string code = out.str();
+    EXPECT_NE(code.find("goto L_8;"), std::string::npos);
+    EXPECT_NE(code.find("L_6: // RET"), std::string::npos);
+    // the return lands on RET through the switch
+    EXPECT_NE(code.find("case 6: goto L_6;"), std::string::npos);
+    // (RET) @RET 0;JMP halts
+    EXPECT_NE(code.find("{ pc = 6; halted = true; goto stop; }"), std::string::npos);
+}
@@ -0,0 +1,98 @@
+// Tests for Emu::SaveSnapshot/LoadSnapshot
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "../computer.h"
+#include "../snapshot.h"
+
+using Emu::Computer;
+
+// Test fixture for snapshot tests. Creates a temporary file for each test.
+class SnapshotTest : public ::testing::Test
+{
+  protected:
+    std::string tmp_filename;
+
+    void SetUp() override
+    {
+        tmp_filename = std::string("/tmp/emu_snapshot_test_") + std::to_string(::getpid()) + "_" +
+                       std::to_string(::rand());
+    }
+
+    void TearDown() override { std::remove(tmp_filename.c_str()); }
+
+    // @7, D=A, @100, M=D, (LOOP) @LOOP, 0;JMP
+    static void Boot(Computer& c)
+    {
+        c.LoadRom(std::vector<std::uint16_t>{ 7, 0b1110110000010000, 100, 0b1110001100001000, 4,
+                                              0b1110101010000111 });
+        c.Write(Computer::SCREEN + 5, 0xBEEF);
+        c.Write(30000, 1);
+        c.Write(30001, 2);
+        c.Run(4);
+    }
+
+    void Roundtrip(bool compress)
+    {
+        Computer a;
+        Boot(a);
+        ASSERT_TRUE(Emu::SaveSnapshot(a, tmp_filename, compress));
+
+        Computer b;
+        Boot(b);
+        b.Reset();
+        b.Write(100, 0);
+        b.ClearScreenDirty();
+        ASSERT_TRUE(Emu::LoadSnapshot(b, tmp_filename));
+
+        EXPECT_EQ(b.PC(), a.PC());
+        EXPECT_EQ(b.A(), a.A());
+        EXPECT_EQ(b.D(), a.D());
+        EXPECT_EQ(b.Cycles(), a.Cycles());
+        for (std::size_t i = 0; i < Computer::RAM_SIZE; i++) {
+            ASSERT_EQ(b.Read(i), a.Read(i)) << i;
+        }
+        EXPECT_TRUE(b.ScreenDirty().all());
+    }
+};
+
+TEST_F(SnapshotTest, Roundtrip)
+{
+    Roundtrip(false);
+}
+
+TEST_F(SnapshotTest, RoundtripCompressed)
+{
+    Roundtrip(true);
+
+    std::ifstream in(tmp_filename, std::ios::binary | std::ios::ate);
+    EXPECT_LT(static_cast<std::size_t>(in.tellg()), 256u);
+}
+
+TEST_F(SnapshotTest, RejectsDifferentRom)
+{
+    Computer a;
+    Boot(a);
+    ASSERT_TRUE(Emu::SaveSnapshot(a, tmp_filename, false));
+
+    Computer b;
+    b.LoadRom(std::vector<std::uint16_t>{ 1, 2, 3 });
+    EXPECT_FALSE(Emu::LoadSnapshot(b, tmp_filename));
+}
+
+TEST_F(SnapshotTest, RejectsBrokenFile)
+{
+    {
+        std::ofstream out(tmp_filename);
+        out << "HACKSNAP but not really";
+    }
+
+    Computer c;
+    EXPECT_FALSE(Emu::LoadSnapshot(c, tmp_filename));
+    EXPECT_FALSE(Emu::LoadSnapshot(c, tmp_filename + ".missing"));
+}
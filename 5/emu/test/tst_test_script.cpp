@@ -0,0 +1,176 @@
+// Tests for Emu::RunTestScript (CPU and VM emulator dialects)
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "../test_script.h"
+
+// Test fixture for .tst scripts. Writes the script, program and compare
+// file next to each other in a temporary directory.
+class TestScriptTest : public ::testing::Test
+{
+  protected:
+    std::string dir;
+    std::vector<std::string> files;
+
+    void SetUp() override
+    {
+        dir = std::string("/tmp/emu_tst_test_") + std::to_string(::getpid()) + "_" +
+              std::to_string(::rand());
+        ASSERT_EQ(::mkdir(dir.c_str(), 0700), 0);
+    }
+
+    void TearDown() override
+    {
+        for (auto&& f : files) {
+            std::remove(f.c_str());
+        }
+        ::rmdir(dir.c_str());
+    }
+
+    std::string Write(const std::string& name, const std::string& text)
+    {
+        const std::string path = dir + "/" + name;
+        std::ofstream out(path);
+        out << text;
+        files.push_back(path);
+        return path;
+    }
+};
+
+// R2 = R0 + R1
+static const std::string ADD_ASM = "@R0\nD=M\n@R1\nD=D+M\n@R2\nM=D\n(END)\n@END\n0;JMP\n";
+
+static const std::string ADD_TST = "load Add.asm,\n"
+                                   "output-file Add.out,\n"
+                                   "compare-to Add.cmp,\n"
+                                   "output-list RAM[0]%D2.6.2 RAM[2]%D1.6.1 PC%X1.4.1;\n"
+                                   "/* two runs */\n"
+                                   "set RAM[0] 3, set RAM[1] -5;\n"
+                                   "repeat 10 { ticktock; }\n"
+                                   "output;\n"
+                                   "set PC 0, set RAM[0] %X10;\n"
+                                   "repeat 2 { tick, tock; output; }\n";
+
+TEST_F(TestScriptTest, CpuScript)
+{
+    Write("Add.asm", ADD_ASM);
+    Write("Add.cmp", "|  RAM[0]  | RAM[2] |  PC  |\n"
+                     "|       3  |     -2 | 0006 |\n"
+                     "|      16  |     -2 | 0001 |\n"
+                     "|      16  |     -2 | 0002 |\n");
+    const auto r = Emu::RunTestScript(Write("Add.tst", ADD_TST));
+
+    EXPECT_TRUE(r.passed) << r.error;
+    EXPECT_FALSE(r.vm);
+    EXPECT_EQ(r.compared, 4u);
+    EXPECT_EQ(r.steps, 12u);
+}
+
+TEST_F(TestScriptTest, CpuScriptMismatch)
+{
+    Write("Add.asm", ADD_ASM);
+    Write("Add.cmp", "|  RAM[0]  | RAM[2] |  PC  |\n"
+                     "|       3  |     -1 | 0007 |\n");
+    const auto r = Emu::RunTestScript(Write("Add.tst", ADD_TST));
+
+    EXPECT_FALSE(r.passed);
+    EXPECT_NE(r.error.find("line 2"), std::string::npos) << r.error;
+    EXPECT_EQ(r.compared, 1u);
+}
+
+TEST_F(TestScriptTest, MissingOutput)
+{
+    Write("Add.asm", ADD_ASM);
+    Write("Add.cmp", "|  RAM[0]  | RAM[2] |  PC  |\n"
+                     "|       3  |     -2 | 0006 |\n"
+                     "|      16  |     -2 | 0001 |\n"
+                     "|      16  |     -2 | 0002 |\n"
+                     "|      16  |     -2 | 0003 |\n");
+    const auto r = Emu::RunTestScript(Write("Add.tst", ADD_TST));
+
+    EXPECT_FALSE(r.passed);
+    EXPECT_NE(r.error.find("missing output"), std::string::npos) << r.error;
+}
+
+TEST_F(TestScriptTest, VmScript)
+{
+    Write("Main.vm", "function Main.twice 0\n"
+                     "push argument 0\npush argument 0\nadd\nreturn\n");
+    Write("Sys.vm", "function Sys.init 0\n"
+                    "push constant 7\ncall Main.twice 1\n"
+                    "push constant 3\ncall Math.multiply 2\n" // built-in
+                    "pop static 0\n"
+                    "label END\ngoto END\n");
+    Write("Prog.cmp", "|RAM[0]|RAM[16|\n"
+                      "|   256|    42|\n");
+    const auto r = Emu::RunTestScript(Write("Prog.tst", "load,\n"
+                                                        "compare-to Prog.cmp,\n"
+                                                        "output-list RAM[0]%D0.6.0 RAM[16]%D0.6.0;\n"
+                                                        "set sp 256,\n"
+                                                        "repeat 100 { vmstep; }\n"
+                                                        "output;\n"));
+
+    EXPECT_TRUE(r.passed) << r.error;
+    EXPECT_TRUE(r.vm);
+    EXPECT_EQ(r.compared, 2u);
+}
+
+TEST_F(TestScriptTest, VmScriptSteps)
+{
+    // labels are not steps: 2 + 3 * 6 + 1 commands to reach the end
+    Write("Loop.vm", "push constant 3\npop local 0\n"
+                     "label LOOP\n"
+                     "push local 0\npush constant 1\nsub\npop local 0\n"
+                     "push local 0\nif-goto LOOP\n"
+                     "push constant 99\n");
+    Write("Loop.cmp", "|RAM[0]|local[|argume|\n"
+                      "|   256|     0|     7|\n"
+                      "|   257|     0|     7|\n");
+    const auto r = Emu::RunTestScript(Write("Loop.tst", "load Loop.vm, compare-to Loop.cmp,\n"
+                                                        "set sp 256, set local 300,\n"
+                                                        "set argument 400, set argument[1] 7,\n"
+                                                        "output-list RAM[0]%D0.6.0 local[0]%D0.6.0 "
+                                                        "argument[1]%D0.6.0;\n"
+                                                        "repeat 20 { vmstep; }\n"
+                                                        "output;\n"
+                                                        "repeat 20 { vmstep; }\n"
+                                                        "output;\n"));
+
+    EXPECT_TRUE(r.passed) << r.error;
+    EXPECT_EQ(r.compared, 3u);
+    EXPECT_EQ(r.steps, 21u); // stops past the last command
+}
+
+// Numbers that do not fit are load errors, not a different program
+TEST_F(TestScriptTest, VmScriptOutOfRange)
+{
+    for (const char* line : { "push constant 99999999999999999999", "push constant 70000", "push constant 32768",
+                              "push local 70000", "call Main.f 70000" }) {
+        Write("Bad.vm", std::string(line) + "\n");
+        const auto r = Emu::RunTestScript(Write("Bad.tst", "load Bad.vm, vmstep;\n"));
+        EXPECT_FALSE(r.passed) << line;
+    }
+
+    Write("Max.vm", "push constant 32767\npop static 0\n");
+    const auto r = Emu::RunTestScript(Write("Max.tst", "load Max.vm, set sp 256, vmstep, vmstep;\n"));
+    EXPECT_TRUE(r.passed) << r.error;
+}
+
+TEST_F(TestScriptTest, Unsupported)
+{
+    Write("Add.asm", ADD_ASM);
+    auto r = Emu::RunTestScript(Write("A.tst", "load Add.asm, repeat { ticktock; }"));
+    EXPECT_FALSE(r.passed);
+    EXPECT_NE(r.error.find("interactive"), std::string::npos);
+
+    r = Emu::RunTestScript(Write("B.tst", "load Add.asm, breakpoint PC 3;"));
+    EXPECT_FALSE(r.passed);
+    EXPECT_NE(r.error.find("breakpoint"), std::string::npos);
+
+    r = Emu::RunTestScript(Write("C.tst", "load Add.asm, vmstep;"));
+    EXPECT_FALSE(r.passed);
+}
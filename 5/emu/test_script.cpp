@@ -0,0 +1,337 @@
+#include "test_script.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "computer.h"
+#include "loader.h"
+#include "script.h"
+#include "vm_machine.h"
+
+namespace Emu {
+
+namespace fs = std::filesystem;
+
+// Executes a parsed script against a Computer, or a VmMachine on its RAM
+class ScriptRunner
+{
+  public:
+    ScriptRunner(const fs::path& dir, ScriptResult& result)
+      : _dir(dir)
+      , _result(result)
+    {
+    }
+
+    bool Exec(const std::vector<ScriptCommand>& commands);
+    bool Finish();
+
+  private:
+    bool Exec(const ScriptCommand& cmd);
+    bool Fail(const std::string& error)
+    {
+        _result.error = error;
+        return false;
+    }
+
+    bool Load(const std::string& name);
+    bool Step(const std::string& what, std::uint64_t n);
+    bool Address(const std::string& name, std::uint16_t& addr) const;
+    bool Get(const std::string& name, std::uint16_t& v) const;
+    bool Set(const std::string& name, std::uint16_t v);
+    bool Emit(const std::string& line);
+
+    fs::path _dir;
+    ScriptResult& _result;
+
+    Computer _computer;
+    std::unique_ptr<VmMachine> _vm;
+    std::vector<Column> _columns;
+
+    CompareFile _cmp;
+};
+
+bool
+ScriptRunner::Exec(const std::vector<ScriptCommand>& commands)
+{
+    for (auto&& cmd : commands) {
+        if (!Exec(cmd)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+ScriptRunner::Exec(const ScriptCommand& cmd)
+{
+    const std::string& op = cmd.words[0];
+    const std::size_t n   = cmd.words.size();
+
+    if (op == "repeat") {
+        // the common `repeat N { ticktock; }` runs without re-dispatching
+        if (cmd.body.size() == 1 && cmd.body[0].words.size() == 1 && cmd.body[0].repeat == 0) {
+            return Step(cmd.body[0].words[0], cmd.repeat);
+        }
+        for (std::uint64_t i = 0; i < cmd.repeat; i++) {
+            if (!Exec(cmd.body)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if (op == "load") {
+        return Load(n > 1 ? cmd.words[1] : "");
+    }
+
+    if (op == "compare-to" && n == 2) {
+        return _cmp.Open((_dir / cmd.words[1]).string()) ? true
+                                                         : Fail("cannot open " + cmd.words[1]);
+    }
+
+    if (op == "output-list") {
+        _columns.clear();
+        std::string header = "|";
+        for (std::size_t i = 1; i < n; i++) {
+            Column col;
+            if (!ParseColumn(cmd.words[i], col)) {
+                return Fail("invalid output-list entry " + cmd.words[i]);
+            }
+            _columns.push_back(col);
+            header += FormatHeader(col) + "|";
+        }
+        return Emit(header);
+    }
+
+    if (op == "output") {
+        std::string line = "|";
+        for (auto&& col : _columns) {
+            std::uint16_t v;
+            if (!Get(col.name, v)) {
+                return Fail("unknown variable " + col.name);
+            }
+            line += FormatValue(col, v) + "|";
+        }
+        return Emit(line);
+    }
+
+    if (op == "set" && n == 3) {
+        std::uint16_t v;
+        if (!ParseValue(cmd.words[2], v)) {
+            return Fail("invalid value " + cmd.words[2]);
+        }
+        return Set(cmd.words[1], v) ? true : Fail("unknown variable " + cmd.words[1]);
+    }
+
+    if (op == "ticktock" || op == "tick" || op == "tock" || op == "vmstep") {
+        return Step(op, 1);
+    }
+
+    if (op == "output-file" || op == "echo" || op == "clear-echo") {
+        return true;
+    }
+
+    return Fail("unsupported command " + op);
+}
+
+bool
+ScriptRunner::Load(const std::string& name)
+{
+    const fs::path path = name.empty() ? _dir : _dir / name;
+
+    std::error_code ec;
+    if (name.empty() || fs::path(name).extension() == ".vm" || fs::is_directory(path, ec)) {
+        _result.vm = true;
+        _vm        = std::make_unique<VmMachine>(_computer);
+        return _vm->Load(path.string()) ? true : Fail("cannot load " + path.string());
+    }
+
+    Labels labels;
+    return LoadProgram(_computer, path.string(), labels) ? true : Fail("cannot load " + name);
+}
+
+bool
+ScriptRunner::Step(const std::string& what, std::uint64_t n)
+{
+    if (what == "tick") {
+        return true; // the instruction completes on tock
+    }
+
+    if (what == "vmstep") {
+        if (!_vm) {
+            return Fail("vmstep without a VM program");
+        }
+        _result.steps += _vm->Run(n);
+        // running past the last command is not an error, like in the VM emulator
+        return _vm->Error().empty() ? true : Fail(_vm->Error());
+    }
+
+    if (what == "ticktock" || what == "tock") {
+        if (_vm) {
+            return Fail(what + " on a VM program");
+        }
+        for (std::uint64_t i = 0; i < n; i++) {
+            _computer.Step();
+        }
+        _result.steps += n;
+        return true;
+    }
+
+    // a repeat of something else: run it as a block
+    ScriptCommand cmd{ .words = { what } };
+    for (std::uint64_t i = 0; i < n; i++) {
+        if (!Exec(cmd)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+ScriptRunner::Address(const std::string& name, std::uint16_t& addr) const
+{
+    const auto open  = name.find('[');
+    const auto close = name.find(']');
+
+    std::uint16_t index = 0;
+    std::string base    = name;
+    if (open != std::string::npos) {
+        if (close != name.size() - 1 || !ParseValue(name.substr(open + 1, close - open - 1), index)) {
+            return false;
+        }
+        base = name.substr(0, open);
+    }
+
+    if (base == "RAM" && open != std::string::npos) {
+        addr = index & 0x7FFF;
+        return true;
+    }
+    if (!_vm) {
+        return false;
+    }
+
+    // VM emulator names
+    static const std::pair<const char*, std::uint16_t> POINTERS[] = {
+        { "sp", 0 }, { "local", 1 }, { "argument", 2 }, { "this", 3 }, { "that", 4 },
+    };
+    for (auto&& [pname, reg] : POINTERS) {
+        if (base == pname) {
+            addr = open == std::string::npos ? reg : _computer.Read(reg) + index;
+            return true;
+        }
+    }
+    if (base == "temp" && open != std::string::npos && index < 8) {
+        addr = 5 + index;
+        return true;
+    }
+    if (base == "pointer" && open != std::string::npos && index < 2) {
+        addr = 3 + index;
+        return true;
+    }
+    return false;
+}
+
+bool
+ScriptRunner::Get(const std::string& name, std::uint16_t& v) const
+{
+    if (!_vm) {
+        if (name == "PC") {
+            v = _computer.PC();
+            return true;
+        }
+        if (name == "A") {
+            v = _computer.A();
+            return true;
+        }
+        if (name == "D") {
+            v = _computer.D();
+            return true;
+        }
+        if (name == "time") {
+            v = static_cast<std::uint16_t>(_computer.Cycles());
+            return true;
+        }
+    }
+
+    std::uint16_t addr;
+    if (!Address(name, addr)) {
+        return false;
+    }
+    v = _computer.Read(addr);
+    return true;
+}
+
+bool
+ScriptRunner::Set(const std::string& name, std::uint16_t v)
+{
+    if (!_vm) {
+        if (name == "PC") {
+            _computer.SetPC(v);
+            return true;
+        }
+        if (name == "A") {
+            _computer.SetA(v);
+            return true;
+        }
+        if (name == "D") {
+            _computer.SetD(v);
+            return true;
+        }
+    }
+
+    std::uint16_t addr;
+    if (!Address(name, addr)) {
+        return false;
+    }
+    _computer.Write(addr, v);
+    return true;
+}
+
+bool
+ScriptRunner::Emit(const std::string& line)
+{
+    std::string error;
+    if (!_cmp.Check(line, error)) {
+        return Fail(error);
+    }
+    _result.compared = _cmp.Compared();
+    return true;
+}
+
+bool
+ScriptRunner::Finish()
+{
+    std::string error;
+    return _cmp.Finish(error) ? true : Fail(error);
+}
+
+ScriptResult
+RunTestScript(const std::string& path)
+{
+    const auto start = std::chrono::steady_clock::now();
+    ScriptResult result;
+
+    std::ifstream in{ path };
+    if (!in) {
+        result.error = "cannot open " + path;
+        return result;
+    }
+    std::stringstream ss;
+    ss << in.rdbuf();
+
+    std::vector<ScriptCommand> commands;
+    if (ParseScript(ss.str(), commands, result.error)) {
+        ScriptRunner runner{ fs::path(path).parent_path(), result };
+        result.passed = runner.Exec(commands) && runner.Finish();
+    }
+
+    result.ms =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+} // namespace Emu
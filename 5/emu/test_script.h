@@ -0,0 +1,36 @@
+#ifndef EMU_TEST_SCRIPT_HH
+#define EMU_TEST_SCRIPT_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Emu {
+
+// Outcome of one .tst script
+struct ScriptResult
+{
+    bool passed{ false };
+    bool vm{ false };            // VM emulator dialect (vmstep) or CPU (ticktock)
+    std::uint64_t steps{ 0 };    // executed instructions or VM commands
+    std::size_t compared{ 0 };   // output lines matched against the .cmp file
+    std::string error;           // first failure
+    double ms{ 0 };
+};
+
+// Runs a test script of the course's CPU emulator or VM emulator.
+//
+// Supported commands: load, output-file, compare-to, output-list, output,
+// set, repeat N { ... }, ticktock, tick, tock, vmstep, echo, clear-echo.
+// Every `output` line is compared with the next line of the compare-to file
+// as soon as it is produced; the .out file is not written.
+//
+// CPU variables: RAM[n], PC, A, D, time.
+// VM variables:  RAM[n], sp, local, argument, this, that,
+//                local[i], argument[i], this[i], that[i], temp[i], pointer[i].
+ScriptResult
+RunTestScript(const std::string& path);
+
+} // namespace Emu
+
+#endif
@@ -0,0 +1,112 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+namespace Emu {
+
+ThreadPool::ThreadPool(std::size_t threads)
+{
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (std::size_t i = 0; i < threads; i++) {
+        _queues.push_back(std::make_unique<Queue>());
+    }
+    for (std::size_t i = 0; i < threads; i++) {
+        _workers.emplace_back([this, i] { Work(i); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock{ _mutex };
+        _stop = true;
+    }
+    _wake.notify_all();
+
+    for (auto&& worker : _workers) {
+        worker.join();
+    }
+}
+
+void
+ThreadPool::Submit(Task task)
+{
+    Queue& q = *_queues[_next++ % _queues.size()];
+    {
+        std::lock_guard lock{ q.mutex };
+        q.tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard lock{ _mutex };
+        _queued++;
+        _pending++;
+    }
+    _wake.notify_one();
+}
+
+void
+ThreadPool::Wait()
+{
+    std::unique_lock lock{ _mutex };
+    _done.wait(lock, [this] { return _pending == 0; });
+}
+
+bool
+ThreadPool::Pop(std::size_t self, Task& task)
+{
+    for (std::size_t i = 0; i < _queues.size(); i++) {
+        const bool own = i == 0;
+        Queue& q       = *_queues[(self + i) % _queues.size()];
+
+        std::lock_guard lock{ q.mutex };
+        if (q.tasks.empty()) {
+            continue;
+        }
+
+        if (own) {
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+        } else {
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+            _steals++;
+        }
+        return true;
+    }
+    return false;
+}
+
+void
+ThreadPool::Work(std::size_t self)
+{
+    for (;;) {
+        {
+            std::unique_lock lock{ _mutex };
+            _wake.wait(lock, [this] { return _stop || _queued > 0; });
+            if (_queued == 0) {
+                return; // stopped and drained
+            }
+            _queued--;
+        }
+
+        // a task counted in _queued is in some queue until someone takes it
+        Task task;
+        while (!Pop(self, task)) {
+            std::this_thread::yield();
+        }
+        task();
+
+        {
+            std::lock_guard lock{ _mutex };
+            _pending--;
+            if (_pending == 0) {
+                _done.notify_all();
+            }
+        }
+    }
+}
+
+} // namespace Emu
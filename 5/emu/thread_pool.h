@@ -0,0 +1,67 @@
+#ifndef EMU_THREAD_POOL_HH
+#define EMU_THREAD_POOL_HH
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Emu {
+
+// Work-stealing pool: every worker owns a deque, takes from its front and,
+// when empty, steals from the back of the others. Tasks run to completion.
+class ThreadPool
+{
+  public:
+    using Task = std::function<void()>;
+
+    // 0 = std::thread::hardware_concurrency()
+    explicit ThreadPool(std::size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Tasks are dealt round-robin over the worker queues
+    void Submit(Task task);
+
+    // Blocks until every submitted task has finished
+    void Wait();
+
+    std::size_t Size() const { return _workers.size(); }
+
+    // Tasks a worker took from another worker's queue
+    std::size_t Steals() const { return _steals; }
+
+  private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void Work(std::size_t self);
+    bool Pop(std::size_t self, Task& task);
+
+    std::vector<std::unique_ptr<Queue>> _queues;
+    std::vector<std::thread> _workers;
+    std::size_t _next{ 0 };
+
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+    std::size_t _queued{ 0 };  // submitted, not started (guarded by _mutex)
+    std::size_t _pending{ 0 }; // submitted, not finished (guarded by _mutex)
+    bool _stop{ false };
+
+    std::atomic<std::size_t> _steals{ 0 };
+};
+
+} // namespace Emu
+
+#endif
@@ -0,0 +1,405 @@
+#include "vm_machine.h"
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace Emu {
+
+static constexpr std::uint16_t SP   = 0;
+static constexpr std::uint16_t LCL  = 1;
+static constexpr std::uint16_t ARG  = 2;
+static constexpr std::uint16_t THIS = 3;
+static constexpr std::uint16_t THAT = 4;
+static constexpr std::uint16_t TEMP = 5;
+
+static constexpr std::uint16_t STATIC_BASE = 16;
+static constexpr std::uint16_t STATIC_END  = 256;
+
+static constexpr std::size_t MAX_NATIVE_ARGS = 4;
+
+// The whole of `s` as a decimal number that fits 16 bits
+static bool
+ParseNumber(const std::string& s, std::uint16_t& value)
+{
+    const char* end = s.data() + s.size();
+    const auto r    = std::from_chars(s.data(), end, value);
+    return r.ec == std::errc{} && r.ptr == end;
+}
+
+VmMachine::VmMachine(Computer& computer)
+  : _computer(computer)
+{
+}
+
+bool
+VmMachine::Load(const std::string& path)
+{
+    namespace fs = std::filesystem;
+
+    _program.clear();
+    _labels.clear();
+    _functions.clear();
+    _statics.clear();
+    _pc    = 0;
+    _steps = 0;
+    _error.clear();
+
+    std::vector<fs::path> files;
+    std::error_code ec;
+    if (fs::is_directory(path, ec)) {
+        for (auto&& entry : fs::directory_iterator(path, ec)) {
+            if (entry.path().extension() == ".vm") {
+                files.push_back(entry.path());
+            }
+        }
+        std::ranges::sort(files);
+    } else {
+        files.push_back(path);
+    }
+
+    if (files.empty()) {
+        std::cerr << "No .vm file in " << path << std::endl;
+        return false;
+    }
+
+    for (auto&& file : files) {
+        if (!ParseFile(file.string())) {
+            return false;
+        }
+    }
+
+    if (!Link()) {
+        return false;
+    }
+
+    const auto init = _functions.find("Sys.init");
+    _pc             = init == _functions.end() ? 0 : init->second;
+    return true;
+}
+
+bool
+VmMachine::ParseFile(const std::string& path)
+{
+    static const std::map<std::string, Op> OPS = {
+        { "push", Op::Push },         { "pop", Op::Pop },           { "add", Op::Add },
+        { "sub", Op::Sub },           { "neg", Op::Neg },           { "eq", Op::Eq },
+        { "gt", Op::Gt },             { "lt", Op::Lt },             { "and", Op::And },
+        { "or", Op::Or },             { "not", Op::Not },           { "label", Op::Label },
+        { "goto", Op::Goto },         { "if-goto", Op::IfGoto },    { "function", Op::Function },
+        { "call", Op::Call },         { "return", Op::Return },
+    };
+    static const std::map<std::string, Segment> SEGMENTS = {
+        { "argument", Segment::Argument }, { "local", Segment::Local },
+        { "static", Segment::Static },     { "constant", Segment::Constant },
+        { "this", Segment::This },         { "that", Segment::That },
+        { "pointer", Segment::Pointer },   { "temp", Segment::Temp },
+    };
+
+    std::ifstream in{ path };
+    if (!in) {
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return false;
+    }
+
+    const std::string file = std::filesystem::path(path).stem().string();
+    std::string function;
+
+    std::string line;
+    for (int nol = 1; std::getline(in, line); nol++) {
+        const auto comment = line.find("//");
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+
+        std::istringstream tokens{ line };
+        std::string cmd, arg1, arg2;
+        if (!(tokens >> cmd)) {
+            continue;
+        }
+        tokens >> arg1 >> arg2;
+
+        const auto op = OPS.find(cmd);
+        bool ok       = op != OPS.end();
+        Inst inst{ .op = ok ? op->second : Op::Return };
+
+        switch (inst.op) {
+            case Op::Push:
+            case Op::Pop: {
+                const auto seg = SEGMENTS.find(arg1);
+                ok             = ok && seg != SEGMENTS.end() && ParseNumber(arg2, inst.arg);
+                if (!ok) {
+                    break;
+                }
+                inst.seg = seg->second;
+                ok       = !(inst.op == Op::Pop && inst.seg == Segment::Constant) &&
+                           !(inst.seg == Segment::Constant && inst.arg > 32767) &&
+                           !(inst.seg == Segment::Pointer && inst.arg > 1) &&
+                           !(inst.seg == Segment::Temp && inst.arg > 7);
+
+                if (ok && inst.seg == Segment::Static) {
+                    const std::string key = file + "." + arg2;
+                    if (!_statics.contains(key)) {
+                        const auto addr = static_cast<std::uint16_t>(STATIC_BASE + _statics.size());
+                        ok              = addr < STATIC_END;
+                        _statics[key]   = addr;
+                    }
+                    inst.arg = _statics[key];
+                }
+                break;
+            }
+            case Op::Label:
+            case Op::Goto:
+            case Op::IfGoto:
+                ok        = ok && !arg1.empty();
+                inst.name = function + "$" + arg1;
+                if (ok && inst.op == Op::Label) {
+                    _labels[inst.name] = _program.size();
+                }
+                break;
+            case Op::Function:
+            case Op::Call:
+                ok        = ok && !arg1.empty() && ParseNumber(arg2, inst.arg);
+                inst.name = arg1;
+                if (ok && inst.op == Op::Function) {
+                    function              = arg1;
+                    _functions[inst.name] = _program.size();
+                }
+                break;
+            case Op::Add:
+            case Op::Sub:
+            case Op::Neg:
+            case Op::Eq:
+            case Op::Gt:
+            case Op::Lt:
+            case Op::And:
+            case Op::Or:
+            case Op::Not:
+            case Op::Return:
+                break;
+        }
+
+        if (!ok) {
+            std::cerr << path << ":" << nol << ": invalid VM command: " << line << std::endl;
+            return false;
+        }
+
+        // a label is not a step of the VM emulator: it names the next command
+        if (inst.op != Op::Label) {
+            _program.push_back(std::move(inst));
+        }
+    }
+
+    return true;
+}
+
+bool
+VmMachine::Link()
+{
+    for (auto&& inst : _program) {
+        if (inst.op == Op::Goto || inst.op == Op::IfGoto) {
+            const auto it = _labels.find(inst.name);
+            if (it == _labels.end()) {
+                std::cerr << "Undefined label: " << inst.name << std::endl;
+                return false;
+            }
+            inst.target = it->second;
+        } else if (inst.op == Op::Call) {
+            const auto it = _functions.find(inst.name);
+            inst.native   = it == _functions.end();
+            inst.target   = inst.native ? NPOS : it->second;
+        }
+    }
+    return true;
+}
+
+std::uint16_t
+VmMachine::Address(Segment seg, std::uint16_t index) const
+{
+    switch (seg) {
+        case Segment::Argument:
+            return _computer.Read(ARG) + index;
+        case Segment::Local:
+            return _computer.Read(LCL) + index;
+        case Segment::This:
+            return _computer.Read(THIS) + index;
+        case Segment::That:
+            return _computer.Read(THAT) + index;
+        case Segment::Pointer:
+            return THIS + index;
+        case Segment::Temp:
+            return TEMP + index;
+        case Segment::Static:
+            return index; // resolved at load
+        case Segment::Constant:
+        case Segment::None:
+            break;
+    }
+    return 0;
+}
+
+void
+VmMachine::Push(std::uint16_t v)
+{
+    const std::uint16_t sp = _computer.Read(SP);
+    _computer.Write(sp, v);
+    _computer.Write(SP, sp + 1);
+}
+
+std::uint16_t
+VmMachine::Pop()
+{
+    const std::uint16_t sp = _computer.Read(SP) - 1;
+    _computer.Write(SP, sp);
+    return _computer.Read(sp);
+}
+
+void
+VmMachine::Call(const Inst& inst)
+{
+    if (inst.native) {
+        std::uint16_t args[MAX_NATIVE_ARGS]{};
+        const std::uint16_t base = _computer.Read(SP) - inst.arg;
+        for (std::size_t i = 0; i < inst.arg && i < MAX_NATIVE_ARGS; i++) {
+            args[i] = _computer.Read(base + i);
+        }
+
+        const auto value = _intrinsics.Call(inst.name, _computer, args, inst.arg);
+        if (!value) {
+            _error = "no built-in for " + inst.name + " " + std::to_string(inst.arg);
+            return;
+        }
+
+        _computer.Write(SP, base);
+        Push(*value);
+        _pc++;
+        return;
+    }
+
+    const std::uint16_t sp = _computer.Read(SP);
+    Push(static_cast<std::uint16_t>(_pc + 1));
+    Push(_computer.Read(LCL));
+    Push(_computer.Read(ARG));
+    Push(_computer.Read(THIS));
+    Push(_computer.Read(THAT));
+    _computer.Write(ARG, sp - inst.arg);
+    _computer.Write(LCL, _computer.Read(SP));
+    _pc = inst.target;
+}
+
+void
+VmMachine::Return()
+{
+    const std::uint16_t frame = _computer.Read(LCL);
+    const std::uint16_t ret   = _computer.Read(frame - 5);
+    const std::uint16_t arg   = _computer.Read(ARG);
+
+    _computer.Write(arg, Pop());
+    _computer.Write(SP, arg + 1);
+    _computer.Write(THAT, _computer.Read(frame - 1));
+    _computer.Write(THIS, _computer.Read(frame - 2));
+    _computer.Write(ARG, _computer.Read(frame - 3));
+    _computer.Write(LCL, _computer.Read(frame - 4));
+    _pc = ret;
+}
+
+void
+VmMachine::Step()
+{
+    if (Halted()) {
+        return;
+    }
+
+    const Inst& inst = _program[_pc];
+    const auto cmp   = [this](auto pred) {
+        const auto y = static_cast<std::int16_t>(Pop());
+        const auto x = static_cast<std::int16_t>(Pop());
+        Push(pred(x, y) ? 0xFFFF : 0);
+    };
+
+    _steps++;
+    switch (inst.op) {
+        case Op::Push:
+            Push(inst.seg == Segment::Constant ? inst.arg : _computer.Read(Address(inst.seg, inst.arg)));
+            break;
+        case Op::Pop: {
+            const std::uint16_t addr = Address(inst.seg, inst.arg);
+            _computer.Write(addr, Pop());
+            break;
+        }
+        case Op::Add: {
+            const std::uint16_t y = Pop();
+            Push(Pop() + y);
+            break;
+        }
+        case Op::Sub: {
+            const std::uint16_t y = Pop();
+            Push(Pop() - y);
+            break;
+        }
+        case Op::Neg:
+            Push(-Pop());
+            break;
+        case Op::Eq:
+            cmp([](std::int16_t x, std::int16_t y) { return x == y; });
+            break;
+        case Op::Gt:
+            cmp([](std::int16_t x, std::int16_t y) { return x > y; });
+            break;
+        case Op::Lt:
+            cmp([](std::int16_t x, std::int16_t y) { return x < y; });
+            break;
+        case Op::And: {
+            const std::uint16_t y = Pop();
+            Push(Pop() & y);
+            break;
+        }
+        case Op::Or: {
+            const std::uint16_t y = Pop();
+            Push(Pop() | y);
+            break;
+        }
+        case Op::Not:
+            Push(~Pop());
+            break;
+        case Op::Label:
+            break; // never loaded
+        case Op::Goto:
+            _pc = inst.target;
+            return;
+        case Op::IfGoto:
+            if (Pop() != 0) {
+                _pc = inst.target;
+                return;
+            }
+            break;
+        case Op::Function:
+            for (std::uint16_t i = 0; i < inst.arg; i++) {
+                Push(0);
+            }
+            break;
+        case Op::Call:
+            Call(inst);
+            return;
+        case Op::Return:
+            Return();
+            return;
+    }
+
+    _pc++;
+}
+
+std::uint64_t
+VmMachine::Run(std::uint64_t steps)
+{
+    const std::uint64_t start = _steps;
+    while (_steps - start < steps && !Halted()) {
+        Step();
+    }
+    return _steps - start;
+}
+
+} // namespace Emu
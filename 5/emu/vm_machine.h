@@ -0,0 +1,115 @@
+#ifndef EMU_VM_MACHINE_HH
+#define EMU_VM_MACHINE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "computer.h"
+#include "intrinsics.h"
+
+namespace Emu {
+
+// Runs VM commands directly on the RAM of a Computer, one command per step,
+// like the course's VM emulator. Memory layout is the standard mapping
+// (SP, LCL, ARG, THIS, THAT, temp at 5, statics from 16), so the RAM seen by
+// a .tst script matches the one of the translated program.
+//
+// Labels are not commands of their own (they name the next command), which
+// keeps the step counts of the course's VME scripts.
+// Calls to functions that are not loaded go to the native Intrinsics, the
+// way the VM emulator falls back to its built-in OS.
+class VmMachine
+{
+  public:
+    explicit VmMachine(Computer& computer);
+
+    // A .vm file, or every .vm file of a directory (in name order).
+    // Execution starts at Sys.init when present, at the first command otherwise.
+    bool Load(const std::string& path);
+
+    // Executes one VM command
+    void Step();
+
+    // Runs at most `steps` commands. Returns the number of executed commands.
+    std::uint64_t Run(std::uint64_t steps);
+
+    // Past the last command, or stopped on a runtime error
+    bool Halted() const { return _pc >= _program.size() || !_error.empty(); }
+    const std::string& Error() const { return _error; }
+
+    std::uint64_t Steps() const { return _steps; }
+
+  private:
+    enum class Op
+    {
+        Push,
+        Pop,
+        Add,
+        Sub,
+        Neg,
+        Eq,
+        Gt,
+        Lt,
+        And,
+        Or,
+        Not,
+        Label,
+        Goto,
+        IfGoto,
+        Function,
+        Call,
+        Return
+    };
+
+    enum class Segment
+    {
+        None,
+        Argument,
+        Local,
+        Static,
+        Constant,
+        This,
+        That,
+        Pointer,
+        Temp
+    };
+
+    struct Inst
+    {
+        Op op;
+        Segment seg{ Segment::None };
+        std::uint16_t arg{ 0 };    // index, static address, n_vars or n_args
+        std::size_t target{ 0 };   // goto/call destination
+        bool native{ false };      // call to an Intrinsics function
+        std::string name{};        // label or function name
+    };
+
+    static constexpr std::size_t NPOS = static_cast<std::size_t>(-1);
+
+    bool ParseFile(const std::string& path);
+    bool Link();
+
+    std::uint16_t Address(Segment seg, std::uint16_t index) const;
+    void Push(std::uint16_t v);
+    std::uint16_t Pop();
+    void Call(const Inst& inst);
+    void Return();
+
+    Computer& _computer;
+    Intrinsics _intrinsics;
+
+    std::vector<Inst> _program;
+    std::map<std::string, std::size_t> _labels;    // "function$label" -> index
+    std::map<std::string, std::size_t> _functions; // name -> index
+    std::map<std::string, std::uint16_t> _statics; // "File.i" -> address
+    std::size_t _pc{ 0 };
+    std::uint64_t _steps{ 0 };
+    std::string _error;
+};
+
+} // namespace Emu
+
+#endif
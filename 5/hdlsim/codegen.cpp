@@ -0,0 +1,231 @@
+#include "codegen.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace Hdl {
+
+// Nets that outlive Eval(): everything Run() and the accessors read or
+// write. The other nets become locals of Eval(), which the compiler keeps
+// in registers and simplifies further.
+static std::vector<bool>
+Persistent(const Netlist& netlist)
+{
+    std::vector<bool> keep(netlist.NetCount(), false);
+    const auto mark = [&keep](const std::vector<Net>& bits) {
+        for (const Net n : bits) {
+            keep[n] = true;
+        }
+    };
+
+    for (auto&& bus : netlist.inputs) {
+        mark(bus.bits);
+    }
+    for (auto&& bus : netlist.outputs) {
+        mark(bus.bits);
+    }
+    for (auto&& [chip, bits] : netlist.probes) {
+        mark(bits);
+    }
+    for (auto&& d : netlist.dffs) {
+        keep[d.in] = keep[d.out] = true;
+    }
+    for (auto&& m : netlist.memories) {
+        if (!m.in.empty()) {
+            mark(m.address);
+            mark(m.in);
+            keep[m.load] = true;
+        }
+    }
+    return keep;
+}
+
+// The C++ expression of a net: a constant, v[n] when persistent, else local nN
+static std::string
+Ref(Net n, const std::vector<bool>& keep)
+{
+    if (n <= NET_TRUE) {
+        return n == NET_TRUE ? "1u" : "0u";
+    }
+    return keep[n] ? "v[" + std::to_string(n) + "]" : "n" + std::to_string(n);
+}
+
+// n0 | n1 << 1 | ...
+static std::string
+Gather(const std::vector<Net>& bits, const std::vector<bool>& keep)
+{
+    if (bits.empty()) {
+        return "0u";
+    }
+    std::string s;
+    for (std::size_t i = 0; i < bits.size(); i++) {
+        s += (i ? " | " : "") + std::string("std::uint64_t{ ") + Ref(bits[i], keep) + " }";
+        if (i) {
+            s += " << " + std::to_string(i);
+        }
+    }
+    return s;
+}
+
+// Nets that some persistent net depends on, walking the order backwards.
+// Gates outside this set are not emitted.
+static std::vector<bool>
+Live(const Netlist& netlist, const std::vector<bool>& keep)
+{
+    std::vector<bool> live = keep;
+    for (auto it = netlist.order.rbegin(); it != netlist.order.rend(); ++it) {
+        if (it->kind == Netlist::Node::Kind::Nand) {
+            const NandGate& g = netlist.nands[it->index];
+            if (live[g.out]) {
+                live[g.a] = live[g.b] = true;
+            }
+            continue;
+        }
+        const MemoryBlock& m = netlist.memories[it->index];
+        if (std::ranges::any_of(m.out, [&live](Net n) { return live[n]; })) {
+            for (const Net a : m.address) {
+                live[a] = true;
+            }
+        }
+    }
+    return live;
+}
+
+// Assigns bit i of `word` to bits[i], declaring the locals. Dead bits are skipped.
+static void
+Scatter(const std::vector<Net>& bits, const std::string& word, const std::vector<bool>& keep,
+        const char* indent, std::ostream& out, const std::vector<bool>* live = nullptr)
+{
+    for (std::size_t i = 0; i < bits.size(); i++) {
+        if (live && !(*live)[bits[i]]) {
+            continue;
+        }
+        out << indent << (keep[bits[i]] ? "" : "const unsigned ") << Ref(bits[i], keep) << " = ("
+            << word << " >> " << i << ") & 1;\n";
+    }
+}
+
+// `if (key == "name") return <gather>;` for every bus
+static void
+EmitLookup(const std::vector<std::pair<std::string, const std::vector<Net>*>>& buses,
+           const std::vector<bool>& keep, std::ostream& out)
+{
+    for (auto&& [name, bits] : buses) {
+        out << "        if (key == \"" << name << "\") {\n";
+        out << "            return " << Gather(*bits, keep) << ";\n";
+        out << "        }\n";
+    }
+    out << "        return 0;\n";
+}
+
+void
+EmitCpp(const Netlist& netlist, const std::string& name, std::ostream& out)
+{
+    const std::string cls        = name + "Chip";
+    const std::vector<bool> keep = Persistent(netlist);
+    const std::vector<bool> live = Live(netlist, keep);
+
+    out << "// Generated by hdlsim --emit-cpp from " << name << ".hdl: " << netlist.nands.size()
+        << " nands, " << netlist.dffs.size() << " dffs, " << netlist.memories.size()
+        << " memories. Do not edit.\n";
+    out << "#include <cstdint>\n#include <memory>\n#include <string_view>\n\n";
+    out << "#include \"compiled.h\"\n\n";
+    out << "namespace {\n\n";
+    out << "class " << cls << " final : public Hdl::CompiledChip\n{\n  public:\n";
+    out << "    " << cls << "() { Eval(); }\n\n";
+
+    out << "    bool SetInput([[maybe_unused]] std::string_view key,\n"
+           "                  [[maybe_unused]] std::uint64_t x) override\n    {\n";
+    for (auto&& bus : netlist.inputs) {
+        out << "        if (key == \"" << bus.name << "\") {\n";
+        Scatter(bus.bits, "x", keep, "            ", out);
+        out << "            return true;\n        }\n";
+    }
+    out << "        return false;\n    }\n\n";
+
+    std::vector<std::pair<std::string, const std::vector<Net>*>> outputs, probes;
+    for (auto&& bus : netlist.outputs) {
+        outputs.emplace_back(bus.name, &bus.bits);
+    }
+    for (auto&& [chip, bits] : netlist.probes) {
+        probes.emplace_back(chip, &bits);
+    }
+    out << "    std::uint64_t Output([[maybe_unused]] std::string_view key) const override\n    {\n";
+    EmitLookup(outputs, keep, out);
+    out << "    }\n\n";
+    out << "    std::uint64_t Probe([[maybe_unused]] std::string_view key) const override\n    {\n";
+    EmitLookup(probes, keep, out);
+    out << "    }\n\n";
+
+    out << "    std::uint16_t* Memory([[maybe_unused]] std::string_view key) override\n    {\n";
+    for (std::size_t m = 0; m < netlist.memories.size(); m++) {
+        out << "        if (key == \"" << netlist.memories[m].chip << "\") {\n";
+        out << "            return m" << m << ";\n        }\n";
+    }
+    out << "        return nullptr;\n    }\n\n";
+
+    // combinational logic in levelized order
+    out << "    void Eval() override\n    {\n";
+    for (const Netlist::Node& node : netlist.order) {
+        if (node.kind == Netlist::Node::Kind::Nand) {
+            const NandGate& g = netlist.nands[node.index];
+            if (!live[g.out]) {
+                continue;
+            }
+            out << "        " << (keep[g.out] ? "" : "const unsigned ") << Ref(g.out, keep) << " = 1 ^ ("
+                << Ref(g.a, keep) << " & " << Ref(g.b, keep) << ");\n";
+            continue;
+        }
+        const MemoryBlock& m = netlist.memories[node.index];
+        const std::string w  = "w" + std::to_string(node.index);
+        if (std::ranges::none_of(m.out, [&live](Net n) { return live[n]; })) {
+            continue;
+        }
+        out << "        const unsigned " << w << " = m" << node.index << "[(" << Gather(m.address, keep)
+            << ") % " << m.size << "];\n";
+        Scatter(m.out, w, keep, "        ", out, &live);
+    }
+    out << "    }\n\n";
+
+    // tick: sample DFF inputs and write memories; tock: commit, propagate
+    out << "    void Run(std::uint64_t cycles) override\n    {\n";
+    out << "        Eval();\n";
+    out << "        for (; cycles > 0; cycles--) {\n";
+    if (!netlist.dffs.empty()) {
+        out << "            std::uint8_t q[" << netlist.dffs.size() << "];\n";
+        for (std::size_t i = 0; i < netlist.dffs.size(); i++) {
+            out << "            q[" << i << "] = " << Ref(netlist.dffs[i].in, keep) << ";\n";
+        }
+    }
+    for (std::size_t m = 0; m < netlist.memories.size(); m++) {
+        const MemoryBlock& mem = netlist.memories[m];
+        if (mem.in.empty()) {
+            continue;
+        }
+        out << "            if (" << Ref(mem.load, keep) << ") {\n";
+        out << "                m" << m << "[(" << Gather(mem.address, keep) << ") % " << mem.size
+            << "] = static_cast<std::uint16_t>(" << Gather(mem.in, keep) << ");\n";
+        out << "            }\n";
+    }
+    for (std::size_t i = 0; i < netlist.dffs.size(); i++) {
+        out << "            " << Ref(netlist.dffs[i].out, keep) << " = q[" << i << "];\n";
+    }
+    out << "            Eval();\n";
+    out << "        }\n    }\n\n";
+
+    out << "  private:\n";
+    out << "    std::uint8_t v[" << netlist.NetCount() << "]{};\n";
+    for (std::size_t m = 0; m < netlist.memories.size(); m++) {
+        out << "    std::uint16_t m" << m << "[" << netlist.memories[m].size << "]{}; // "
+            << netlist.memories[m].chip << "\n";
+    }
+    out << "};\n\n";
+    out << "} // namespace\n\n";
+
+    out << "namespace Hdl {\n\n";
+    out << "std::unique_ptr<CompiledChip>\nCreate" << name << "()\n{\n";
+    out << "    return std::make_unique<" << cls << ">();\n}\n\n";
+    out << "} // namespace Hdl\n";
+}
+
+} // namespace Hdl
@@ -0,0 +1,23 @@
+#ifndef HDL_CODEGEN_HH
+#define HDL_CODEGEN_HH
+
+#include <ostream>
+#include <string>
+
+#include "netlist.h"
+
+namespace Hdl {
+
+// Writes a C++ translation unit that simulates `netlist` as straight-line
+// code: one statement per Nand in levelized order, DFF state and memories
+// in plain arrays. The unit defines
+//
+//     std::unique_ptr<Hdl::CompiledChip> Hdl::Create<name>();
+//
+// implementing the interface of compiled.h.
+void
+EmitCpp(const Netlist& netlist, const std::string& name, std::ostream& out);
+
+} // namespace Hdl
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef HDL_COMPILED_HH
+#define HDL_COMPILED_HH
+
+#include <cstdint>
+#include <string_view>
+
+namespace Hdl {
+
+// A chip translated to C++ by EmitCpp (`hdlsim --emit-cpp`) and compiled
+// into the program. One instance simulates one copy of the chip.
+class CompiledChip
+{
+  public:
+    virtual ~CompiledChip() = default;
+
+    // Pins of the top chip; SetInput takes effect at the next Eval or Run
+    virtual bool SetInput(std::string_view pin, std::uint64_t v) = 0;
+    virtual std::uint64_t Output(std::string_view pin) const = 0;
+
+    // `Chip[]`: output of the first instance of a part (PC, ARegister, ...)
+    virtual std::uint64_t Probe(std::string_view chip) const = 0;
+
+    // Contents of the first built-in memory of that name, or nullptr
+    virtual std::uint16_t* Memory(std::string_view chip) = 0;
+
+    virtual void Eval() = 0;
+
+    // Full clock cycles (tick and tock)
+    virtual void Run(std::uint64_t cycles) = 0;
+};
+
+} // namespace Hdl
+
+#endif
@@ -0,0 +1,263 @@
+#include "hdl.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace Hdl {
+
+const Pin*
+ChipDef::FindInput(const std::string& pin) const
+{
+    for (auto&& p : inputs) {
+        if (p.name == pin) {
+            return &p;
+        }
+    }
+    return nullptr;
+}
+
+const Pin*
+ChipDef::FindOutput(const std::string& pin) const
+{
+    for (auto&& p : outputs) {
+        if (p.name == pin) {
+            return &p;
+        }
+    }
+    return nullptr;
+}
+
+struct Token
+{
+    std::string text;
+    int line;
+};
+
+static std::vector<Token>
+Tokenize(const std::string& text)
+{
+    std::vector<Token> tokens;
+    int line = 1;
+
+    for (std::size_t i = 0; i < text.size(); i++) {
+        const char c = text[i];
+        if (c == '\n') {
+            line++;
+        } else if (std::isspace(static_cast<unsigned char>(c))) {
+            continue;
+        } else if (c == '/' && i + 1 < text.size() && text[i + 1] == '/') {
+            i = text.find('\n', i);
+            if (i == std::string::npos) {
+                break;
+            }
+            line++;
+        } else if (c == '/' && i + 1 < text.size() && text[i + 1] == '*') {
+            const auto end = text.find("*/", i + 2);
+            const auto stop = end == std::string::npos ? text.size() : end + 2;
+            for (std::size_t k = i; k < stop; k++) {
+                line += text[k] == '\n';
+            }
+            i = stop - 1;
+        } else if (c == '.' && i + 1 < text.size() && text[i + 1] == '.') {
+            tokens.push_back({ "..", line });
+            i++;
+        } else if (std::isalnum(static_cast<unsigned char>(c)) || c == '_') {
+            std::size_t k = i;
+            while (k < text.size() && (std::isalnum(static_cast<unsigned char>(text[k])) || text[k] == '_')) {
+                k++;
+            }
+            tokens.push_back({ text.substr(i, k - i), line });
+            i = k - 1;
+        } else {
+            tokens.push_back({ std::string(1, c), line });
+        }
+    }
+    return tokens;
+}
+
+class HdlParser
+{
+  public:
+    explicit HdlParser(const std::string& text)
+      : _tokens(Tokenize(text))
+    {
+    }
+
+    bool Parse(ChipDef& chip);
+    const std::string& Error() const { return _error; }
+
+  private:
+    const std::string& Peek() const
+    {
+        static const std::string END;
+        return _pos < _tokens.size() ? _tokens[_pos].text : END;
+    }
+    bool Accept(const std::string& s)
+    {
+        if (Peek() != s) {
+            return false;
+        }
+        _pos++;
+        return true;
+    }
+    bool Expect(const std::string& s)
+    {
+        return Accept(s) || Fail("expected '" + s + "'");
+    }
+    bool Fail(const std::string& what)
+    {
+        const int line = _tokens.empty() ? 0 : _tokens[std::min(_pos, _tokens.size() - 1)].line;
+        _error         = "line " + std::to_string(line) + ": " + what + " near '" + Peek() + "'";
+        return false;
+    }
+    bool Name(std::string& name)
+    {
+        const std::string& t = Peek();
+        if (t.empty() || !(std::isalpha(static_cast<unsigned char>(t[0])) || t[0] == '_')) {
+            return Fail("expected a name");
+        }
+        name = t;
+        _pos++;
+        return true;
+    }
+    bool Number(int& v)
+    {
+        const std::string& t = Peek();
+        if (t.empty() || t.find_first_not_of("0123456789") != std::string::npos) {
+            return Fail("expected a number");
+        }
+        v = std::stoi(t);
+        _pos++;
+        return true;
+    }
+
+    bool Pins(std::vector<Pin>& pins);
+    bool Ref(PinRef& ref);
+    bool PartDef(Part& part);
+
+    std::vector<Token> _tokens;
+    std::size_t _pos{ 0 };
+    std::string _error;
+};
+
+bool
+HdlParser::Pins(std::vector<Pin>& pins)
+{
+    do {
+        Pin pin;
+        if (!Name(pin.name)) {
+            return false;
+        }
+        if (Accept("[")) {
+            if (!Number(pin.width) || !Expect("]")) {
+                return false;
+            }
+        }
+        pins.push_back(pin);
+    } while (Accept(","));
+    return Expect(";");
+}
+
+bool
+HdlParser::Ref(PinRef& ref)
+{
+    if (!Name(ref.name)) {
+        return false;
+    }
+    if (!Accept("[")) {
+        return true;
+    }
+    if (!Number(ref.lo)) {
+        return false;
+    }
+    ref.hi = ref.lo;
+    if (Accept("..") && !Number(ref.hi)) {
+        return false;
+    }
+    if (ref.hi < ref.lo) {
+        return Fail("reversed sub-bus");
+    }
+    return Expect("]");
+}
+
+bool
+HdlParser::PartDef(Part& part)
+{
+    part.line = _tokens[_pos].line;
+    if (!Name(part.chip) || !Expect("(")) {
+        return false;
+    }
+
+    do {
+        Connection c;
+        if (!Ref(c.inner) || !Expect("=") || !Ref(c.outer)) {
+            return false;
+        }
+        part.connections.push_back(c);
+    } while (Accept(","));
+
+    return Expect(")") && Expect(";");
+}
+
+bool
+HdlParser::Parse(ChipDef& chip)
+{
+    if (!Expect("CHIP") || !Name(chip.name) || !Expect("{")) {
+        return false;
+    }
+
+    while (Peek() != "PARTS" && Peek() != "BUILTIN" && Peek() != "}") {
+        if (Accept("IN")) {
+            if (!Pins(chip.inputs)) {
+                return false;
+            }
+        } else if (Accept("OUT")) {
+            if (!Pins(chip.outputs)) {
+                return false;
+            }
+        } else {
+            return Fail("expected IN, OUT or PARTS");
+        }
+    }
+
+    if (Accept("BUILTIN")) {
+        std::string name;
+        chip.builtin = true;
+        if (!Name(name) || !Expect(";")) {
+            return false;
+        }
+        // CLOCKED lists the clocked inputs of a built-in; the simulator knows them
+        if (Accept("CLOCKED")) {
+            std::vector<Pin> clocked;
+            if (!Pins(clocked)) {
+                return false;
+            }
+        }
+    } else if (Accept("PARTS")) {
+        if (!Expect(":")) {
+            return false;
+        }
+        while (Peek() != "}" && !Peek().empty()) {
+            Part part;
+            if (!PartDef(part)) {
+                return false;
+            }
+            chip.parts.push_back(std::move(part));
+        }
+    }
+
+    return Expect("}");
+}
+
+bool
+ParseHdl(const std::string& text, ChipDef& chip, std::string& error)
+{
+    HdlParser parser{ text };
+    if (!parser.Parse(chip)) {
+        error = parser.Error();
+        return false;
+    }
+    return true;
+}
+
+} // namespace Hdl
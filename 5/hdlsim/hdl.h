@@ -0,0 +1,59 @@
+#ifndef HDL_HDL_HH
+#define HDL_HDL_HH
+
+#include <string>
+#include <vector>
+
+namespace Hdl {
+
+struct Pin
+{
+    std::string name;
+    int width{ 1 };
+};
+
+// `name`, `name[i]` or `name[lo..hi]`. lo = hi = -1 means the whole bus.
+struct PinRef
+{
+    std::string name;
+    int lo{ -1 };
+    int hi{ -1 };
+
+    bool Whole() const { return lo < 0; }
+};
+
+// inner=outer in a part: inner is a pin of the part, outer a signal of the
+// enclosing chip (a pin, an internal wire, `true` or `false`)
+struct Connection
+{
+    PinRef inner;
+    PinRef outer;
+};
+
+struct Part
+{
+    std::string chip;
+    std::vector<Connection> connections;
+    int line{ 0 };
+};
+
+struct ChipDef
+{
+    std::string name;
+    std::vector<Pin> inputs;
+    std::vector<Pin> outputs;
+    std::vector<Part> parts;
+    bool builtin{ false }; // `BUILTIN Name;` instead of PARTS
+    std::string path;
+
+    const Pin* FindInput(const std::string& pin) const;
+    const Pin* FindOutput(const std::string& pin) const;
+};
+
+// Parses one CHIP definition. On failure `error` has the line and reason.
+bool
+ParseHdl(const std::string& text, ChipDef& chip, std::string& error);
+
+} // namespace Hdl
+
+#endif
@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "../emu/computer.h"
+#include "../emu/loader.h"
+#include "compiled.h"
+
+namespace Hdl {
+
+// 5/Computer.hdl, generated at build time
+std::unique_ptr<CompiledChip>
+CreateComputer();
+
+} // namespace Hdl
+
+static void
+Usage()
+{
+    std::cout << "Usage: hdlcomputer <in.hack|in.asm> [options]\n";
+    std::cout << "  runs a program on the gate-level Computer of 5/Computer.hdl\n";
+    std::cout << "  --cycles N       : clock cycles to run (default 10000000)\n";
+    std::cout << "  --check N        : run hackemu's Computer alongside and compare\n";
+    std::cout << "                     PC, A, D and RAM every N cycles\n";
+}
+
+struct Options
+{
+    std::string program;
+    std::uint64_t cycles{ 10000000 };
+    std::uint64_t check{ 0 };
+};
+
+static bool
+ParseArgs(int argc, char const* argv[], Options& opt)
+{
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--cycles" && i + 1 < argc) {
+            opt.cycles = std::stoull(argv[++i]);
+        } else if (arg == "--check" && i + 1 < argc) {
+            opt.check = std::stoull(argv[++i]);
+        } else if (!arg.empty() && arg.front() != '-' && opt.program.empty()) {
+            opt.program = arg;
+        } else {
+            return false;
+        }
+    }
+    return !opt.program.empty();
+}
+
+// Compares the gate-level machine with the emulator. Prints the first difference.
+static bool
+Matches(Hdl::CompiledChip& chip, const Emu::Computer& emu)
+{
+    const std::uint64_t pc = chip.Probe("PC") & 0x7FFF;
+    const std::uint64_t a  = chip.Probe("ARegister");
+    const std::uint64_t d  = chip.Probe("DRegister");
+    if (pc != emu.PC() || a != emu.A() || d != emu.D()) {
+        std::cout << "registers differ: PC " << pc << "/" << emu.PC() << " A " << a << "/" << emu.A()
+                  << " D " << d << "/" << emu.D() << "\n";
+        return false;
+    }
+
+    const std::uint16_t* ram    = chip.Memory("RAM16K");
+    const std::uint16_t* screen = chip.Memory("Screen");
+    for (std::size_t addr = 0; addr < Emu::Computer::KBD; addr++) {
+        const std::uint16_t v = addr < Emu::Computer::SCREEN ? ram[addr] : screen[addr - Emu::Computer::SCREEN];
+        if (v != emu.Read(static_cast<std::uint16_t>(addr))) {
+            std::cout << "RAM[" << addr << "] differs: " << v << "/" << emu.Read(static_cast<std::uint16_t>(addr))
+                      << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+int
+main(int argc, char const* argv[])
+{
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        Usage();
+        return -1;
+    }
+
+    // the loader also assembles .asm input
+    Emu::Computer emu;
+    Emu::Labels labels;
+    if (!Emu::LoadProgram(emu, opt.program, labels)) {
+        std::cerr << "cannot load " << opt.program << "\n";
+        return -1;
+    }
+
+    auto chip = Hdl::CreateComputer();
+    std::copy(emu.Rom(), emu.Rom() + Emu::Computer::ROM_SIZE, chip->Memory("ROM32K"));
+    chip->SetInput("reset", 0);
+
+    const auto start     = std::chrono::steady_clock::now();
+    std::uint64_t cycles = 0;
+    while (cycles < opt.cycles) {
+        const std::uint64_t n = opt.check ? std::min(opt.check, opt.cycles - cycles) : opt.cycles;
+        chip->Run(n);
+        cycles += n;
+
+        if (opt.check) {
+            for (std::uint64_t i = 0; i < n; i++) {
+                emu.Step();
+            }
+            if (!Matches(*chip, emu)) {
+                std::cout << "mismatch after " << cycles << " cycles\n";
+                return 1;
+            }
+        }
+    }
+    const double ms =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "cycles: " << cycles << " in " << ms << " ms ("
+              << (ms > 0 ? cycles / ms / 1000.0 : 0) << " M cycles/s)\n";
+    if (opt.check) {
+        std::cout << "matched the emulator every " << opt.check << " cycles\n";
+    }
+    std::cout << "PC: " << (chip->Probe("PC") & 0x7FFF) << " A: " << chip->Probe("ARegister")
+              << " D: " << chip->Probe("DRegister") << "\n";
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "codegen.h"
+#include "netlist.h"
+#include "optimizer.h"
+#include "test_script.h"
+
+static void
+Usage()
+{
+    std::cout << "Usage: hdlsim [-L dir]... [-O] <script.tst>...\n";
+    std::cout << "       hdlsim [-L dir]... [-O] --emit-cpp <Chip.hdl> <out.cpp>\n";
+    std::cout << "  runs hardware simulator test scripts against their .cmp files\n";
+    std::cout << "  -L dir           : look for parts in dir after the built-ins (repeatable)\n";
+    std::cout << "  -O               : optimize the netlist, simulate RAM parts as memories\n";
+    std::cout << "  --emit-cpp       : translate the chip to C++ (see compiled.h)\n";
+}
+
+static int
+EmitCpp(const std::string& hdl, const std::string& path, const std::vector<std::string>& paths,
+        bool optimize)
+{
+    namespace fs = std::filesystem;
+
+    Hdl::Library library;
+    library.SetTopDir(fs::path(hdl).parent_path().string());
+    for (auto&& p : paths) {
+        library.AddPath(p);
+    }
+
+    const std::string name = fs::path(hdl).stem().string();
+    Hdl::Netlist netlist;
+    std::string error;
+    Hdl::MemoryRecognizer memories{ library };
+    if (!Hdl::Flatten(library, name, netlist, error, optimize ? memories.Options() : Hdl::FlattenOptions{})) {
+        std::cerr << hdl << ": " << error << "\n";
+        return -1;
+    }
+    if (optimize) {
+        const Hdl::OptimizeStats s = Hdl::Optimize(netlist);
+        std::cout << name << ": " << s.nands_before << " -> " << s.nands_after << " nands ("
+                  << s.constants << " constant, " << s.inversions << " double inversions, " << s.merged
+                  << " merged, " << s.dead << " dead), " << netlist.memories.size() << " memories\n";
+    }
+
+    std::ofstream out{ path };
+    Hdl::EmitCpp(netlist, name, out);
+    if (!out) {
+        std::cerr << "cannot write " << path << "\n";
+        return -1;
+    }
+    return 0;
+}
+
+int
+main(int argc, char const* argv[])
+{
+    std::vector<std::string> scripts;
+    std::vector<std::string> paths;
+    std::string emit_hdl, emit_out;
+    bool optimize = false;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "-L" && i + 1 < argc) {
+            paths.push_back(argv[++i]);
+        } else if (arg == "-O") {
+            optimize = true;
+        } else if (arg == "--emit-cpp" && i + 2 < argc) {
+            emit_hdl = argv[++i];
+            emit_out = argv[++i];
+        } else if (!arg.empty() && arg.front() != '-') {
+            scripts.push_back(arg);
+        } else {
+            Usage();
+            return -1;
+        }
+    }
+    if (!emit_hdl.empty()) {
+        if (!scripts.empty()) {
+            Usage();
+            return -1;
+        }
+        return EmitCpp(emit_hdl, emit_out, paths, optimize);
+    }
+    if (scripts.empty()) {
+        Usage();
+        return -1;
+    }
+
+    std::size_t failed = 0;
+    for (auto&& script : scripts) {
+        const Hdl::ScriptResult r = Hdl::RunTestScript(script, paths, optimize);
+
+        const double per_eval = r.evals ? static_cast<double>(r.nodes) / r.evals : 0;
+        std::printf("%s %7zu nands %5zu dffs %9.1f nodes/eval %8.2f ms %4zu lines  %s\n",
+                    r.passed ? "PASS" : "FAIL", r.nands, r.dffs, per_eval, r.ms, r.compared, script.c_str());
+        if (!r.passed) {
+            std::printf("     %s\n", r.error.c_str());
+            failed++;
+        }
+    }
+    std::printf("%zu/%zu passed\n", scripts.size() - failed, scripts.size());
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,115 @@
+#include "library.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace Hdl {
+
+// interfaces of the built-in chips
+static const char* BUILTINS[] = {
+    "CHIP Nand { IN a, b; OUT out; BUILTIN Nand; }",
+    "CHIP DFF { IN in; OUT out; BUILTIN DFF; }",
+    "CHIP ARegister { IN in[16], load; OUT out[16]; BUILTIN ARegister; }",
+    "CHIP DRegister { IN in[16], load; OUT out[16]; BUILTIN DRegister; }",
+    "CHIP RAM8 { IN in[16], load, address[3]; OUT out[16]; BUILTIN RAM8; }",
+    "CHIP RAM64 { IN in[16], load, address[6]; OUT out[16]; BUILTIN RAM64; }",
+    "CHIP RAM512 { IN in[16], load, address[9]; OUT out[16]; BUILTIN RAM512; }",
+    "CHIP RAM4K { IN in[16], load, address[12]; OUT out[16]; BUILTIN RAM4K; }",
+    "CHIP RAM16K { IN in[16], load, address[14]; OUT out[16]; BUILTIN RAM16K; }",
+    "CHIP ROM32K { IN address[15]; OUT out[16]; BUILTIN ROM32K; }",
+    "CHIP Screen { IN in[16], load, address[13]; OUT out[16]; BUILTIN Screen; }",
+    "CHIP Keyboard { OUT out[16]; BUILTIN Keyboard; }",
+};
+
+Library::Library()
+{
+    for (const char* text : BUILTINS) {
+        auto chip = std::make_unique<ChipDef>();
+        std::string error;
+        ParseHdl(text, *chip, error);
+        _chips["#" + chip->name] = std::move(chip);
+    }
+}
+
+bool
+Library::IsBuiltin(const std::string& name)
+{
+    const std::string prefix = "CHIP " + name + " ";
+    for (const char* text : BUILTINS) {
+        if (std::string(text).starts_with(prefix)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const ChipDef*
+Library::Load(const std::string& path)
+{
+    const auto it = _chips.find(path);
+    if (it != _chips.end()) {
+        return it->second.get();
+    }
+
+    std::ifstream in{ path };
+    if (!in) {
+        return nullptr;
+    }
+    std::stringstream ss;
+    ss << in.rdbuf();
+
+    auto chip  = std::make_unique<ChipDef>();
+    chip->path = path;
+    if (!ParseHdl(ss.str(), *chip, _error)) {
+        _error = path + ": " + _error;
+        return nullptr;
+    }
+
+    const ChipDef* def = chip.get();
+    _chips[path]       = std::move(chip);
+    return def;
+}
+
+const ChipDef*
+Library::Find(const std::string& name)
+{
+    _error.clear();
+
+    if (const auto found = _found.find(name); found != _found.end()) {
+        return found->second;
+    }
+    const ChipDef* chip = Lookup(name);
+    if (chip) {
+        _found[name] = chip;
+    }
+    return chip;
+}
+
+const ChipDef*
+Library::Lookup(const std::string& name)
+{
+    namespace fs = std::filesystem;
+
+    const auto file = name + ".hdl";
+    std::error_code ec;
+    if (fs::exists(fs::path(_top_dir) / file, ec)) {
+        return Load((fs::path(_top_dir) / file).string());
+    }
+
+    const auto builtin = _chips.find("#" + name);
+    if (builtin != _chips.end()) {
+        return builtin->second.get();
+    }
+
+    for (auto&& dir : _paths) {
+        if (fs::exists(fs::path(dir) / file, ec)) {
+            return Load((fs::path(dir) / file).string());
+        }
+    }
+
+    _error = "chip " + name + " not found";
+    return nullptr;
+}
+
+} // namespace Hdl
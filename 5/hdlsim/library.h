@@ -0,0 +1,55 @@
+#ifndef HDL_LIBRARY_HH
+#define HDL_LIBRARY_HH
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "hdl.h"
+
+namespace Hdl {
+
+// Finds chip definitions by name, in the order the hardware simulator does:
+//   1. <name>.hdl next to the top chip
+//   2. the simulator's built-ins: Nand and DFF, and the behavioural
+//      ARegister, DRegister, RAM8 ... RAM16K, ROM32K, Screen and Keyboard
+//   3. <name>.hdl in every directory given to AddPath (e.g. 1/, 2/, 3/a/),
+//      standing in for the built-in gates the Java tool has
+class Library
+{
+  public:
+    Library();
+
+    void SetTopDir(const std::string& dir)
+    {
+        _top_dir = dir;
+        _found.clear();
+    }
+    void AddPath(const std::string& dir)
+    {
+        _paths.push_back(dir);
+        _found.clear();
+    }
+
+    // nullptr when not found or not parsable (see Error())
+    const ChipDef* Find(const std::string& name);
+
+    const std::string& Error() const { return _error; }
+
+    static bool IsBuiltin(const std::string& name);
+
+  private:
+    const ChipDef* Load(const std::string& path);
+    const ChipDef* Lookup(const std::string& name);
+
+    std::string _top_dir;
+    std::vector<std::string> _paths;
+    std::map<std::string, std::unique_ptr<ChipDef>> _chips;
+    std::map<std::string, const ChipDef*> _found; // name -> chip, saves the file lookups
+    std::string _error;
+};
+
+} // namespace Hdl
+
+#endif
@@ -0,0 +1,466 @@
+#include "netlist.h"
+
+#include <algorithm>
+#include <deque>
+
+namespace Hdl {
+
+static constexpr int MAX_DEPTH = 64;
+
+using Signals = std::map<std::string, std::vector<Net>>;
+
+// memory built-ins: chip -> words
+static const std::map<std::string, std::size_t> MEMORY_SIZES = {
+    { "RAM8", 8 },         { "RAM64", 64 },        { "RAM512", 512 },   { "RAM4K", 4096 },
+    { "RAM16K", 16384 },   { "ROM32K", 32768 },    { "Screen", 8192 },  { "Keyboard", 1 },
+};
+
+const Bus*
+Netlist::FindInput(const std::string& name) const
+{
+    const auto it = std::ranges::find(inputs, name, &Bus::name);
+    return it == inputs.end() ? nullptr : &*it;
+}
+
+const Bus*
+Netlist::FindOutput(const std::string& name) const
+{
+    const auto it = std::ranges::find(outputs, name, &Bus::name);
+    return it == outputs.end() ? nullptr : &*it;
+}
+
+bool
+Netlist::Levelize(std::string& error)
+{
+    const std::size_t n_nodes = nands.size() + memories.size();
+    const auto node_at        = [this](std::size_t i) {
+        return i < nands.size() ? Node{ Node::Kind::Nand, static_cast<std::uint32_t>(i) }
+                                : Node{ Node::Kind::Memory, static_cast<std::uint32_t>(i - nands.size()) };
+    };
+
+    // net -> node driving it
+    std::vector<std::uint32_t> driver(_nets, UINT32_MAX);
+    for (std::size_t i = 0; i < nands.size(); i++) {
+        driver[nands[i].out] = static_cast<std::uint32_t>(i);
+    }
+    for (std::size_t m = 0; m < memories.size(); m++) {
+        for (const Net out : memories[m].out) {
+            driver[out] = static_cast<std::uint32_t>(nands.size() + m);
+        }
+    }
+
+    // node -> nodes reading its outputs (combinationally)
+    std::vector<std::vector<std::uint32_t>> fanout(n_nodes);
+    std::vector<std::uint32_t> pending(n_nodes, 0);
+    const auto depend = [&](std::size_t node, Net net) {
+        if (driver[net] != UINT32_MAX) {
+            fanout[driver[net]].push_back(static_cast<std::uint32_t>(node));
+            pending[node]++;
+        }
+    };
+    for (std::size_t i = 0; i < nands.size(); i++) {
+        depend(i, nands[i].a);
+        depend(i, nands[i].b);
+    }
+    for (std::size_t m = 0; m < memories.size(); m++) {
+        for (const Net a : memories[m].address) {
+            depend(nands.size() + m, a);
+        }
+    }
+
+    std::deque<std::uint32_t> ready;
+    for (std::size_t i = 0; i < n_nodes; i++) {
+        if (pending[i] == 0) {
+            ready.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+
+    order.clear();
+    order.reserve(n_nodes);
+    while (!ready.empty()) {
+        const std::uint32_t i = ready.front();
+        ready.pop_front();
+        order.push_back(node_at(i));
+        for (const std::uint32_t next : fanout[i]) {
+            if (--pending[next] == 0) {
+                ready.push_back(next);
+            }
+        }
+    }
+
+    if (order.size() != n_nodes) {
+        error = "combinational loop (" + std::to_string(n_nodes - order.size()) + " gates)";
+        return false;
+    }
+    return true;
+}
+
+// Instantiates chips recursively. Nets that a part output and a pin of the
+// enclosing chip both name are merged with a union-find and renumbered at the end.
+class Flattener
+{
+  public:
+    Flattener(Library& library, Netlist& netlist, const FlattenOptions& options)
+      : _library(library)
+      , _nl(netlist)
+      , _options(options)
+      , _parent{ NET_FALSE, NET_TRUE }
+    {
+    }
+
+    bool Run(const std::string& name, std::string& error);
+
+  private:
+    Net NewNet()
+    {
+        const Net n = _nl.NewNet();
+        _parent.push_back(n);
+        return n;
+    }
+    Net Find(Net n)
+    {
+        while (_parent[n] != n) {
+            n = _parent[n] = _parent[_parent[n]];
+        }
+        return n;
+    }
+    void Merge(Net keep, Net other)
+    {
+        keep  = Find(keep);
+        other = Find(other);
+        if (keep != other) {
+            // constants stay roots
+            if (other <= NET_TRUE) {
+                std::swap(keep, other);
+            }
+            _parent[other] = keep;
+        }
+    }
+
+    bool Fail(const ChipDef& chip, int line, const std::string& what)
+    {
+        _error = chip.name + (chip.path.empty() ? "" : " (" + chip.path + ":" + std::to_string(line) + ")") +
+                 ": " + what;
+        return false;
+    }
+
+    bool Instantiate(const ChipDef& chip, const Signals& pins, int depth);
+    bool Builtin(const ChipDef& chip, const Signals& pins);
+    bool AsMemory(const ChipDef& chip, const Signals& pins);
+    void Register(const std::vector<Net>& in, Net load, const std::vector<Net>& out);
+    void Renumber();
+
+    Library& _library;
+    Netlist& _nl;
+    const FlattenOptions& _options;
+    std::vector<Net> _parent;
+    std::string _error;
+};
+
+static std::vector<Net>
+Slice(const std::vector<Net>& bits, const PinRef& ref)
+{
+    if (ref.Whole()) {
+        return bits;
+    }
+    return std::vector<Net>(bits.begin() + ref.lo, bits.begin() + ref.hi + 1);
+}
+
+static int
+Width(const PinRef& ref, int whole)
+{
+    return ref.Whole() ? whole : ref.hi - ref.lo + 1;
+}
+
+void
+Flattener::Register(const std::vector<Net>& in, Net load, const std::vector<Net>& out)
+{
+    // out(t+1) = load ? in : out, as Mux + DFF in Nands
+    const Net nload = NewNet();
+    _nl.nands.push_back({ load, load, nload });
+    for (std::size_t i = 0; i < out.size(); i++) {
+        const Net t1 = NewNet(), t2 = NewNet(), d = NewNet();
+        _nl.nands.push_back({ in[i], load, t1 });
+        _nl.nands.push_back({ out[i], nload, t2 });
+        _nl.nands.push_back({ t1, t2, d });
+        _nl.dffs.push_back({ d, out[i] });
+    }
+}
+
+bool
+Flattener::Builtin(const ChipDef& chip, const Signals& pins)
+{
+    const auto pin = [&pins](const char* name) { return pins.at(name); };
+
+    if (chip.name == "Nand") {
+        _nl.nands.push_back({ pin("a")[0], pin("b")[0], pin("out")[0] });
+        return true;
+    }
+    if (chip.name == "DFF") {
+        _nl.dffs.push_back({ pin("in")[0], pin("out")[0] });
+        return true;
+    }
+    if (chip.name == "ARegister" || chip.name == "DRegister") {
+        Register(pin("in"), pin("load")[0], pin("out"));
+        return true;
+    }
+
+    const auto size = MEMORY_SIZES.find(chip.name);
+    if (size == MEMORY_SIZES.end()) {
+        return Fail(chip, 0, "no built-in implementation");
+    }
+
+    MemoryBlock m;
+    m.chip = chip.name;
+    m.size = size->second;
+    m.out  = pin("out");
+    if (pins.contains("address")) {
+        m.address = pin("address");
+    }
+    if (pins.contains("in")) {
+        m.in   = pin("in");
+        m.load = pin("load")[0];
+    }
+    _nl.memories.push_back(std::move(m));
+    return true;
+}
+
+bool
+Flattener::AsMemory(const ChipDef& chip, const Signals& pins)
+{
+    const Pin* in      = chip.FindInput("in");
+    const Pin* load    = chip.FindInput("load");
+    const Pin* address = chip.FindInput("address");
+    const Pin* out     = chip.FindOutput("out");
+    if (chip.inputs.size() != 3 || chip.outputs.size() != 1 || !in || !load || !address || !out ||
+        load->width != 1 || in->width != out->width || in->width > 16 || address->width > 24) {
+        return false;
+    }
+    if (!_options.as_memory(chip)) {
+        return false;
+    }
+
+    MemoryBlock m;
+    m.chip    = chip.name;
+    m.size    = std::size_t{ 1 } << address->width;
+    m.address = pins.at("address");
+    m.in      = pins.at("in");
+    m.load    = pins.at("load")[0];
+    m.out     = pins.at("out");
+    _nl.memories.push_back(std::move(m));
+    return true;
+}
+
+bool
+Flattener::Instantiate(const ChipDef& chip, const Signals& pins, int depth)
+{
+    if (depth > MAX_DEPTH) {
+        return Fail(chip, 0, "parts nested too deeply (recursive chip?)");
+    }
+
+    const bool first = !_nl.probes.contains(chip.name) && pins.contains("out");
+    if (first && depth > 0) {
+        _nl.probes[chip.name] = pins.at("out");
+    }
+
+    if (chip.builtin) {
+        return Builtin(chip, pins);
+    }
+    if (depth > 0 && _options.as_memory && AsMemory(chip, pins)) {
+        return true;
+    }
+
+    Signals signals = pins;
+    std::vector<const ChipDef*> defs;
+    std::vector<Signals> part_pins(chip.parts.size());
+
+    // outputs first, so that parts may use signals driven by later parts
+    for (std::size_t p = 0; p < chip.parts.size(); p++) {
+        const Part& part   = chip.parts[p];
+        const ChipDef* def = _library.Find(part.chip);
+        if (!def) {
+            return Fail(chip, part.line, _library.Error());
+        }
+        defs.push_back(def);
+
+        for (auto&& out : def->outputs) {
+            auto& bits = part_pins[p][out.name];
+            for (int i = 0; i < out.width; i++) {
+                bits.push_back(NewNet());
+            }
+        }
+
+        for (auto&& c : part.connections) {
+            const Pin* out = def->FindOutput(c.inner.name);
+            if (!out) {
+                continue;
+            }
+            if (!c.inner.Whole() && c.inner.hi >= out->width) {
+                return Fail(chip, part.line, "sub-bus out of range: " + c.inner.name);
+            }
+
+            const std::vector<Net> src = Slice(part_pins[p][out->name], c.inner);
+            if (chip.FindInput(c.outer.name) || c.outer.name == "true" || c.outer.name == "false") {
+                return Fail(chip, part.line, "cannot drive " + c.outer.name);
+            }
+
+            const Pin* own = chip.FindOutput(c.outer.name);
+            if (own) {
+                if (!c.outer.Whole() && c.outer.hi >= own->width) {
+                    return Fail(chip, part.line, "sub-bus out of range: " + c.outer.name);
+                }
+                const std::vector<Net> dst = Slice(signals[own->name], c.outer);
+                if (dst.size() != src.size()) {
+                    return Fail(chip, part.line, "width mismatch on " + c.outer.name);
+                }
+                for (std::size_t i = 0; i < dst.size(); i++) {
+                    Merge(dst[i], src[i]);
+                }
+                continue;
+            }
+
+            if (!c.outer.Whole()) {
+                return Fail(chip, part.line, "sub-bus of an internal pin: " + c.outer.name);
+            }
+            if (signals.contains(c.outer.name)) {
+                return Fail(chip, part.line, "multiple drivers for " + c.outer.name);
+            }
+            signals[c.outer.name] = src;
+        }
+    }
+
+    for (std::size_t p = 0; p < chip.parts.size(); p++) {
+        const Part& part   = chip.parts[p];
+        const ChipDef* def = defs[p];
+        Signals& sub       = part_pins[p];
+
+        // unconnected inputs are false
+        for (auto&& in : def->inputs) {
+            sub[in.name] = std::vector<Net>(in.width, NET_FALSE);
+        }
+
+        for (auto&& c : part.connections) {
+            const Pin* in = def->FindInput(c.inner.name);
+            if (!in) {
+                if (!def->FindOutput(c.inner.name)) {
+                    return Fail(chip, part.line, part.chip + " has no pin " + c.inner.name);
+                }
+                continue;
+            }
+
+            const int width = Width(c.inner, in->width);
+            if (!c.inner.Whole() && c.inner.hi >= in->width) {
+                return Fail(chip, part.line, "sub-bus out of range: " + c.inner.name);
+            }
+
+            std::vector<Net> src;
+            if (c.outer.name == "true" || c.outer.name == "false") {
+                src.assign(width, c.outer.name == "true" ? NET_TRUE : NET_FALSE);
+            } else {
+                const auto it = signals.find(c.outer.name);
+                if (it == signals.end() || chip.FindOutput(c.outer.name)) {
+                    return Fail(chip, part.line, "undefined input " + c.outer.name);
+                }
+                if (!c.outer.Whole() && c.outer.hi >= static_cast<int>(it->second.size())) {
+                    return Fail(chip, part.line, "sub-bus out of range: " + c.outer.name);
+                }
+                src = Slice(it->second, c.outer);
+            }
+
+            if (static_cast<int>(src.size()) != width) {
+                return Fail(chip, part.line, "width mismatch on " + c.inner.name);
+            }
+            std::copy(src.begin(), src.end(), sub[in->name].begin() + (c.inner.Whole() ? 0 : c.inner.lo));
+        }
+
+        if (!Instantiate(*def, sub, depth + 1)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void
+Flattener::Renumber()
+{
+    std::vector<Net> id(_parent.size(), UINT32_MAX);
+    id[NET_FALSE]  = NET_FALSE;
+    id[NET_TRUE]   = NET_TRUE;
+    Net next       = 2;
+    const auto map = [&](Net& n) {
+        const Net root = Find(n);
+        if (id[root] == UINT32_MAX) {
+            id[root] = next++;
+        }
+        n = id[root];
+    };
+
+    for (auto&& bus : _nl.inputs) {
+        std::ranges::for_each(bus.bits, map);
+    }
+    for (auto&& bus : _nl.outputs) {
+        std::ranges::for_each(bus.bits, map);
+    }
+    for (auto&& g : _nl.nands) {
+        map(g.a);
+        map(g.b);
+        map(g.out);
+    }
+    for (auto&& d : _nl.dffs) {
+        map(d.in);
+        map(d.out);
+    }
+    for (auto&& m : _nl.memories) {
+        std::ranges::for_each(m.address, map);
+        std::ranges::for_each(m.in, map);
+        std::ranges::for_each(m.out, map);
+        map(m.load);
+    }
+    for (auto&& [name, bits] : _nl.probes) {
+        std::ranges::for_each(bits, map);
+    }
+
+    _nl.SetNetCount(next);
+}
+
+bool
+Flattener::Run(const std::string& name, std::string& error)
+{
+    const ChipDef* top = _library.Find(name);
+    if (!top) {
+        error = _library.Error();
+        return false;
+    }
+
+    Signals pins;
+    for (auto&& [pins_of, buses] : { std::pair{ &top->inputs, &_nl.inputs }, std::pair{ &top->outputs, &_nl.outputs } }) {
+        for (auto&& pin : *pins_of) {
+            Bus bus{ pin.name, {} };
+            for (int i = 0; i < pin.width; i++) {
+                bus.bits.push_back(NewNet());
+            }
+            pins[pin.name] = bus.bits;
+            buses->push_back(std::move(bus));
+        }
+    }
+
+    if (!Instantiate(*top, pins, 0)) {
+        error = _error;
+        return false;
+    }
+
+    Renumber();
+    return _nl.Levelize(error);
+}
+
+bool
+Flatten(Library& library, const std::string& name, Netlist& netlist, std::string& error,
+        const FlattenOptions& options)
+{
+    netlist = Netlist{};
+    Flattener flattener{ library, netlist, options };
+    return flattener.Run(name, error);
+}
+
+} // namespace Hdl
@@ -0,0 +1,111 @@
+#ifndef HDL_NETLIST_HH
+#define HDL_NETLIST_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "library.h"
+
+namespace Hdl {
+
+// A single-bit signal of the flattened design
+using Net = std::uint32_t;
+
+static constexpr Net NET_FALSE = 0;
+static constexpr Net NET_TRUE  = 1;
+
+struct NandGate
+{
+    Net a;
+    Net b;
+    Net out;
+};
+
+struct DffCell
+{
+    Net in;
+    Net out;
+};
+
+// Behavioural memory (built-in RAMn, ROM32K, Screen, Keyboard).
+// Reads are combinational, writes happen on the clock.
+struct MemoryBlock
+{
+    std::string chip;
+    std::size_t size{ 0 };
+    std::vector<Net> address; // bit 0 first
+    std::vector<Net> in;      // empty when read-only
+    Net load{ NET_FALSE };
+    std::vector<Net> out;
+};
+
+// A pin of the top chip, bit 0 first
+struct Bus
+{
+    std::string name;
+    std::vector<Net> bits;
+};
+
+// Flattened design: Nand gates, DFFs and memories over numbered nets.
+class Netlist
+{
+  public:
+    // One step of the combinational evaluation order
+    struct Node
+    {
+        enum class Kind
+        {
+            Nand,
+            Memory
+        };
+        Kind kind;
+        std::uint32_t index;
+    };
+
+    std::size_t NetCount() const { return _nets; }
+
+    std::vector<NandGate> nands;
+    std::vector<DffCell> dffs;
+    std::vector<MemoryBlock> memories;
+    std::vector<Bus> inputs;
+    std::vector<Bus> outputs;
+
+    // `Chip[]` of a script: the `out` bus of the first instance of a chip
+    std::map<std::string, std::vector<Net>> probes;
+
+    // Topological order of nands and memory reads. Set by Levelize().
+    std::vector<Node> order;
+
+    // Orders the combinational nodes. Fails on a combinational loop.
+    bool Levelize(std::string& error);
+
+    const Bus* FindInput(const std::string& name) const;
+    const Bus* FindOutput(const std::string& name) const;
+
+    Net NewNet() { return static_cast<Net>(_nets++); }
+    void SetNetCount(std::size_t n) { _nets = n; }
+
+  private:
+    std::size_t _nets{ 2 }; // NET_FALSE, NET_TRUE
+};
+
+struct FlattenOptions
+{
+    // Asked for every part shaped like a RAM (IN in[w], load, address[k];
+    // OUT out[w], w <= 16). Returning true replaces the part with a
+    // behavioural memory of 2^k words instead of instantiating its PARTS.
+    std::function<bool(const ChipDef& chip)> as_memory;
+};
+
+// Flattens the chip `name` (and its parts, recursively) down to primitives
+bool
+Flatten(Library& library, const std::string& name, Netlist& netlist, std::string& error,
+        const FlattenOptions& options = {});
+
+} // namespace Hdl
+
+#endif
@@ -0,0 +1,211 @@
+#include "optimizer.h"
+
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+
+#include "simulator.h"
+
+namespace Hdl {
+
+static std::uint64_t
+Key(Net a, Net b)
+{
+    return std::uint64_t{ std::min(a, b) } << 32 | std::max(a, b);
+}
+
+OptimizeStats
+Optimize(Netlist& netlist)
+{
+    OptimizeStats stats;
+    stats.nands_before = netlist.nands.size();
+
+    std::vector<Net> alias(netlist.NetCount());
+    for (std::size_t n = 0; n < alias.size(); n++) {
+        alias[n] = static_cast<Net>(n);
+    }
+    // out -> x for kept gates computing Not(x)
+    std::vector<Net> inverse(netlist.NetCount(), UINT32_MAX);
+    std::unordered_map<std::uint64_t, Net> gates;
+
+    // one pass in levelized order: inputs of a gate are final when it is reached
+    std::vector<NandGate> kept;
+    for (const Netlist::Node& node : netlist.order) {
+        if (node.kind == Netlist::Node::Kind::Memory) {
+            for (Net& a : netlist.memories[node.index].address) {
+                a = alias[a];
+            }
+            continue;
+        }
+
+        NandGate g = netlist.nands[node.index];
+        g.a        = alias[g.a];
+        g.b        = alias[g.b];
+        if (g.a == NET_TRUE) {
+            g.a = g.b;
+        } else if (g.b == NET_TRUE) {
+            g.b = g.a;
+        }
+
+        if (g.a == NET_FALSE || g.b == NET_FALSE || inverse[g.a] == g.b || inverse[g.b] == g.a) {
+            alias[g.out] = NET_TRUE;
+            stats.constants++;
+        } else if (g.a == NET_TRUE) { // Nand(true, true)
+            alias[g.out] = NET_FALSE;
+            stats.constants++;
+        } else if (g.a == g.b && inverse[g.a] != UINT32_MAX) {
+            alias[g.out] = inverse[g.a];
+            stats.inversions++;
+        } else if (const auto it = gates.find(Key(g.a, g.b)); it != gates.end()) {
+            alias[g.out] = it->second;
+            stats.merged++;
+        } else {
+            gates[Key(g.a, g.b)] = g.out;
+            if (g.a == g.b) {
+                inverse[g.out] = g.a;
+            }
+            kept.push_back(g);
+        }
+    }
+
+    const auto remap = [&alias](std::vector<Net>& bits) {
+        for (Net& n : bits) {
+            n = alias[n];
+        }
+    };
+    for (auto&& bus : netlist.outputs) {
+        remap(bus.bits);
+    }
+    for (auto&& [chip, bits] : netlist.probes) {
+        remap(bits);
+    }
+    for (auto&& d : netlist.dffs) {
+        d.in = alias[d.in];
+    }
+    for (auto&& m : netlist.memories) {
+        remap(m.in);
+        m.load = alias[m.load];
+    }
+
+    // keep what pins, probes, DFFs and memories observe
+    std::vector<bool> live(netlist.NetCount(), false);
+    const auto mark = [&live](const std::vector<Net>& bits) {
+        for (const Net n : bits) {
+            live[n] = true;
+        }
+    };
+    for (auto&& bus : netlist.outputs) {
+        mark(bus.bits);
+    }
+    for (auto&& [chip, bits] : netlist.probes) {
+        mark(bits);
+    }
+    for (auto&& d : netlist.dffs) {
+        live[d.in] = true;
+    }
+    for (auto&& m : netlist.memories) {
+        mark(m.address);
+        mark(m.in);
+        live[m.load] = true;
+    }
+
+    netlist.nands.clear();
+    for (auto it = kept.rbegin(); it != kept.rend(); ++it) {
+        if (!live[it->out]) {
+            stats.dead++;
+            continue;
+        }
+        live[it->a] = live[it->b] = true;
+        netlist.nands.push_back(*it);
+    }
+    std::reverse(netlist.nands.begin(), netlist.nands.end());
+    stats.nands_after = netlist.nands.size();
+
+    std::string error;
+    netlist.Levelize(error); // removing gates cannot create a loop
+    return stats;
+}
+
+bool
+MemoryRecognizer::operator()(const ChipDef& chip)
+{
+    const auto it = _verdicts.find(chip.path);
+    if (it != _verdicts.end()) {
+        return it->second;
+    }
+    _verdicts[chip.path] = false; // while its own parts are looked at
+
+    Netlist netlist;
+    std::string error;
+    const bool verdict = Flatten(_library, chip.name, netlist, error, Options()) && Verify(netlist);
+    _verdicts[chip.path] = verdict;
+    return verdict;
+}
+
+bool
+MemoryRecognizer::Verify(const Netlist& netlist) const
+{
+    static constexpr int CYCLES    = 256;
+    static constexpr int BASES     = 4; // addresses per lane, so that reads hit earlier writes
+
+    const std::vector<Net>& in      = netlist.FindInput("in")->bits;
+    const std::vector<Net>& load    = netlist.FindInput("load")->bits;
+    const std::vector<Net>& address = netlist.FindInput("address")->bits;
+    const std::vector<Net>& out     = netlist.FindOutput("out")->bits;
+    const std::uint64_t word_mask   = (std::uint64_t{ 1 } << in.size()) - 1;
+
+    Simulator sim{ netlist };
+    std::mt19937_64 rng{ 2024 };
+
+    // each base address comes with a neighbour differing in one bit, so
+    // that a decoder ignoring an address bit shows up as aliasing
+    std::vector<std::vector<std::uint64_t>> pool(Simulator::MAX_LANES);
+    std::vector<std::unordered_map<std::uint64_t, std::uint64_t>> model(Simulator::MAX_LANES);
+    for (std::size_t lane = 0; lane < pool.size(); lane++) {
+        for (std::size_t i = 0; i < BASES; i++) {
+            const std::uint64_t base = rng() & ((std::uint64_t{ 1 } << address.size()) - 1);
+            pool[lane].push_back(base);
+            pool[lane].push_back(base ^ (std::uint64_t{ 1 } << (lane + i) % address.size()));
+        }
+    }
+
+    std::vector<std::uint64_t> v_in(Simulator::MAX_LANES), v_load(Simulator::MAX_LANES),
+      v_address(Simulator::MAX_LANES);
+    const auto check = [&] {
+        for (std::size_t lane = 0; lane < Simulator::MAX_LANES; lane++) {
+            if (sim.GetBus(out, lane) != model[lane][v_address[lane]]) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    for (int cycle = 0; cycle < CYCLES; cycle++) {
+        for (std::size_t lane = 0; lane < Simulator::MAX_LANES; lane++) {
+            v_in[lane]      = rng() & word_mask;
+            v_load[lane]    = rng() & 1;
+            v_address[lane] = pool[lane][rng() % pool[lane].size()];
+        }
+        sim.SetLanes(in, v_in);
+        sim.SetLanes(load, v_load);
+        sim.SetLanes(address, v_address);
+
+        sim.Eval();
+        if (!check()) {
+            return false;
+        }
+        sim.Tick();
+        sim.Tock();
+        for (std::size_t lane = 0; lane < Simulator::MAX_LANES; lane++) {
+            if (v_load[lane]) {
+                model[lane][v_address[lane]] = v_in[lane];
+            }
+        }
+        if (!check()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace Hdl
@@ -0,0 +1,58 @@
+#ifndef HDL_OPTIMIZER_HH
+#define HDL_OPTIMIZER_HH
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+#include "library.h"
+#include "netlist.h"
+
+namespace Hdl {
+
+struct OptimizeStats
+{
+    std::size_t nands_before{ 0 };
+    std::size_t nands_after{ 0 };
+    std::size_t constants{ 0 };  // gates with a constant output
+    std::size_t inversions{ 0 }; // Not(Not(x)) = x
+    std::size_t merged{ 0 };     // same inputs as an earlier gate
+    std::size_t dead{ 0 };       // nothing observable depends on them
+};
+
+// Simplifies a levelized netlist in place and levelizes it again:
+// constant propagation, double inversion removal, merging of identical
+// gates (Nand is commutative) and removal of dead gates. Pins, probes,
+// DFFs and memories keep their behaviour; their nets may be renamed.
+OptimizeStats
+Optimize(Netlist& netlist);
+
+// FlattenOptions::as_memory that replaces a RAM-shaped chip with a
+// behavioural memory when the chip behaves like one. The chip is flattened
+// on its own (its RAM parts recognised first) and driven with random
+// writes and reads in 64 lanes against a model. Verdicts are cached.
+class MemoryRecognizer
+{
+  public:
+    explicit MemoryRecognizer(Library& library)
+      : _library(library)
+    {
+    }
+
+    bool operator()(const ChipDef& chip);
+
+    FlattenOptions Options()
+    {
+        return { [this](const ChipDef& chip) { return (*this)(chip); } };
+    }
+
+  private:
+    bool Verify(const Netlist& netlist) const;
+
+    Library& _library;
+    std::map<std::string, bool> _verdicts;
+};
+
+} // namespace Hdl
+
+#endif
@@ -0,0 +1,389 @@
+#include "simulator.h"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <fstream>
+
+namespace Hdl {
+
+// Auto mode goes levelized when an event sweep visits more than this share
+// of the nodes, and tries an event sweep again every RETRY_SWEEPS evals
+static constexpr double LEVELIZED_ABOVE     = 0.25;
+static constexpr std::uint64_t RETRY_SWEEPS = 16;
+
+Simulator::Simulator(const Netlist& netlist, std::size_t lanes)
+  : _netlist(netlist)
+  , _lanes(std::clamp<std::size_t>(lanes, 1, MAX_LANES))
+  , _mask(_lanes == 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << _lanes) - 1)
+  , _values(netlist.NetCount(), 0)
+  , _sampled(netlist.dffs.size(), 0)
+  , _dff_of(netlist.NetCount(), NO_DFF)
+{
+    _values[NET_TRUE] = _mask;
+    for (std::size_t i = 0; i < netlist.dffs.size(); i++) {
+        _dff_of[netlist.dffs[i].out] = static_cast<std::uint32_t>(i);
+    }
+    for (auto&& m : netlist.memories) {
+        _data.emplace_back(m.size * _lanes, 0);
+    }
+
+    // fan-out of every net as positions in the levelized order
+    const auto inputs_of = [&netlist](const Netlist::Node& node, auto&& visit) {
+        if (node.kind == Netlist::Node::Kind::Nand) {
+            const NandGate& g = netlist.nands[node.index];
+            visit(g.a);
+            if (g.b != g.a) {
+                visit(g.b);
+            }
+        } else {
+            for (const Net a : netlist.memories[node.index].address) {
+                visit(a);
+            }
+        }
+    };
+    _fanout_start.assign(netlist.NetCount() + 1, 0);
+    for (auto&& node : netlist.order) {
+        inputs_of(node, [this](Net n) { _fanout_start[n + 1]++; });
+    }
+    for (std::size_t n = 0; n < netlist.NetCount(); n++) {
+        _fanout_start[n + 1] += _fanout_start[n];
+    }
+    _fanout.resize(_fanout_start.back());
+    std::vector<std::uint32_t> fill(_fanout_start.begin(), _fanout_start.end() - 1);
+    _memory_at.resize(netlist.memories.size());
+    for (std::uint32_t pos = 0; pos < netlist.order.size(); pos++) {
+        inputs_of(netlist.order[pos], [&](Net n) { _fanout[fill[n]++] = pos; });
+        if (netlist.order[pos].kind == Netlist::Node::Kind::Memory) {
+            _memory_at[netlist.order[pos].index] = pos;
+        }
+    }
+    _dirty.assign((netlist.order.size() + 63) / 64, 0);
+}
+
+void
+Simulator::Queue(std::uint32_t position)
+{
+    std::uint64_t& word     = _dirty[position / 64];
+    const std::uint64_t bit = std::uint64_t{ 1 } << (position % 64);
+    _queued += (word & bit) == 0;
+    word |= bit;
+}
+
+void
+Simulator::Changed(Net net)
+{
+    for (std::uint32_t i = _fanout_start[net]; i < _fanout_start[net + 1]; i++) {
+        Queue(_fanout[i]);
+    }
+}
+
+void
+Simulator::Set(Net net, std::uint64_t word)
+{
+    if (_values[net] != word) {
+        _values[net] = word;
+        Changed(net);
+    }
+}
+
+void
+Simulator::SetWord(Net net, std::uint64_t word)
+{
+    Set(net, word & _mask);
+}
+
+std::size_t
+Simulator::Address(const MemoryBlock& m, std::size_t lane) const
+{
+    std::size_t address = 0;
+    for (std::size_t i = 0; i < m.address.size(); i++) {
+        address |= ((_values[m.address[i]] >> lane) & 1) << i;
+    }
+    return address % m.size;
+}
+
+void
+Simulator::ReadPort(std::size_t memory)
+{
+    const MemoryBlock& m = _netlist.memories[memory];
+    const auto& data     = _data[memory];
+
+    for (const Net out : m.out) {
+        _values[out] = 0;
+    }
+    for (std::size_t lane = 0; lane < _lanes; lane++) {
+        const std::uint16_t word = data[lane * m.size + Address(m, lane)];
+        for (std::size_t i = 0; i < m.out.size(); i++) {
+            _values[m.out[i]] |= std::uint64_t{ (word >> i) & 1u } << lane;
+        }
+    }
+}
+
+void
+Simulator::Eval()
+{
+    bool events = false;
+    if (_settled && _mode == Mode::EventDriven) {
+        events = true;
+    } else if (_settled && _mode == Mode::Auto) {
+        events = _activity <= LEVELIZED_ABOVE || ++_sweeps % RETRY_SWEEPS == 0;
+    }
+
+    if (events) {
+        EvalEvents();
+    } else {
+        EvalLevelized();
+    }
+}
+
+void
+Simulator::EvalLevelized()
+{
+    std::uint64_t* v = _values.data();
+    for (const Netlist::Node& node : _netlist.order) {
+        if (node.kind == Netlist::Node::Kind::Nand) {
+            const NandGate& g = _netlist.nands[node.index];
+            v[g.out]          = ~(v[g.a] & v[g.b]);
+        } else {
+            ReadPort(node.index);
+        }
+    }
+
+    std::ranges::fill(_dirty, 0);
+    _queued  = 0;
+    _settled = true;
+    _evaluated += _netlist.order.size();
+}
+
+void
+Simulator::EvalEvents()
+{
+    if (_queued == 0) {
+        return;
+    }
+
+    std::uint64_t* v    = _values.data();
+    std::size_t visited = 0;
+    for (std::size_t w = 0; w < _dirty.size(); w++) {
+        // nodes queued while sweeping sit after the current one
+        while (_dirty[w]) {
+            const std::uint32_t pos = static_cast<std::uint32_t>(w * 64 + std::countr_zero(_dirty[w]));
+            _dirty[w] &= _dirty[w] - 1;
+            visited++;
+
+            const Netlist::Node& node = _netlist.order[pos];
+            if (node.kind == Netlist::Node::Kind::Nand) {
+                const NandGate& g       = _netlist.nands[node.index];
+                const std::uint64_t out = ~(v[g.a] & v[g.b]);
+                if (out != v[g.out]) {
+                    v[g.out] = out;
+                    Changed(g.out);
+                }
+                continue;
+            }
+
+            const MemoryBlock& m = _netlist.memories[node.index];
+            _old.clear();
+            for (const Net n : m.out) {
+                _old.push_back(v[n]);
+            }
+            ReadPort(node.index);
+            for (std::size_t i = 0; i < m.out.size(); i++) {
+                if (v[m.out[i]] != _old[i]) {
+                    Changed(m.out[i]);
+                }
+            }
+        }
+    }
+
+    _queued = 0;
+    _evaluated += visited;
+    _activity = 0.5 * _activity + 0.5 * static_cast<double>(visited) / _netlist.order.size();
+}
+
+void
+Simulator::Tick()
+{
+    Eval();
+
+    for (std::size_t i = 0; i < _netlist.dffs.size(); i++) {
+        _sampled[i] = _values[_netlist.dffs[i].in];
+    }
+    _ticked = true;
+
+    _writes.clear();
+    for (std::size_t m = 0; m < _netlist.memories.size(); m++) {
+        const MemoryBlock& mem = _netlist.memories[m];
+        if (mem.in.empty()) {
+            continue;
+        }
+        const std::uint64_t load = _values[mem.load] & _mask;
+        for (std::size_t lane = 0; lane < _lanes; lane++) {
+            if ((load >> lane) & 1) {
+                _writes.push_back({ m, lane, Address(mem, lane),
+                                    static_cast<std::uint16_t>(GetBus(mem.in, lane)) });
+            }
+        }
+    }
+}
+
+void
+Simulator::Tock()
+{
+    for (std::size_t i = 0; i < _netlist.dffs.size(); i++) {
+        Set(_netlist.dffs[i].out, _sampled[i]);
+    }
+    for (auto&& w : _writes) {
+        _data[w.memory][w.lane * _netlist.memories[w.memory].size + w.address] = w.value;
+        Queue(_memory_at[w.memory]);
+    }
+    _writes.clear();
+    _ticked = false;
+
+    Eval();
+}
+
+void
+Simulator::SetBus(const std::vector<Net>& bits, std::size_t lane, std::uint64_t v)
+{
+    const std::uint64_t bit = std::uint64_t{ 1 } << lane;
+    for (std::size_t i = 0; i < bits.size(); i++) {
+        Set(bits[i], (v >> i) & 1 ? _values[bits[i]] | bit : _values[bits[i]] & ~bit);
+    }
+}
+
+std::uint64_t
+Simulator::GetBus(const std::vector<Net>& bits, std::size_t lane) const
+{
+    std::uint64_t v = 0;
+    for (std::size_t i = 0; i < bits.size(); i++) {
+        v |= ((_values[bits[i]] >> lane) & 1) << i;
+    }
+    return v;
+}
+
+std::uint64_t
+Simulator::GetState(const std::vector<Net>& bits, std::size_t lane) const
+{
+    std::uint64_t v = 0;
+    for (std::size_t i = 0; i < bits.size(); i++) {
+        const std::uint32_t dff = _dff_of[bits[i]];
+        const std::uint64_t w   = _ticked && dff != NO_DFF ? _sampled[dff] : _values[bits[i]];
+        v |= ((w >> lane) & 1) << i;
+    }
+    return v;
+}
+
+void
+Simulator::SetLanes(const std::vector<Net>& bits, const std::vector<std::uint64_t>& values)
+{
+    for (std::size_t i = 0; i < bits.size(); i++) {
+        std::uint64_t word = 0;
+        for (std::size_t lane = 0; lane < std::min(_lanes, values.size()); lane++) {
+            word |= ((values[lane] >> i) & 1) << lane;
+        }
+        Set(bits[i], word);
+    }
+}
+
+const MemoryBlock*
+Simulator::FindMemory(const std::string& chip) const
+{
+    const auto it = std::ranges::find(_netlist.memories, chip, &MemoryBlock::chip);
+    return it == _netlist.memories.end() ? nullptr : &*it;
+}
+
+std::uint16_t
+Simulator::ReadMemory(const MemoryBlock& m, std::size_t address, std::size_t lane) const
+{
+    return _data[&m - _netlist.memories.data()][lane * m.size + address % m.size];
+}
+
+void
+Simulator::WriteMemory(const MemoryBlock& m, std::size_t address, std::uint16_t v, std::size_t lane)
+{
+    const std::size_t memory = &m - _netlist.memories.data();
+    _data[memory][lane * m.size + address % m.size] = v;
+    Queue(_memory_at[memory]);
+}
+
+bool
+Simulator::LoadRom(const std::string& path, std::string& error)
+{
+    const MemoryBlock* rom = FindMemory("ROM32K");
+    if (!rom) {
+        error = "no ROM32K in the design";
+        return false;
+    }
+
+    std::ifstream in{ path };
+    if (!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    std::vector<std::uint16_t> words;
+    std::string line;
+    while (std::getline(in, line)) {
+        while (!line.empty() && std::isspace(static_cast<unsigned char>(line.back()))) {
+            line.pop_back();
+        }
+        if (line.empty()) {
+            continue;
+        }
+        if (line.size() != 16 || line.find_first_not_of("01") != std::string::npos) {
+            error = path + ": invalid line " + std::to_string(words.size() + 1);
+            return false;
+        }
+        words.push_back(static_cast<std::uint16_t>(std::stoul(line, nullptr, 2)));
+    }
+    if (words.size() > rom->size) {
+        error = path + ": program too large";
+        return false;
+    }
+
+    for (std::size_t lane = 0; lane < _lanes; lane++) {
+        for (std::size_t i = 0; i < rom->size; i++) {
+            WriteMemory(*rom, i, i < words.size() ? words[i] : 0, lane);
+        }
+    }
+    return true;
+}
+
+bool
+ForAllInputs(const Netlist& netlist,
+             const std::function<bool(const Simulator& sim, std::uint64_t first, std::size_t count)>& check)
+{
+    std::vector<Net> bits;
+    for (auto&& bus : netlist.inputs) {
+        bits.insert(bits.end(), bus.bits.begin(), bus.bits.end());
+    }
+    if (bits.size() > MAX_EXHAUSTIVE_BITS) {
+        return false;
+    }
+
+    // lane i of a pass holds vector first + i: the low 6 bits follow a fixed
+    // pattern per pass, the others are the same in every lane
+    static constexpr std::uint64_t LOW_BITS[] = {
+        0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull,
+        0xFF00FF00FF00FF00ull, 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull,
+    };
+
+    const std::uint64_t total = std::uint64_t{ 1 } << bits.size();
+    const std::size_t lanes   = static_cast<std::size_t>(std::min<std::uint64_t>(total, Simulator::MAX_LANES));
+    Simulator sim{ netlist, lanes };
+
+    for (std::uint64_t first = 0; first < total; first += lanes) {
+        for (std::size_t i = 0; i < bits.size(); i++) {
+            sim.SetWord(bits[i], i < 6 ? LOW_BITS[i] : ((first >> i) & 1 ? ~std::uint64_t{ 0 } : 0));
+        }
+        sim.Eval();
+        if (!check(sim, first, lanes)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace Hdl
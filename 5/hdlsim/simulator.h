@@ -0,0 +1,132 @@
+#ifndef HDL_SIMULATOR_HH
+#define HDL_SIMULATOR_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "netlist.h"
+
+namespace Hdl {
+
+// Bit-parallel simulator of a levelized netlist. Every net is a 64 bit
+// word and bit `lane` of the word is its value in test vector `lane`, so
+// one pass over the gates evaluates up to 64 independent input vectors.
+//
+// Eval() either re-evaluates every node in levelized order or, event
+// driven, only the nodes downstream of nets that changed since the last
+// Eval(). Nodes to visit are kept in a bitmap over their position in the
+// levelized order; a node's fan-out always sits further on, so a single
+// forward sweep visits them in a valid order.
+class Simulator
+{
+  public:
+    static constexpr std::size_t MAX_LANES = 64;
+
+    enum class Mode
+    {
+        Auto,       // event driven while few nodes change, levelized otherwise
+        Levelized,  // every node, every time
+        EventDriven // changed nets only
+    };
+
+    explicit Simulator(const Netlist& netlist, std::size_t lanes = MAX_LANES);
+
+    std::size_t Lanes() const { return _lanes; }
+
+    void SetMode(Mode mode) { _mode = mode; }
+
+    // Propagates the inputs through the combinational logic
+    void Eval();
+
+    // Nodes (gates and memory reads) evaluated so far
+    std::uint64_t Evaluated() const { return _evaluated; }
+
+    // First half of a clock cycle: DFFs and memories sample their inputs
+    void Tick();
+    // Second half: the sampled values appear on the outputs
+    void Tock();
+
+    void SetBus(const std::vector<Net>& bits, std::size_t lane, std::uint64_t v);
+    std::uint64_t GetBus(const std::vector<Net>& bits, std::size_t lane) const;
+
+    // Like GetBus, but a DFF output reads the value sampled by a pending
+    // Tick: the hardware simulator shows a register's new contents between
+    // tick and tock
+    std::uint64_t GetState(const std::vector<Net>& bits, std::size_t lane) const;
+
+    // Sets the pin to values[lane] in every lane
+    void SetLanes(const std::vector<Net>& bits, const std::vector<std::uint64_t>& values);
+
+    std::uint64_t Word(Net net) const { return _values[net] & _mask; }
+    void SetWord(Net net, std::uint64_t word);
+
+    // The first memory block of the given chip (RAM16K, ROM32K, ...)
+    const MemoryBlock* FindMemory(const std::string& chip) const;
+    std::uint16_t ReadMemory(const MemoryBlock& m, std::size_t address, std::size_t lane = 0) const;
+    void WriteMemory(const MemoryBlock& m, std::size_t address, std::uint16_t v, std::size_t lane = 0);
+
+    // Loads a .hack file into every lane of a ROM32K
+    bool LoadRom(const std::string& path, std::string& error);
+
+  private:
+    static constexpr std::uint32_t NO_DFF = UINT32_MAX;
+
+    struct Write
+    {
+        std::size_t memory;
+        std::size_t lane;
+        std::size_t address;
+        std::uint16_t value;
+    };
+
+    std::size_t Address(const MemoryBlock& m, std::size_t lane) const;
+    void ReadPort(std::size_t memory);
+
+    void Set(Net net, std::uint64_t word);
+    // Queues the readers of a changed net
+    void Changed(Net net);
+    void Queue(std::uint32_t position);
+    void EvalLevelized();
+    void EvalEvents();
+
+    const Netlist& _netlist;
+    std::size_t _lanes;
+    std::uint64_t _mask;
+
+    std::vector<std::uint64_t> _values;
+    std::vector<std::uint64_t> _sampled;           // DFF inputs at Tick
+    std::vector<std::uint32_t> _dff_of;            // net -> DFF driving it, or NO_DFF
+    bool _ticked{ false };
+    std::vector<std::vector<std::uint16_t>> _data; // per memory: lane * size + address
+    std::vector<Write> _writes;                    // memory writes at Tick
+
+    Mode _mode{ Mode::Auto };
+    std::vector<std::uint32_t> _fanout_start;  // per net, into _fanout
+    std::vector<std::uint32_t> _fanout;        // order positions reading the net
+    std::vector<std::uint32_t> _memory_at;     // memory -> order position
+    std::vector<std::uint64_t> _dirty;         // order positions to evaluate
+    std::size_t _queued{ 0 };
+    bool _settled{ false };                    // an Eval() has seen every node
+    double _activity{ 1 };                     // fraction of nodes an event sweep visits
+    std::uint64_t _sweeps{ 0 };
+    std::uint64_t _evaluated{ 0 };
+    std::vector<std::uint64_t> _old;           // memory outputs before a read
+};
+
+// Evaluates every combination of the top chip's inputs, 64 per pass, and
+// calls `check` after each pass. Lane i of the pass starting at `first`
+// holds input vector first + i: the input pins concatenated in declaration
+// order, bit 0 of the first pin lowest. Fails beyond MAX_EXHAUSTIVE_BITS
+// input bits (2^24 vectors take 2^18 passes).
+static constexpr std::size_t MAX_EXHAUSTIVE_BITS = 24;
+
+bool
+ForAllInputs(const Netlist& netlist,
+             const std::function<bool(const Simulator& sim, std::uint64_t first, std::size_t count)>& check);
+
+} // namespace Hdl
+
+#endif
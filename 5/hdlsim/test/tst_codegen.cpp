@@ -0,0 +1,60 @@
+// Tests for Hdl::EmitCpp
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+#include "../codegen.h"
+
+// out = Not(a) through a DFF; `unused` drives nothing
+static Hdl::Netlist
+Toggle()
+{
+    Hdl::Netlist nl;
+    const Hdl::Net a = nl.NewNet(), q = nl.NewNet(), na = nl.NewNet(), unused = nl.NewNet();
+    nl.inputs.push_back({ "a", { a } });
+    nl.outputs.push_back({ "out", { q } });
+    nl.nands.push_back({ a, a, na });
+    nl.nands.push_back({ a, Hdl::NET_TRUE, unused });
+    nl.dffs.push_back({ na, q });
+
+    std::string error;
+    EXPECT_TRUE(nl.Levelize(error)) << error;
+    return nl;
+}
+
+TEST(CodegenTest, EmitsStraightLineCode)
+{
+    std::ostringstream out;
+    Hdl::EmitCpp(Toggle(), "Toggle", out);
+    const std::string code = out.str();
+
+    EXPECT_NE(code.find("class ToggleChip final : public Hdl::CompiledChip"), std::string::npos);
+    EXPECT_NE(code.find("std::unique_ptr<CompiledChip>\nCreateToggle()"), std::string::npos);
+
+    // the DFF input is state, the dead gate is dropped
+    EXPECT_NE(code.find("v[4] = 1 ^ (v[2] & v[2]);"), std::string::npos) << code;
+    EXPECT_EQ(code.find("v[5]"), std::string::npos) << code;
+    EXPECT_EQ(code.find("n5"), std::string::npos) << code;
+
+    EXPECT_NE(code.find("q[0] = v[4];"), std::string::npos) << code;
+    EXPECT_NE(code.find("v[3] = q[0];"), std::string::npos) << code;
+    EXPECT_NE(code.find("if (key == \"out\")"), std::string::npos) << code;
+}
+
+TEST(CodegenTest, InternalNetsAreLocals)
+{
+    Hdl::Netlist nl;
+    const Hdl::Net a = nl.NewNet(), b = nl.NewNet(), t = nl.NewNet(), out = nl.NewNet();
+    nl.inputs.push_back({ "a", { a } });
+    nl.inputs.push_back({ "b", { b } });
+    nl.outputs.push_back({ "out", { out } });
+    nl.nands.push_back({ a, b, t });
+    nl.nands.push_back({ t, t, out });
+    std::string error;
+    ASSERT_TRUE(nl.Levelize(error)) << error;
+
+    std::ostringstream code;
+    Hdl::EmitCpp(nl, "And", code);
+    EXPECT_NE(code.str().find("const unsigned n4 = 1 ^ (v[2] & v[3]);"), std::string::npos) << code.str();
+    EXPECT_NE(code.str().find("v[5] = 1 ^ (n4 & n4);"), std::string::npos) << code.str();
+}
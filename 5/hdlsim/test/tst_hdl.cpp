@@ -0,0 +1,94 @@
+// Tests for Hdl::ParseHdl and Hdl::Library
+#include <gtest/gtest.h>
+#include <string>
+
+#include "../hdl.h"
+#include "../library.h"
+
+using Hdl::ChipDef;
+
+TEST(HdlTest, ParsesChip)
+{
+    const std::string text = "// comment\n"
+                             "CHIP Mux16 {\n"
+                             "    IN a[16], b[16], sel;\n"
+                             "    OUT out[16];\n"
+                             "    /* multi\n"
+                             "       line */\n"
+                             "    PARTS:\n"
+                             "    Not(in=sel, out=nsel);\n"
+                             "    And16(a=a, b[0..7]=b[8..15], b[15]=true, out=out);\n"
+                             "}\n";
+    ChipDef chip;
+    std::string error;
+    ASSERT_TRUE(Hdl::ParseHdl(text, chip, error)) << error;
+
+    EXPECT_EQ(chip.name, "Mux16");
+    ASSERT_EQ(chip.inputs.size(), 3u);
+    EXPECT_EQ(chip.inputs[0].width, 16);
+    EXPECT_EQ(chip.inputs[2].width, 1);
+    ASSERT_NE(chip.FindOutput("out"), nullptr);
+    EXPECT_EQ(chip.FindInput("out"), nullptr);
+
+    ASSERT_EQ(chip.parts.size(), 2u);
+    EXPECT_EQ(chip.parts[0].line, 8);
+    EXPECT_EQ(chip.parts[1].chip, "And16");
+    ASSERT_EQ(chip.parts[1].connections.size(), 4u);
+
+    const auto& sub = chip.parts[1].connections[1];
+    EXPECT_EQ(sub.inner.lo, 0);
+    EXPECT_EQ(sub.inner.hi, 7);
+    EXPECT_EQ(sub.outer.lo, 8);
+    EXPECT_EQ(sub.outer.hi, 15);
+    EXPECT_TRUE(chip.parts[1].connections[0].inner.Whole());
+    EXPECT_EQ(chip.parts[1].connections[2].inner.lo, 15);
+    EXPECT_EQ(chip.parts[1].connections[2].outer.name, "true");
+}
+
+TEST(HdlTest, ParsesBuiltin)
+{
+    ChipDef chip;
+    std::string error;
+    ASSERT_TRUE(Hdl::ParseHdl("CHIP DFF { IN in; OUT out; BUILTIN DFF; CLOCKED in; }", chip, error))
+      << error;
+    EXPECT_TRUE(chip.builtin);
+    EXPECT_TRUE(chip.parts.empty());
+}
+
+TEST(HdlTest, ReportsErrors)
+{
+    ChipDef chip;
+    std::string error;
+    EXPECT_FALSE(Hdl::ParseHdl("CHIP X {\n IN a;\n OUT b\n PARTS: }", chip, error));
+    EXPECT_NE(error.find("line 4"), std::string::npos) << error;
+
+    EXPECT_FALSE(Hdl::ParseHdl("CHIP X { IN a; PARTS: Not(in=a[3..1], out=b); }", chip, error));
+    EXPECT_NE(error.find("reversed"), std::string::npos) << error;
+}
+
+TEST(LibraryTest, LookupOrder)
+{
+    Hdl::Library lib;
+    lib.SetTopDir(PROJECTS_DIR "/3/b");
+    lib.AddPath(PROJECTS_DIR "/1");
+    lib.AddPath(PROJECTS_DIR "/3/a");
+
+    // next to the top chip
+    const ChipDef* ram4k = lib.Find("RAM4K");
+    ASSERT_NE(ram4k, nullptr);
+    EXPECT_FALSE(ram4k->builtin);
+
+    // built-in before the search path, even though 3/a/RAM64.hdl exists
+    const ChipDef* ram64 = lib.Find("RAM64");
+    ASSERT_NE(ram64, nullptr);
+    EXPECT_TRUE(ram64->builtin);
+    EXPECT_TRUE(Hdl::Library::IsBuiltin("RAM64"));
+
+    // search path
+    const ChipDef* mux = lib.Find("Mux");
+    ASSERT_NE(mux, nullptr);
+    EXPECT_NE(mux->path.find("/1/"), std::string::npos);
+
+    EXPECT_EQ(lib.Find("Nope"), nullptr);
+    EXPECT_NE(lib.Error().find("Nope"), std::string::npos);
+}
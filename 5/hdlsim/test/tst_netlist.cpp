@@ -0,0 +1,143 @@
+// Tests for Hdl::Flatten and Netlist::Levelize
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "../netlist.h"
+
+// Test fixture for chips written to a temporary directory
+class NetlistTest : public ::testing::Test
+{
+  protected:
+    std::string dir;
+    std::vector<std::string> files;
+    Hdl::Library lib;
+    Hdl::Netlist nl;
+    std::string error;
+
+    void SetUp() override
+    {
+        dir = std::string("/tmp/hdl_netlist_test_") + std::to_string(::getpid()) + "_" +
+              std::to_string(::rand());
+        ASSERT_EQ(::mkdir(dir.c_str(), 0700), 0);
+        lib.SetTopDir(dir);
+    }
+
+    void TearDown() override
+    {
+        for (auto&& f : files) {
+            std::remove(f.c_str());
+        }
+        ::rmdir(dir.c_str());
+    }
+
+    void Write(const std::string& name, const std::string& text)
+    {
+        const std::string path = dir + "/" + name + ".hdl";
+        std::ofstream out(path);
+        out << text;
+        files.push_back(path);
+    }
+};
+
+static const char* NOT = "CHIP Not { IN in; OUT out; PARTS: Nand(a=in, b=in, out=out); }";
+
+TEST_F(NetlistTest, FlattensHierarchy)
+{
+    Write("Not", NOT);
+    Write("And", "CHIP And { IN a, b; OUT out; PARTS:\n"
+                 "    Not(in=x, out=out);\n" // x is driven below
+                 "    Nand(a=a, b=b, out=x);\n"
+                 "}");
+    Write("Top", "CHIP Top { IN a[2]; OUT out, copy; PARTS:\n"
+                 "    And(a=a[0], b=a[1], out=out, out=copy);\n"
+                 "}");
+
+    ASSERT_TRUE(Hdl::Flatten(lib, "Top", nl, error)) << error;
+    EXPECT_EQ(nl.nands.size(), 2u);
+    EXPECT_TRUE(nl.dffs.empty());
+    ASSERT_EQ(nl.order.size(), 2u);
+
+    // the Nand of And comes first, then the Not reading it
+    EXPECT_EQ(nl.nands[nl.order[1].index].a, nl.nands[nl.order[0].index].out);
+
+    // both outputs are the same net
+    EXPECT_EQ(nl.FindOutput("out")->bits, nl.FindOutput("copy")->bits);
+    EXPECT_EQ(nl.FindInput("a")->bits.size(), 2u);
+    EXPECT_TRUE(nl.probes.contains("And"));
+}
+
+TEST_F(NetlistTest, ConstantsAndUnconnectedInputs)
+{
+    Write("Top", "CHIP Top { IN x; OUT out[2]; PARTS:\n"
+                 "    Nand(a=true, b=x, out=out[0]);\n"
+                 "    Nand(a=x, out=out[1]);\n"
+                 "}");
+    ASSERT_TRUE(Hdl::Flatten(lib, "Top", nl, error)) << error;
+    EXPECT_EQ(nl.nands[0].a, Hdl::NET_TRUE);
+    EXPECT_EQ(nl.nands[1].b, Hdl::NET_FALSE);
+}
+
+TEST_F(NetlistTest, BuiltinRegisterAndMemory)
+{
+    Write("Top", "CHIP Top { IN in[16], load, address[3]; OUT out[16], r[16]; PARTS:\n"
+                 "    DRegister(in=in, load=load, out=r);\n"
+                 "    RAM8(in=in, load=load, address=address, out=out);\n"
+                 "}");
+    ASSERT_TRUE(Hdl::Flatten(lib, "Top", nl, error)) << error;
+    EXPECT_EQ(nl.dffs.size(), 16u);
+    ASSERT_EQ(nl.memories.size(), 1u);
+    EXPECT_EQ(nl.memories[0].size, 8u);
+    EXPECT_EQ(nl.memories[0].address.size(), 3u);
+    EXPECT_EQ(nl.probes["DRegister"], nl.FindOutput("r")->bits);
+}
+
+TEST_F(NetlistTest, RejectsBadWiring)
+{
+    Write("Not", NOT);
+
+    Write("A", "CHIP A { IN a; OUT out; PARTS: Not(in=nowhere, out=out); }");
+    EXPECT_FALSE(Hdl::Flatten(lib, "A", nl, error));
+    EXPECT_NE(error.find("undefined input nowhere"), std::string::npos) << error;
+
+    Write("B", "CHIP B { IN a[2]; OUT out; PARTS: Not(in=a, out=out); }");
+    EXPECT_FALSE(Hdl::Flatten(lib, "B", nl, error));
+    EXPECT_NE(error.find("width mismatch"), std::string::npos) << error;
+
+    Write("C", "CHIP C { IN a; OUT out; PARTS: Not(in=a, out=x); Not(in=a, out=x); Not(in=x, out=out); }");
+    EXPECT_FALSE(Hdl::Flatten(lib, "C", nl, error));
+    EXPECT_NE(error.find("multiple drivers"), std::string::npos) << error;
+
+    Write("D", "CHIP D { IN a; OUT out; PARTS: Not(in=a, out=a); }");
+    EXPECT_FALSE(Hdl::Flatten(lib, "D", nl, error));
+    EXPECT_NE(error.find("cannot drive"), std::string::npos) << error;
+
+    Write("E", "CHIP E { IN a; OUT out; PARTS: Missing(in=a, out=out); }");
+    EXPECT_FALSE(Hdl::Flatten(lib, "E", nl, error));
+    EXPECT_NE(error.find("Missing"), std::string::npos) << error;
+
+    Write("F", "CHIP F { IN a; OUT out; PARTS: F(a=a, out=out); }");
+    EXPECT_FALSE(Hdl::Flatten(lib, "F", nl, error));
+    EXPECT_NE(error.find("nested too deeply"), std::string::npos) << error;
+}
+
+TEST_F(NetlistTest, CombinationalLoop)
+{
+    Write("Loop", "CHIP Loop { IN a; OUT out; PARTS:\n"
+                  "    Nand(a=a, b=y, out=x);\n"
+                  "    Nand(a=x, b=x, out=y, out=out);\n"
+                  "}");
+    EXPECT_FALSE(Hdl::Flatten(lib, "Loop", nl, error));
+    EXPECT_NE(error.find("combinational loop"), std::string::npos) << error;
+
+    // a DFF breaks the loop
+    Write("Latch", "CHIP Latch { IN a; OUT out; PARTS:\n"
+                   "    Nand(a=a, b=y, out=x);\n"
+                   "    DFF(in=x, out=y, out=out);\n"
+                   "}");
+    EXPECT_TRUE(Hdl::Flatten(lib, "Latch", nl, error)) << error;
+}
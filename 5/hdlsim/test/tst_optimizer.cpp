@@ -0,0 +1,154 @@
+// Tests for Hdl::Optimize and Hdl::MemoryRecognizer
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../optimizer.h"
+#include "../simulator.h"
+
+using Hdl::Net;
+using Hdl::Netlist;
+
+static Hdl::Library
+ProjectLibrary(const std::string& top)
+{
+    Hdl::Library lib;
+    lib.SetTopDir(PROJECTS_DIR "/" + top);
+    for (const char* p : { "/1", "/2", "/3/a", "/3/b" }) {
+        lib.AddPath(PROJECTS_DIR + std::string(p));
+    }
+    return lib;
+}
+
+TEST(OptimizerTest, SimplifiesGates)
+{
+    Netlist nl;
+    const Net x = nl.NewNet(), y = nl.NewNet();
+    const Net nx = nl.NewNet(), nnx = nl.NewNet(), t = nl.NewNet(), f = nl.NewNet();
+    const Net and1 = nl.NewNet(), and2 = nl.NewNet(), unused = nl.NewNet();
+    nl.inputs.push_back({ "x", { x } });
+    nl.inputs.push_back({ "y", { y } });
+    nl.nands.push_back({ x, x, nx });
+    nl.nands.push_back({ nx, Hdl::NET_TRUE, nnx });   // Not(Not(x))
+    nl.nands.push_back({ y, Hdl::NET_FALSE, t });     // true
+    nl.nands.push_back({ t, t, f });                  // false
+    nl.nands.push_back({ x, y, and1 });
+    nl.nands.push_back({ y, x, and2 });               // same gate
+    nl.nands.push_back({ and1, and2, unused });
+    nl.outputs.push_back({ "out", { nnx, t, f, and1, and2 } });
+    std::string error;
+    ASSERT_TRUE(nl.Levelize(error)) << error;
+
+    const Hdl::OptimizeStats s = Hdl::Optimize(nl);
+    EXPECT_EQ(s.nands_before, 7u);
+    EXPECT_EQ(s.inversions, 1u);
+    EXPECT_EQ(s.constants, 2u);
+    EXPECT_EQ(s.merged, 1u);
+    EXPECT_EQ(s.dead, 2u); // Not(x) is only used by the folded gate
+    ASSERT_EQ(nl.nands.size(), 1u);
+    EXPECT_EQ(nl.order.size(), 1u);
+
+    const std::vector<Net>& out = nl.outputs[0].bits;
+    EXPECT_EQ(out[0], x);
+    EXPECT_EQ(out[1], Hdl::NET_TRUE);
+    EXPECT_EQ(out[2], Hdl::NET_FALSE);
+    EXPECT_EQ(out[3], out[4]);
+}
+
+// Cancels Not(Not(x)) pairs and the muxes with constant select of the ALU
+TEST(OptimizerTest, AluKeepsBehaviour)
+{
+    Hdl::Library lib = ProjectLibrary("2");
+    Netlist plain, opt;
+    std::string error;
+    ASSERT_TRUE(Hdl::Flatten(lib, "ALU", plain, error)) << error;
+    ASSERT_TRUE(Hdl::Flatten(lib, "ALU", opt, error)) << error;
+    Hdl::Optimize(opt);
+    EXPECT_LT(opt.nands.size(), plain.nands.size());
+
+    Hdl::Simulator a{ plain }, b{ opt };
+    std::mt19937_64 rng{ 1 };
+    for (int round = 0; round < 200; round++) {
+        for (std::size_t i = 0; i < plain.inputs.size(); i++) {
+            std::vector<std::uint64_t> lanes(64);
+            for (auto& v : lanes) {
+                v = rng();
+            }
+            a.SetLanes(plain.inputs[i].bits, lanes);
+            b.SetLanes(opt.inputs[i].bits, lanes);
+        }
+        a.Eval();
+        b.Eval();
+        for (std::size_t o = 0; o < plain.outputs.size(); o++) {
+            for (std::size_t bit = 0; bit < plain.outputs[o].bits.size(); bit++) {
+                ASSERT_EQ(a.Word(plain.outputs[o].bits[bit]), b.Word(opt.outputs[o].bits[bit]))
+                  << plain.outputs[o].name << "[" << bit << "]";
+            }
+        }
+    }
+}
+
+TEST(MemoryRecognizerTest, RecognisesProjectRams)
+{
+    Hdl::Library lib = ProjectLibrary("3/a");
+    Hdl::MemoryRecognizer memories{ lib };
+    Netlist nl;
+    std::string error;
+    ASSERT_TRUE(Hdl::Flatten(lib, "RAM64", nl, error, memories.Options())) << error;
+
+    // the eight RAM8 parts (registers of DFFs) became memories
+    ASSERT_EQ(nl.memories.size(), 8u);
+    EXPECT_EQ(nl.memories[0].chip, "RAM8");
+    EXPECT_EQ(nl.memories[0].size, 8u);
+    EXPECT_TRUE(nl.dffs.empty());
+}
+
+TEST(MemoryRecognizerTest, KeepsComputerMemoryMap)
+{
+    Hdl::Library lib = ProjectLibrary("5");
+    Hdl::MemoryRecognizer memories{ lib };
+    Netlist nl;
+    std::string error;
+    ASSERT_TRUE(Hdl::Flatten(lib, "Computer", nl, error, memories.Options())) << error;
+
+    // Memory has the shape of a RAM, but maps the screen twice
+    std::vector<std::string> chips;
+    for (auto&& m : nl.memories) {
+        chips.push_back(m.chip);
+    }
+    EXPECT_EQ(chips, (std::vector<std::string>{ "ROM32K", "RAM16K", "Screen" }));
+}
+
+TEST(MemoryRecognizerTest, RejectsBrokenRam)
+{
+    const std::string dir = std::string("/tmp/hdl_optimizer_test_") + std::to_string(::getpid());
+    ASSERT_EQ(::mkdir(dir.c_str(), 0700), 0);
+    const std::string path = dir + "/Top.hdl";
+    const std::string ram  = dir + "/RAM64.hdl";
+    {
+        std::ofstream(path) << "CHIP Top { IN in[16], load, address[6]; OUT out[16]; PARTS:\n"
+                               "    RAM64(in=in, load=load, address=address, out=out);\n"
+                               "}\n";
+        // address[5] is ignored: two words alias
+        std::ofstream(ram) << "CHIP RAM64 { IN in[16], load, address[6]; OUT out[16]; PARTS:\n"
+                              "    RAM16K(in=in, load=load, address[0..4]=address[0..4], out=out);\n"
+                              "}\n";
+    }
+
+    Hdl::Library lib;
+    lib.SetTopDir(dir);
+    Hdl::MemoryRecognizer memories{ lib };
+    Netlist nl;
+    std::string error;
+    ASSERT_TRUE(Hdl::Flatten(lib, "Top", nl, error, memories.Options())) << error;
+    ASSERT_EQ(nl.memories.size(), 1u);
+    EXPECT_EQ(nl.memories[0].chip, "RAM16K");
+
+    std::remove(path.c_str());
+    std::remove(ram.c_str());
+    ::rmdir(dir.c_str());
+}
@@ -0,0 +1,273 @@
+// Tests for Hdl::Simulator on the chips of projects 1-3, against C++ models
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../netlist.h"
+#include "../simulator.h"
+
+using Hdl::Netlist;
+using Hdl::Simulator;
+
+// Flattens a chip of the course projects, parts from projects 1-3
+static Netlist
+Load(const std::string& dir, const std::string& chip)
+{
+    Hdl::Library lib;
+    lib.SetTopDir(PROJECTS_DIR "/" + dir);
+    for (const char* p : { "/1", "/2", "/3/a", "/3/b" }) {
+        lib.AddPath(PROJECTS_DIR + std::string(p));
+    }
+
+    Netlist nl;
+    std::string error;
+    EXPECT_TRUE(Hdl::Flatten(lib, chip, nl, error)) << error;
+    return nl;
+}
+
+// Bits [lo, lo + n) of v
+static std::uint64_t
+Field(std::uint64_t v, int lo, int n)
+{
+    return (v >> lo) & ((std::uint64_t{ 1 } << n) - 1);
+}
+
+static std::uint64_t
+Out(const Simulator& sim, const Netlist& nl, const char* pin, std::size_t lane)
+{
+    return sim.GetBus(nl.FindOutput(pin)->bits, lane);
+}
+
+TEST(SimulatorTest, ExhaustiveMux)
+{
+    const Netlist nl = Load("1", "Mux");
+    EXPECT_TRUE(Hdl::ForAllInputs(nl, [&](const Simulator& sim, std::uint64_t first, std::size_t n) {
+        for (std::size_t lane = 0; lane < n; lane++) {
+            const std::uint64_t v = first + lane;
+            const std::uint64_t a = Field(v, 0, 1), b = Field(v, 1, 1), sel = Field(v, 2, 1);
+            EXPECT_EQ(Out(sim, nl, "out", lane), sel ? b : a) << v;
+        }
+        return !::testing::Test::HasFailure();
+    }));
+}
+
+TEST(SimulatorTest, ExhaustiveDMux8Way)
+{
+    const Netlist nl = Load("1", "DMux8Way");
+    const char* outs[] = { "a", "b", "c", "d", "e", "f", "g", "h" };
+    EXPECT_TRUE(Hdl::ForAllInputs(nl, [&](const Simulator& sim, std::uint64_t first, std::size_t n) {
+        for (std::size_t lane = 0; lane < n; lane++) {
+            const std::uint64_t v = first + lane;
+            const std::uint64_t in = Field(v, 0, 1), sel = Field(v, 1, 3);
+            for (std::uint64_t i = 0; i < 8; i++) {
+                EXPECT_EQ(Out(sim, nl, outs[i], lane), i == sel ? in : 0) << v;
+            }
+        }
+        return !::testing::Test::HasFailure();
+    }));
+}
+
+TEST(SimulatorTest, ExhaustiveOr8WayAndFullAdder)
+{
+    const Netlist or8 = Load("1", "Or8Way");
+    EXPECT_TRUE(Hdl::ForAllInputs(or8, [&](const Simulator& sim, std::uint64_t first, std::size_t n) {
+        for (std::size_t lane = 0; lane < n; lane++) {
+            EXPECT_EQ(Out(sim, or8, "out", lane), first + lane != 0 ? 1u : 0u);
+        }
+        return !::testing::Test::HasFailure();
+    }));
+
+    const Netlist fa = Load("2", "FullAdder");
+    EXPECT_TRUE(Hdl::ForAllInputs(fa, [&](const Simulator& sim, std::uint64_t first, std::size_t n) {
+        EXPECT_EQ(n, 8u);
+        for (std::size_t lane = 0; lane < n; lane++) {
+            const std::uint64_t v   = first + lane;
+            const std::uint64_t sum = Field(v, 0, 1) + Field(v, 1, 1) + Field(v, 2, 1);
+            EXPECT_EQ(Out(sim, fa, "sum", lane), sum & 1);
+            EXPECT_EQ(Out(sim, fa, "carry", lane), sum >> 1);
+        }
+        return !::testing::Test::HasFailure();
+    }));
+}
+
+TEST(SimulatorTest, ExhaustiveInc16)
+{
+    const Netlist nl = Load("2", "Inc16");
+    EXPECT_TRUE(Hdl::ForAllInputs(nl, [&](const Simulator& sim, std::uint64_t first, std::size_t n) {
+        for (std::size_t lane = 0; lane < n; lane++) {
+            if (Out(sim, nl, "out", lane) != ((first + lane + 1) & 0xFFFF)) {
+                ADD_FAILURE() << first + lane;
+                return false;
+            }
+        }
+        return true;
+    }));
+}
+
+TEST(SimulatorTest, TooManyInputsForExhaustive)
+{
+    const Netlist nl = Load("2", "Add16");
+    EXPECT_FALSE(Hdl::ForAllInputs(nl, [](const Simulator&, std::uint64_t, std::size_t) { return true; }));
+}
+
+// The 64 lanes hold the 64 control words of the ALU for the same x and y
+TEST(SimulatorTest, AluAllControlsRandomOperands)
+{
+    const Netlist nl = Load("2", "ALU");
+    Simulator sim{ nl };
+
+    static const char* CONTROLS[] = { "zx", "nx", "zy", "ny", "f", "no" };
+    for (int c = 0; c < 6; c++) {
+        std::vector<std::uint64_t> lanes(64);
+        for (std::uint64_t lane = 0; lane < 64; lane++) {
+            lanes[lane] = (lane >> c) & 1;
+        }
+        sim.SetLanes(nl.FindInput(CONTROLS[c])->bits, lanes);
+    }
+
+    std::mt19937 rng{ 12345 };
+    for (int round = 0; round < 2000; round++) {
+        const std::uint16_t x = static_cast<std::uint16_t>(rng());
+        const std::uint16_t y = static_cast<std::uint16_t>(rng());
+        for (std::size_t lane = 0; lane < 64; lane++) {
+            sim.SetBus(nl.FindInput("x")->bits, lane, x);
+            sim.SetBus(nl.FindInput("y")->bits, lane, y);
+        }
+        sim.Eval();
+
+        for (std::uint64_t lane = 0; lane < 64; lane++) {
+            std::uint16_t a = lane & 1 ? 0 : x;
+            a               = lane & 2 ? ~a : a;
+            std::uint16_t b = lane & 4 ? 0 : y;
+            b               = lane & 8 ? ~b : b;
+            std::uint16_t o = lane & 16 ? a + b : a & b;
+            o               = lane & 32 ? ~o : o;
+
+            ASSERT_EQ(Out(sim, nl, "out", lane), o) << x << " " << y << " " << lane;
+            ASSERT_EQ(Out(sim, nl, "zr", lane), o == 0 ? 1u : 0u);
+            ASSERT_EQ(Out(sim, nl, "ng", lane), o >> 15);
+        }
+    }
+}
+
+TEST(SimulatorTest, Mux8Way16RandomVectors)
+{
+    const Netlist nl = Load("1", "Mux8Way16");
+    Simulator sim{ nl };
+    const char* ins[] = { "a", "b", "c", "d", "e", "f", "g", "h" };
+
+    std::mt19937 rng{ 7 };
+    for (int round = 0; round < 200; round++) {
+        std::vector<std::uint64_t> values[8], sel(64);
+        for (int i = 0; i < 8; i++) {
+            for (int lane = 0; lane < 64; lane++) {
+                values[i].push_back(rng() & 0xFFFF);
+            }
+            sim.SetLanes(nl.FindInput(ins[i])->bits, values[i]);
+        }
+        for (auto& s : sel) {
+            s = rng() & 7;
+        }
+        sim.SetLanes(nl.FindInput("sel")->bits, sel);
+        sim.Eval();
+
+        for (std::size_t lane = 0; lane < 64; lane++) {
+            ASSERT_EQ(Out(sim, nl, "out", lane), values[sel[lane]][lane]);
+        }
+    }
+}
+
+// 64 program counters with independent random inputs
+TEST(SimulatorTest, PcAgainstModel)
+{
+    const Netlist nl = Load("3/a", "PC");
+    Simulator sim{ nl };
+
+    std::mt19937 rng{ 99 };
+    std::vector<std::uint16_t> model(64, 0);
+    for (int cycle = 0; cycle < 500; cycle++) {
+        std::vector<std::uint64_t> in(64), load(64), inc(64), reset(64);
+        for (std::size_t lane = 0; lane < 64; lane++) {
+            in[lane]    = rng() & 0xFFFF;
+            load[lane]  = rng() % 4 == 0;
+            inc[lane]   = rng() % 2;
+            reset[lane] = rng() % 16 == 0;
+        }
+        sim.SetLanes(nl.FindInput("in")->bits, in);
+        sim.SetLanes(nl.FindInput("load")->bits, load);
+        sim.SetLanes(nl.FindInput("inc")->bits, inc);
+        sim.SetLanes(nl.FindInput("reset")->bits, reset);
+        sim.Tick();
+        sim.Tock();
+
+        for (std::size_t lane = 0; lane < 64; lane++) {
+            std::uint16_t& pc = model[lane];
+            pc = reset[lane] ? 0 : load[lane] ? static_cast<std::uint16_t>(in[lane]) : inc[lane] ? pc + 1 : pc;
+            ASSERT_EQ(Out(sim, nl, "out", lane), pc) << cycle << " " << lane;
+        }
+    }
+}
+
+TEST(SimulatorTest, MemoryWritesOnTock)
+{
+    const Netlist nl = Load("3/a", "RAM64"); // RAM8 from 3/a, registers of Bits of DFFs
+    Simulator sim{ nl, 2 };
+    EXPECT_TRUE(nl.memories.empty());
+
+    sim.SetBus(nl.FindInput("in")->bits, 0, 1234);
+    sim.SetBus(nl.FindInput("load")->bits, 0, 1);
+    sim.SetBus(nl.FindInput("address")->bits, 0, 42);
+    sim.SetBus(nl.FindInput("address")->bits, 1, 42);
+    sim.Tick();
+    EXPECT_EQ(Out(sim, nl, "out", 0), 0u);
+    sim.Tock();
+    EXPECT_EQ(Out(sim, nl, "out", 0), 1234u);
+    EXPECT_EQ(Out(sim, nl, "out", 1), 0u); // lane 1 did not load
+
+    const Netlist big = Load("3/b", "RAM512"); // built-in RAM64 parts
+    Simulator mem{ big, 1 };
+    ASSERT_EQ(big.memories.size(), 8u); // address[0..2] selects the RAM64
+    mem.SetBus(big.FindInput("in")->bits, 0, 77);
+    mem.SetBus(big.FindInput("load")->bits, 0, 1);
+    mem.SetBus(big.FindInput("address")->bits, 0, 0b101000011);
+    mem.Tick();
+    mem.Tock();
+    EXPECT_EQ(mem.ReadMemory(big.memories[3], 0b101000), 77);
+    EXPECT_EQ(Out(mem, big, "out", 0), 77u);
+}
+
+// Same outputs in every mode; event driven RAM4K touches a fraction of the gates
+TEST(SimulatorTest, EventDrivenMatchesLevelized)
+{
+    for (const auto& [dir, chip] : { std::pair{ "3/b", "RAM4K" }, std::pair{ "3/a", "PC" } }) {
+        const Netlist nl = Load(dir, chip);
+        Simulator levelized{ nl, 1 }, events{ nl, 1 }, automatic{ nl, 1 };
+        levelized.SetMode(Simulator::Mode::Levelized);
+        events.SetMode(Simulator::Mode::EventDriven);
+        Simulator* sims[] = { &levelized, &events, &automatic };
+
+        std::mt19937 rng{ 5 };
+        const int cycles = 300;
+        for (int cycle = 0; cycle < cycles; cycle++) {
+            // a few inputs change per cycle
+            const Hdl::Bus& bus = nl.inputs[rng() % nl.inputs.size()];
+            const std::uint64_t v = rng();
+            for (Simulator* sim : sims) {
+                sim->SetBus(bus.bits, 0, v);
+                sim->Tick();
+                sim->Tock();
+            }
+            const std::uint64_t out = Out(levelized, nl, "out", 0);
+            ASSERT_EQ(Out(events, nl, "out", 0), out) << chip << " " << cycle;
+            ASSERT_EQ(Out(automatic, nl, "out", 0), out) << chip << " " << cycle;
+        }
+
+        EXPECT_EQ(levelized.Evaluated(), 2u * cycles * nl.order.size());
+        if (std::string(chip) == "RAM4K") {
+            EXPECT_LT(events.Evaluated() * 10, levelized.Evaluated()) << events.Evaluated();
+            EXPECT_LT(automatic.Evaluated() * 5, levelized.Evaluated()) << automatic.Evaluated();
+        }
+    }
+}
@@ -0,0 +1,110 @@
+// Tests for Hdl::RunTestScript
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "../test_script.h"
+
+// Test fixture for scripts written to a temporary directory
+class HdlScriptTest : public ::testing::Test
+{
+  protected:
+    std::string dir;
+    std::vector<std::string> files;
+
+    void SetUp() override
+    {
+        dir = std::string("/tmp/hdl_tst_test_") + std::to_string(::getpid()) + "_" +
+              std::to_string(::rand());
+        ASSERT_EQ(::mkdir(dir.c_str(), 0700), 0);
+    }
+
+    void TearDown() override
+    {
+        for (auto&& f : files) {
+            std::remove(f.c_str());
+        }
+        ::rmdir(dir.c_str());
+    }
+
+    std::string Write(const std::string& name, const std::string& text)
+    {
+        const std::string path = dir + "/" + name;
+        std::ofstream out(path);
+        out << text;
+        files.push_back(path);
+        return path;
+    }
+};
+
+// a counter register: out(t+1) = load ? in : out + 1
+static const std::string COUNTER_HDL = "CHIP Counter { IN in[16], load; OUT out[16]; PARTS:\n"
+                                       "    Inc16(in=r, out=r1);\n"
+                                       "    Mux16(a=r1, b=in, sel=load, out=next);\n"
+                                       "    DRegister(in=next, load=true, out=r, out=out);\n"
+                                       "}\n";
+
+TEST_F(HdlScriptTest, ClockedScript)
+{
+    Write("Counter.hdl", COUNTER_HDL);
+    // DRegister[] shows the sampled value between tick and tock
+    Write("Counter.cmp", "|time |  out   |  in  |load|DRegister[]|\n"
+                         "| 0+  |      0 |   -3 | 1  |      -3   |\n"
+                         "| 1   |     -3 |   -3 | 1  |      -3   |\n"
+                         "| 1+  |     -3 |   -3 | 0  |      -2   |\n"
+                         "| 2   |     -2 |   -3 | 0  |      -2   |\n"
+                         "| 2+  |     -2 |   -3 | 0  |      -1   |\n"
+                         "| 3   |     -1 |   -3 | 0  |      -1   |\n");
+    const std::string tst = Write("Counter.tst",
+                                  "load Counter.hdl, output-file Counter.out, compare-to Counter.cmp,\n"
+                                  "output-list time%S1.3.1 out%D1.6.1 in%D1.4.1 load%B1.1.2 DRegister[]%D1.7.3;\n"
+                                  "set in -3, set load 1, tick, output; tock, output;\n"
+                                  "echo \"load done, counting\";\n"
+                                  "set load 0;\n"
+                                  "repeat 2 { tick, output; tock, output; }\n");
+
+    const Hdl::ScriptResult r = Hdl::RunTestScript(tst, { PROJECTS_DIR "/1", PROJECTS_DIR "/2" });
+    EXPECT_TRUE(r.passed) << r.error;
+    EXPECT_EQ(r.compared, 7u);
+    EXPECT_EQ(r.dffs, 16u);
+    EXPECT_EQ(r.evals, 6u);
+}
+
+TEST_F(HdlScriptTest, ReportsMismatch)
+{
+    Write("Counter.hdl", COUNTER_HDL);
+    Write("Counter.cmp", "|  out   |\n|      1 |\n");
+    const std::string tst = Write("Counter.tst", "load Counter.hdl, compare-to Counter.cmp,\n"
+                                                 "output-list out%D1.6.1;\n"
+                                                 "set in 5, set load 1, tick, tock, output;\n");
+
+    const Hdl::ScriptResult r = Hdl::RunTestScript(tst, { PROJECTS_DIR "/1", PROJECTS_DIR "/2" });
+    EXPECT_FALSE(r.passed);
+    EXPECT_NE(r.error.find("line 2"), std::string::npos) << r.error;
+}
+
+TEST_F(HdlScriptTest, ReportsMissingPart)
+{
+    Write("Counter.hdl", COUNTER_HDL);
+    const std::string tst = Write("Counter.tst", "load Counter.hdl, output;\n");
+
+    const Hdl::ScriptResult r = Hdl::RunTestScript(tst, {});
+    EXPECT_FALSE(r.passed);
+    EXPECT_NE(r.error.find("Inc16 not found"), std::string::npos) << r.error;
+}
+
+// The course's own scripts for the chips of this repository
+TEST(HdlProjectScripts, Pass)
+{
+    const std::vector<std::string> paths = { PROJECTS_DIR "/1", PROJECTS_DIR "/2", PROJECTS_DIR "/3/a",
+                                             PROJECTS_DIR "/3/b" };
+    for (const char* script : { "1/Xor.tst", "1/Mux8Way16.tst", "1/DMux8Way.tst", "2/ALU.tst",
+                                "3/a/PC.tst", "3/a/RAM64.tst", "5/CPU.tst" }) {
+        const Hdl::ScriptResult r = Hdl::RunTestScript(PROJECTS_DIR "/" + std::string(script), paths);
+        EXPECT_TRUE(r.passed) << script << ": " << r.error;
+    }
+}
@@ -0,0 +1,351 @@
+#include "test_script.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+#include "../emu/script.h"
+#include "library.h"
+#include "netlist.h"
+#include "optimizer.h"
+#include "simulator.h"
+
+namespace Hdl {
+
+namespace fs = std::filesystem;
+
+using Emu::Column;
+using Emu::CompareFile;
+using Emu::ScriptCommand;
+
+// Executes a parsed hardware simulator script on a single-lane Simulator
+class ScriptRunner
+{
+  public:
+    ScriptRunner(const fs::path& dir, const std::vector<std::string>& paths, bool optimize,
+                 ScriptResult& result)
+      : _dir(dir)
+      , _result(result)
+      , _optimize(optimize)
+    {
+        _library.SetTopDir(dir.string());
+        for (auto&& p : paths) {
+            _library.AddPath(p);
+        }
+    }
+
+    bool Exec(const std::vector<ScriptCommand>& commands);
+    bool Finish();
+
+  private:
+    bool Exec(const ScriptCommand& cmd);
+    bool Fail(const std::string& error)
+    {
+        _result.error = error;
+        return false;
+    }
+
+    bool Load(const std::string& name);
+    bool Clock(const std::string& what);
+
+    // Splits `Name[i]` / `Name[]`; index is -1 without brackets or for `[]`
+    bool Split(const std::string& name, std::string& base, int& index) const;
+    bool Get(const std::string& name, std::uint64_t& v, std::size_t& width) const;
+    bool Set(const std::string& name, std::uint16_t v);
+    bool Emit(const std::string& line);
+
+    fs::path _dir;
+    ScriptResult& _result;
+    bool _optimize;
+
+    Library _library;
+    Netlist _netlist;
+    std::unique_ptr<Simulator> _sim;
+    std::vector<Column> _columns;
+    std::uint64_t _time{ 0 };
+    bool _ticked{ false }; // between tick and tock: time prints as "N+"
+
+    CompareFile _cmp;
+};
+
+bool
+ScriptRunner::Exec(const std::vector<ScriptCommand>& commands)
+{
+    for (auto&& cmd : commands) {
+        if (!Exec(cmd)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+ScriptRunner::Exec(const ScriptCommand& cmd)
+{
+    const std::string& op = cmd.words[0];
+    const std::size_t n   = cmd.words.size();
+
+    if (op == "repeat") {
+        for (std::uint64_t i = 0; i < cmd.repeat; i++) {
+            if (!Exec(cmd.body)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if (op == "load" && n == 2) {
+        return Load(cmd.words[1]);
+    }
+
+    if (op == "ROM32K" && n == 3 && cmd.words[1] == "load") {
+        std::string error;
+        if (!_sim) {
+            return Fail("ROM32K load before load");
+        }
+        return _sim->LoadRom((_dir / cmd.words[2]).string(), error) ? true : Fail(error);
+    }
+
+    if (op == "compare-to" && n == 2) {
+        return _cmp.Open((_dir / cmd.words[1]).string()) ? true
+                                                         : Fail("cannot open " + cmd.words[1]);
+    }
+
+    if (op == "output-list") {
+        _columns.clear();
+        std::string header = "|";
+        for (std::size_t i = 1; i < n; i++) {
+            Column col;
+            if (!Emu::ParseColumn(cmd.words[i], col)) {
+                return Fail("invalid output-list entry " + cmd.words[i]);
+            }
+            // a bare name prints in binary, as wide as the pin
+            std::uint64_t v;
+            std::size_t width;
+            if (cmd.words[i].find('%') == std::string::npos && Get(col.name, v, width)) {
+                col.width = width;
+            }
+            _columns.push_back(col);
+            header += Emu::FormatHeader(col) + "|";
+        }
+        return Emit(header);
+    }
+
+    if (op == "output") {
+        std::string line = "|";
+        for (auto&& col : _columns) {
+            if (col.name == "time") {
+                const std::string t = std::to_string(_time) + (_ticked ? "+" : "");
+                line += Emu::FormatString(col, t) + "|";
+                continue;
+            }
+            std::uint64_t v;
+            std::size_t width;
+            if (!Get(col.name, v, width)) {
+                return Fail("unknown variable " + col.name);
+            }
+            line += Emu::FormatValue(col, static_cast<std::uint16_t>(v), width) + "|";
+        }
+        return Emit(line);
+    }
+
+    if (op == "set" && n == 3) {
+        std::uint16_t v;
+        if (!Emu::ParseValue(cmd.words[2], v)) {
+            return Fail("invalid value " + cmd.words[2]);
+        }
+        return Set(cmd.words[1], v) ? true : Fail("unknown variable " + cmd.words[1]);
+    }
+
+    if (op == "eval" || op == "tick" || op == "tock") {
+        return Clock(op);
+    }
+
+    if (op == "output-file" || op == "echo" || op == "clear-echo") {
+        return true;
+    }
+
+    return Fail("unsupported command " + op);
+}
+
+bool
+ScriptRunner::Load(const std::string& name)
+{
+    if (fs::path(name).extension() != ".hdl") {
+        return Fail("not an .hdl file: " + name);
+    }
+
+    std::string error;
+    MemoryRecognizer memories{ _library };
+    if (!Flatten(_library, fs::path(name).stem().string(), _netlist, error,
+                 _optimize ? memories.Options() : FlattenOptions{})) {
+        return Fail(error);
+    }
+    if (_optimize) {
+        Optimize(_netlist);
+    }
+
+    _sim          = std::make_unique<Simulator>(_netlist, 1);
+    _time         = 0;
+    _ticked       = false;
+    _result.nands = _netlist.nands.size();
+    _result.dffs  = _netlist.dffs.size();
+    return true;
+}
+
+bool
+ScriptRunner::Clock(const std::string& what)
+{
+    if (!_sim) {
+        return Fail(what + " before load");
+    }
+
+    if (what == "eval") {
+        _sim->Eval();
+    } else if (what == "tick") {
+        _sim->Tick();
+        _ticked = true;
+    } else {
+        _sim->Tock();
+        _ticked = false;
+        _time++;
+    }
+    _result.evals++;
+    _result.nodes = _sim->Evaluated();
+    return true;
+}
+
+bool
+ScriptRunner::Split(const std::string& name, std::string& base, int& index) const
+{
+    const auto open = name.find('[');
+    base            = name.substr(0, open);
+    index           = -1;
+    if (open == std::string::npos) {
+        return true;
+    }
+    if (name.back() != ']') {
+        return false;
+    }
+
+    const std::string inside = name.substr(open + 1, name.size() - open - 2);
+    if (inside.empty()) {
+        return true;
+    }
+    std::uint16_t i;
+    if (!Emu::ParseValue(inside, i)) {
+        return false;
+    }
+    index = i;
+    return true;
+}
+
+bool
+ScriptRunner::Get(const std::string& name, std::uint64_t& v, std::size_t& width) const
+{
+    std::string base;
+    int index;
+    if (!_sim || !Split(name, base, index)) {
+        return false;
+    }
+
+    const Bus* bus = _netlist.FindInput(base);
+    if (!bus) {
+        bus = _netlist.FindOutput(base);
+    }
+    if (bus && base == name) {
+        v     = _sim->GetBus(bus->bits, 0);
+        width = bus->bits.size();
+        return true;
+    }
+
+    if (base == name) {
+        return false;
+    }
+
+    const MemoryBlock* m = _sim->FindMemory(base);
+    if (m && index >= 0) {
+        v     = _sim->ReadMemory(*m, static_cast<std::size_t>(index));
+        width = 16;
+        return true;
+    }
+
+    // ARegister[] and ARegister[0] both mean the register's value
+    const auto probe = _netlist.probes.find(base);
+    if (probe != _netlist.probes.end()) {
+        v     = _sim->GetState(probe->second, 0);
+        width = probe->second.size();
+        return true;
+    }
+    return false;
+}
+
+bool
+ScriptRunner::Set(const std::string& name, std::uint16_t v)
+{
+    std::string base;
+    int index;
+    if (!_sim || !Split(name, base, index)) {
+        return false;
+    }
+
+    const Bus* bus = _netlist.FindInput(base);
+    if (bus && base == name) {
+        _sim->SetBus(bus->bits, 0, v);
+        return true;
+    }
+
+    const MemoryBlock* m = _sim->FindMemory(base);
+    if (m && index >= 0) {
+        _sim->WriteMemory(*m, static_cast<std::size_t>(index), v);
+        return true;
+    }
+    return false;
+}
+
+bool
+ScriptRunner::Emit(const std::string& line)
+{
+    std::string error;
+    if (!_cmp.Check(line, error)) {
+        return Fail(error);
+    }
+    _result.compared = _cmp.Compared();
+    return true;
+}
+
+bool
+ScriptRunner::Finish()
+{
+    std::string error;
+    return _cmp.Finish(error) ? true : Fail(error);
+}
+
+ScriptResult
+RunTestScript(const std::string& path, const std::vector<std::string>& paths, bool optimize)
+{
+    const auto start = std::chrono::steady_clock::now();
+    ScriptResult result;
+
+    std::ifstream in{ path };
+    if (!in) {
+        result.error = "cannot open " + path;
+        return result;
+    }
+    std::stringstream ss;
+    ss << in.rdbuf();
+
+    std::vector<ScriptCommand> commands;
+    if (Emu::ParseScript(ss.str(), commands, result.error)) {
+        ScriptRunner runner{ fs::path(path).parent_path(), paths, optimize, result };
+        result.passed = runner.Exec(commands) && runner.Finish();
+    }
+
+    result.ms =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+} // namespace Hdl
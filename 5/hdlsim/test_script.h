@@ -0,0 +1,45 @@
+#ifndef HDL_TEST_SCRIPT_HH
+#define HDL_TEST_SCRIPT_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Hdl {
+
+// Outcome of one .tst script
+struct ScriptResult
+{
+    bool passed{ false };
+    std::size_t nands{ 0 };    // size of the flattened chip
+    std::size_t dffs{ 0 };
+    std::uint64_t evals{ 0 };  // eval, tick and tock commands
+    std::uint64_t nodes{ 0 };  // gates and memory reads evaluated by them
+    std::size_t compared{ 0 }; // output lines matched against the .cmp file
+    std::string error;         // first failure
+    double ms{ 0 };
+};
+
+// Runs a test script of the course's hardware simulator.
+//
+// Supported commands: load X.hdl, output-file, compare-to, output-list,
+// output, set, eval, tick, tock, repeat N { ... }, echo, clear-echo and
+// `ROM32K load X.hack`. Every `output` line is compared with the next line
+// of the compare-to file as soon as it is produced; the .out file is not
+// written.
+//
+// Variables: the pins of the loaded chip, time, `Chip[]` (the output of the
+// first instance of a part, e.g. DRegister[] or PC[]) and `Memory[i]` (word
+// i of the first built-in memory of that name, e.g. RAM16K[0]).
+//
+// Parts are looked up next to the script's chip first, then among the
+// built-ins, then in `paths`. With `optimize` the chip's RAM parts are
+// replaced by memories where they behave like one, and the netlist goes
+// through Optimize().
+ScriptResult
+RunTestScript(const std::string& path, const std::vector<std::string>& paths, bool optimize = false);
+
+} // namespace Hdl
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef ASM_ARENA_HH
+#define ASM_ARENA_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Asm {
+
+// Bump allocator for short-lived IR and instruction listings
+// Allocation advances a pointer in the current chunk; Reset() rewinds to the
+// first chunk and keeps every chunk for reuse, so memory stays at the peak
+// of the largest unit between two resets. Destructors are never run.
+class Arena
+{
+  public:
+    static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
+    Arena() = default;
+    Arena(const Arena&)            = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* Allocate(std::size_t size, std::size_t align)
+    {
+        while (_chunk < _chunks.size()) {
+            Chunk& c                = _chunks[_chunk];
+            const std::size_t start = (_used + align - 1) & ~(align - 1);
+            if (start + size <= c.size) {
+                _used = start + size;
+                return c.data.get() + start;
+            }
+            _chunk++;
+            _used = 0;
+        }
+
+        // larger requests get a chunk of their own
+        const std::size_t chunk_size = std::max(CHUNK_SIZE, size + align);
+        _chunks.push_back({ std::make_unique<std::byte[]>(chunk_size), chunk_size });
+        _capacity += chunk_size;
+        return Allocate(size, align);
+    }
+
+    template <class T>
+    T* AllocateArray(std::size_t n)
+    {
+        static_assert(std::is_trivially_destructible_v<T>);
+        return static_cast<T*>(Allocate(sizeof(T) * n, alignof(T)));
+    }
+
+    template <class T, class... Args>
+    T* New(Args&&... args)
+    {
+        static_assert(std::is_trivially_destructible_v<T>);
+        return ::new (Allocate(sizeof(T), alignof(T))) T{ std::forward<Args>(args)... };
+    }
+
+    // Copies `s` into the arena
+    std::string_view Copy(std::string_view s)
+    {
+        if (s.empty()) {
+            return {};
+        }
+        char* p = AllocateArray<char>(s.size());
+        std::memcpy(p, s.data(), s.size());
+        return { p, s.size() };
+    }
+
+    // Frees everything allocated so far at once
+    void Reset()
+    {
+        _chunk = 0;
+        _used  = 0;
+    }
+
+    // Bytes handed out since the last Reset(), counting the unused tails of full chunks
+    std::size_t Used() const
+    {
+        std::size_t used = _used;
+        for (std::size_t i = 0; i < _chunk; i++) {
+            used += _chunks[i].size;
+        }
+        return used;
+    }
+
+    // Bytes held from the system
+    std::size_t Capacity() const { return _capacity; }
+
+  private:
+    struct Chunk
+    {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size;
+    };
+
+    std::vector<Chunk> _chunks;
+    std::size_t _chunk{ 0 }; // index of the chunk being filled
+    std::size_t _used{ 0 };  // bytes used in it
+    std::size_t _capacity{ 0 };
+};
+
+// Growable array in an Arena. Growing copies into a new block of twice the
+// size and abandons the old one until the next Reset().
+template <class T>
+class ArenaVector
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+
+  public:
+    explicit ArenaVector(Arena& arena)
+      : _arena(&arena)
+    {
+    }
+
+    void push_back(const T& v)
+    {
+        if (_size == _capacity) {
+            const std::size_t capacity = std::max<std::size_t>(16, _capacity * 2);
+            T* data                    = _arena->AllocateArray<T>(capacity);
+            if (_size) {
+                std::memcpy(data, _data, sizeof(T) * _size);
+            }
+            _data     = data;
+            _capacity = capacity;
+        }
+        _data[_size++] = v;
+    }
+
+    // Forgets the elements; call after the arena was reset
+    void clear()
+    {
+        _data     = nullptr;
+        _size     = 0;
+        _capacity = 0;
+    }
+
+    T* begin() { return _data; }
+    T* end() { return _data + _size; }
+    const T* begin() const { return _data; }
+    const T* end() const { return _data + _size; }
+    T& operator[](std::size_t i) { return _data[i]; }
+    const T& operator[](std::size_t i) const { return _data[i]; }
+    T& back() { return _data[_size - 1]; }
+    std::size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+  private:
+    Arena* _arena;
+    T* _data{ nullptr };
+    std::size_t _size{ 0 };
+    std::size_t _capacity{ 0 };
+};
+
+} // namespace Asm
+
+#endif
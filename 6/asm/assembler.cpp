@@ -0,0 +1,188 @@
+#include "assembler.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <system_error>
+
+#include "parser.h"
+
+namespace Asm {
+
+static bool
+IsNumber(const std::string& s)
+{
+    return std::ranges::all_of(s, [](const char c) { return std::isdigit(c) != 0; });
+}
+
+static void
+Read(Parser& p, Listing& listing)
+{
+    while (p.HasMoreLines()) {
+        // 1行読み取り
+        p.Advance();
+
+        switch (p.InstructionType()) {
+            case Parser::Instruction::A: {
+                const std::string symbol = p.Symbol();
+                if (IsNumber(symbol)) {
+                    unsigned value{ 0 };
+                    const auto r = std::from_chars(symbol.data(), symbol.data() + symbol.size(), value);
+                    if (r.ec != std::errc{} || value > 0x7FFF) {
+                        std::cerr << "Constant out of range: " << p.Current() << std::endl;
+                        break;
+                    }
+                    listing.Append(Literal(static_cast<std::uint16_t>(value)));
+                } else {
+                    listing.At(symbol);
+                }
+            } break;
+
+            case Parser::Instruction::C: {
+                // the parser only accepts known mnemonics
+                listing.C(EncodeC(p.Dest(), p.Comp(), p.Jump()).value_or(0));
+            } break;
+
+            case Parser::Instruction::L: {
+                listing.Label(p.Symbol());
+            } break;
+
+            default:
+                break;
+        }
+    }
+}
+
+bool
+ReadAsm(const std::string& in_path, Listing& listing)
+{
+    if (!std::ifstream{ in_path }) {
+        std::cerr << "Failed to open file: " << in_path << std::endl;
+        return false;
+    }
+
+    Parser p{ in_path };
+    Read(p, listing);
+    return true;
+}
+
+void
+ParseAsm(std::span<const char> source, Listing& listing)
+{
+    Parser p{ source };
+    Read(p, listing);
+}
+
+void
+Assemble(const Listing& listing, Program& program)
+{
+    static constexpr std::size_t UNDEFINED = SIZE_MAX;
+
+    std::vector<std::size_t> address(listing.SymbolCount(), UNDEFINED);
+    for (Symbol s = 0; s < PREDEFINED_COUNT; s++) {
+        address[s] = PredefinedAddress(s);
+    }
+
+    // 1st path
+    size_t nol = 0;
+    for (const Instruction& i : listing.Code()) {
+        if (i.kind != Instruction::Kind::Label) {
+            // L以外の時増やす
+            nol++;
+        } else if (address[i.symbol] == UNDEFINED) {
+            address[i.symbol] = nol;
+            program.labels.emplace(listing.Name(i.symbol), nol);
+        }
+    }
+
+    // 2nd path
+    size_t next_addr = 16;
+    program.words.reserve(program.words.size() + nol);
+    for (const Instruction& i : listing.Code()) {
+        switch (i.kind) {
+            case Instruction::Kind::Literal:
+            case Instruction::Kind::C: {
+                program.words.push_back(i.word);
+            } break;
+
+            case Instruction::Kind::At: {
+                if (address[i.symbol] == UNDEFINED) {
+                    address[i.symbol] = next_addr++;
+                }
+                program.words.push_back(static_cast<std::uint16_t>(address[i.symbol] & 0x7FFF));
+            } break;
+
+            case Instruction::Kind::Label:
+                break;
+        }
+    }
+}
+
+bool
+Assemble(const std::string& in_path, Program& program)
+{
+    Listing listing;
+    if (!ReadAsm(in_path, listing)) {
+        return false;
+    }
+    Assemble(listing, program);
+    return true;
+}
+
+// Writes to out_path through a sink
+static bool
+WriteFile(const std::string& out_path, const std::function<void(const Sink&)>& write)
+{
+    std::ofstream out{ out_path, std::ios::out | std::ios::trunc | std::ios::binary };
+    if (!out) {
+        std::cerr << "Failed to open the file(" << out_path << ")\n";
+        return false;
+    }
+    write([&out](std::string_view s) { out.write(s.data(), static_cast<std::streamsize>(s.size())); });
+    return static_cast<bool>(out);
+}
+
+void
+WriteHack(const Program& program, const Sink& out)
+{
+    std::string text(program.words.size() * 17, '\n');
+    for (std::size_t i = 0; i < program.words.size(); i++) {
+        for (int bit = 0; bit < 16; bit++) {
+            text[i * 17 + bit] = (program.words[i] >> (15 - bit)) & 1 ? '1' : '0';
+        }
+    }
+    out(text);
+}
+
+bool
+WriteHack(const Program& program, const std::string& out_path)
+{
+    return WriteFile(out_path, [&program](const Sink& out) { WriteHack(program, out); });
+}
+
+void
+WriteSymbols(const Program& program, const Sink& out)
+{
+    std::vector<std::pair<std::size_t, std::string>> sorted;
+    for (auto&& [label, addr] : program.labels) {
+        sorted.emplace_back(addr, label);
+    }
+    std::ranges::sort(sorted);
+
+    std::string text;
+    for (auto&& [addr, label] : sorted) {
+        text += label + " " + std::to_string(addr) + "\n";
+    }
+    out(text);
+}
+
+bool
+WriteSymbols(const Program& program, const std::string& out_path)
+{
+    return WriteFile(out_path, [&program](const Sink& out) { WriteSymbols(program, out); });
+}
+
+} // namespace Asm
@@ -0,0 +1,54 @@
+#ifndef ASM_ASSEMBLER_HH
+#define ASM_ASSEMBLER_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "listing.h"
+
+namespace Asm {
+
+struct Program
+{
+    std::vector<std::uint16_t> words;
+    // (LABEL) -> ROM address
+    std::map<std::string, std::size_t> labels;
+};
+
+// Two pass translation of an .asm file into machine words
+bool
+Assemble(const std::string& in_path, Program& program);
+
+// The same for instructions already in memory: labels are collected, then
+// the other symbols become variables from RAM[16] in order of first use
+void
+Assemble(const Listing& listing, Program& program);
+
+// Reads the instructions of an .asm file; lines that are not valid
+// instructions are skipped
+bool
+ReadAsm(const std::string& in_path, Listing& listing);
+
+// The same for assembly text in memory
+void
+ParseAsm(std::span<const char> source, Listing& listing);
+
+// One 16 character binary word per line, the format of .hack files
+void
+WriteHack(const Program& program, const Sink& out);
+bool
+WriteHack(const Program& program, const std::string& out_path);
+
+// "label address" per line, sorted by address
+void
+WriteSymbols(const Program& program, const Sink& out);
+bool
+WriteSymbols(const Program& program, const std::string& out_path);
+
+} // namespace Asm
+
+#endif
@@ -0,0 +1,43 @@
+// The mnemonic tables agree with themselves: every word EncodeC accepts is
+// written back by DestOf/CompOf/JumpOf as text that encodes to the same word,
+// and every C-instruction word with a known comp survives the opposite trip.
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+#include "../instruction.h"
+
+static std::string
+Text(std::uint16_t word)
+{
+    std::string text;
+    if (const auto dest = Asm::DestOf(word); !dest.empty()) {
+        text.append(dest).append("=");
+    }
+    text.append(Asm::CompOf(word));
+    if (const auto jump = Asm::JumpOf(word); !jump.empty()) {
+        text.append(";").append(jump);
+    }
+    return text;
+}
+
+extern "C" int
+LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)
+{
+    const std::string_view text{ reinterpret_cast<const char*>(data), size };
+    if (const auto word = Asm::EncodeC(text)) {
+        if (Asm::EncodeC(Text(*word)) != word) {
+            std::abort();
+        }
+    }
+
+    if (size >= 2) {
+        const auto word = static_cast<std::uint16_t>(0xE000 | data[0] << 8 | data[1]);
+        if (!Asm::CompOf(word).empty() && Asm::EncodeC(Text(word)) != word) {
+            std::abort();
+        }
+    }
+    return 0;
+}
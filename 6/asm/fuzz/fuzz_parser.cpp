@@ -0,0 +1,33 @@
+// Any text parses without crashing, and the listing it gives reads back
+// from its own .asm text into the same machine code.
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "../assembler.h"
+
+extern "C" int
+LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)
+{
+    const std::span<const char> source{ reinterpret_cast<const char*>(data), size };
+
+    Asm::Listing listing;
+    Asm::ParseAsm(source, listing);
+    Asm::Program program;
+    Asm::Assemble(listing, program);
+
+    std::string text;
+    Asm::WriteAsm(listing, [&text](std::string_view s) { text += s; });
+    Asm::Listing again;
+    Asm::ParseAsm(text, again);
+    Asm::Program round_trip;
+    Asm::Assemble(again, round_trip);
+
+    if (round_trip.words != program.words || round_trip.labels != program.labels) {
+        std::abort();
+    }
+    return 0;
+}
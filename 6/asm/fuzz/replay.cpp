@@ -0,0 +1,50 @@
+// Runs a libFuzzer harness over files when the compiler has no libFuzzer:
+//   fuzz_x <file|dir>...
+// Directories are searched recursively. Exits non-zero when an argument
+// cannot be read; a failing input aborts like it would under the fuzzer.
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+extern "C" int
+LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size);
+
+static void
+RunOne(const std::filesystem::path& path)
+{
+    std::ifstream in{ path, std::ios::binary };
+    const std::string input{ std::istreambuf_iterator<char>{ in }, std::istreambuf_iterator<char>{} };
+    LLVMFuzzerTestOneInput(reinterpret_cast<const std::uint8_t*>(input.data()), input.size());
+}
+
+int
+main(int argc, char const* argv[])
+{
+    namespace fs = std::filesystem;
+
+    std::size_t inputs = 0;
+    for (int i = 1; i < argc; i++) {
+        const fs::path path{ argv[i] };
+        if (fs::is_directory(path)) {
+            for (auto&& entry : fs::recursive_directory_iterator{ path }) {
+                if (entry.is_regular_file()) {
+                    RunOne(entry.path());
+                    inputs++;
+                }
+            }
+        } else if (fs::is_regular_file(path)) {
+            RunOne(path);
+            inputs++;
+        } else {
+            std::cerr << "Failed to open: " << path << "\n";
+            return 1;
+        }
+    }
+
+    std::cout << inputs << " inputs\n";
+    return 0;
+}
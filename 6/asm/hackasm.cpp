@@ -1,13 +1,12 @@
 // Simple example program for CMake demonstration
-#include <algorithm>
 #include <bitset>
 #include <fstream>
 #include <iostream>
-#include <sstream>
+#include <string>
+#include <vector>
 
-#include "code.h"
-#include "parser.h"
-#include "symbol_table.h"
+#include "assembler.h"
+#include "object.h"
 
 class Writer
 {
@@ -37,112 +36,107 @@ class Writer
     }
 };
 
-std::string
-itob(const size_t addr)
+void
+Usage()
 {
-    std::bitset<15> bits{ addr };
-    return bits.to_string();
+    std::cout << "Usage: hackasm <in-path> <out-path> [sym-path]";
+    std::cout << "  in-path  : path to .asm file";
+    std::cout << "  out-path : path to .bin file";
+    std::cout << "  sym-path : path to write the label addresses to (optional)";
+    std::cout << "\n";
+    std::cout << "       hackasm -c <in-path> <obj-path>\n";
+    std::cout << "  assembles to a relocatable object without resolving symbols\n";
+    std::cout << "       hackasm -l <out-path> <in-path>... [--sym sym-path]\n";
+    std::cout << "  links objects (.o) and .asm files into one .hack file\n";
 }
 
-bool
-IsNumber(const std::string& s)
+// hackasm -c in.asm out.o
+static int
+CompileOnly(const std::string& in_path, const std::string& obj_path)
 {
-    return std::ranges::all_of(s, [](const char c) { return std::isdigit(c) != 0; });
+    Asm::Listing listing;
+    if (!Asm::ReadAsm(in_path, listing)) {
+        return -1;
+    }
+    Asm::Object object;
+    Asm::Compile(listing, object);
+    return Asm::WriteObject(object, obj_path) ? 0 : -1;
 }
 
-void
-Usage()
+// hackasm -l out.hack in... [--sym path]
+static int
+LinkAll(int argc, char** argv)
 {
-    std::cout << "Usage: hackasm <in-path> <out-path>";
-    std::cout << "  in-path  : path to .asm file";
-    std::cout << "  out-path : path to .bin file";
+    const std::string out_path = argv[2];
+    std::string sym_path;
+    std::vector<Asm::Object> objects;
+
+    for (int i = 3; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--sym" && i + 1 < argc) {
+            sym_path = argv[++i];
+            continue;
+        }
+
+        Asm::Object& object = objects.emplace_back();
+        if (arg.ends_with(".o")) {
+            if (!Asm::ReadObject(arg, object)) {
+                return -1;
+            }
+        } else {
+            Asm::Listing listing;
+            if (!Asm::ReadAsm(arg, listing)) {
+                return -1;
+            }
+            Asm::Compile(listing, object);
+        }
+    }
+    if (objects.empty()) {
+        Usage();
+        return -1;
+    }
+
+    Asm::Program program;
+    Asm::Link(objects, program);
+    if (!Asm::WriteHack(program, out_path)) {
+        return -1;
+    }
+    if (!sym_path.empty() && !Asm::WriteSymbols(program, sym_path)) {
+        return -1;
+    }
+    return 0;
 }
 
 int
 main(int argc, char** argv)
 {
-    if (argc != 3) {
+    if (argc == 4 && std::string{ argv[1] } == "-c") {
+        return CompileOnly(argv[2], argv[3]);
+    }
+    if (argc >= 4 && std::string{ argv[1] } == "-l") {
+        return LinkAll(argc, argv);
+    }
+
+    if (argc != 3 && argc != 4) {
         Usage();
         return -1;
     }
 
     const std::string in_path = argv[1];
     const std::string out_path = argv[2];
-    Writer w{ out_path };
 
-    SymbolTable tbl;
-    size_t next_addr = 16;
-
-    // 1st path
-    {
-        Asm::Parser p{ in_path };
-        for (size_t nol = 0; p.HasMoreLines();) {
-            p.Advance();
-
-            switch (p.InstructionType()) {
-                case Asm::Parser::Instruction::L: {
-                    const std::string symbol = p.Symbol();
-                    if (!tbl.Contains(symbol)) {
-                        tbl.AddEntry(symbol, nol);
-                    }
-                } break;
-
-                case Asm::Parser::Instruction::C:
-                case Asm::Parser::Instruction::A: {
-                    // L以外の時増やす
-                    nol++;
-                } break;
-
-                default:
-                    break;
-            }
-        }
+    Asm::Program program;
+    if (!Asm::Assemble(in_path, program)) {
+        return -1;
     }
 
-    // 2nd path
-    Asm::Parser p{ in_path };
-    while (p.HasMoreLines()) {
-        // 1行読み取り
-        p.Advance();
-
-        // 変換
-        std::stringstream line;
-        switch (p.InstructionType()) {
-            case Asm::Parser::Instruction::A: {
-                line << "0";
-                const std::string symbol = p.Symbol();
-                int addr{ 0 };
-                if (IsNumber(symbol)) {
-                    addr = std::stoi(symbol);
-                } else {
-                    if (!tbl.Contains(symbol)) {
-                        tbl.AddEntry(symbol, next_addr);
-                        next_addr++;
-                    }
-
-                    addr = tbl.GetAddress(symbol);
-                }
-
-                line << itob(addr);
-            } break;
-
-            case Asm::Parser::Instruction::C: {
-                const auto d = p.Dest();
-                const auto c = p.Comp();
-                const auto j = p.Jump();
-
-                line << "111";
-                line << (c.find('M') != std::string::npos ? "1" : "0");
-                line << Asm::Comp(c) << Asm::Dest(d) << Asm::Jump(j);
-            } break;
-
-            case Asm::Parser::Instruction::L:
-            default:
-                break;
-        }
+    Writer w{ out_path };
+    for (const auto word : program.words) {
+        w.WriteNextLine(std::bitset<16>{ word }.to_string());
+    }
 
-        // 書き込み
-        w.WriteNextLine(line.str());
+    if (argc == 4 && !Asm::WriteSymbols(program, argv[3])) {
+        return -1;
     }
 
     return 0;
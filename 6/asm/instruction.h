@@ -0,0 +1,219 @@
+#ifndef ASM_INSTRUCTION_HH
+#define ASM_INSTRUCTION_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace Asm {
+
+// Index of a name in a Listing
+using Symbol = std::uint32_t;
+
+// Symbols every Listing starts with, in this order
+enum Predefined : Symbol
+{
+    SP,
+    LCL,
+    ARG,
+    THIS,
+    THAT,
+    R0,
+    R13 = R0 + 13,
+    R14,
+    R15,
+    SCREEN,
+    KBD,
+    PREDEFINED_COUNT
+};
+
+inline constexpr std::string_view PREDEFINED_NAMES[PREDEFINED_COUNT] = {
+    "SP", "LCL", "ARG", "THIS", "THAT", "R0",  "R1",  "R2",  "R3",     "R4",  "R5",
+    "R6", "R7",  "R8",  "R9",   "R10",  "R11", "R12", "R13", "R14",    "R15", "SCREEN",
+    "KBD",
+};
+
+inline constexpr std::uint16_t
+PredefinedAddress(Symbol s)
+{
+    if (s == SCREEN) {
+        return 16384;
+    }
+    if (s == KBD) {
+        return 24576;
+    }
+    return s < R0 ? static_cast<std::uint16_t>(s) : static_cast<std::uint16_t>(s - R0);
+}
+
+// Field of a C-instruction and its bits
+struct Mnemonic
+{
+    std::string_view text;
+    std::uint16_t bits;
+};
+
+// a c1..c6
+inline constexpr Mnemonic COMPS[] = {
+    {   "0", 0b0101010 }, {   "1", 0b0111111 }, {  "-1", 0b0111010 }, {   "D", 0b0001100 },
+    {   "A", 0b0110000 }, {  "!D", 0b0001101 }, {  "!A", 0b0110001 }, {  "-D", 0b0001111 },
+    {  "-A", 0b0110011 }, { "D+1", 0b0011111 }, { "A+1", 0b0110111 }, { "D-1", 0b0001110 },
+    { "A-1", 0b0110010 }, { "D+A", 0b0000010 }, { "D-A", 0b0010011 }, { "A-D", 0b0000111 },
+    { "D&A", 0b0000000 }, { "D|A", 0b0010101 }, {   "M", 0b1110000 }, {  "!M", 0b1110001 },
+    {  "-M", 0b1110011 }, { "M+1", 0b1110111 }, { "M-1", 0b1110010 }, { "D+M", 0b1000010 },
+    { "D-M", 0b1010011 }, { "M-D", 0b1000111 }, { "D&M", 0b1000000 }, { "D|M", 0b1010101 },
+    // operands swapped; only read, the names above are the ones written
+    { "A+D", 0b0000010 }, { "A&D", 0b0000000 }, { "A|D", 0b0010101 }, { "M+D", 0b1000010 },
+    { "M&D", 0b1000000 }, { "M|D", 0b1010101 },
+};
+
+inline constexpr Mnemonic DESTS[] = {
+    {  "M", 0b001 }, { "D", 0b010 },  { "DM", 0b011 },  { "A", 0b100 },
+    { "AM", 0b101 }, { "AD", 0b110 }, { "ADM", 0b111 },
+    // the spellings of the book; only read
+    { "MD", 0b011 }, { "AMD", 0b111 },
+};
+
+inline constexpr Mnemonic JUMPS[] = {
+    { "JGT", 0b001 }, { "JEQ", 0b010 }, { "JGE", 0b011 }, { "JLT", 0b100 },
+    { "JNE", 0b101 }, { "JLE", 0b110 }, { "JMP", 0b111 },
+};
+
+// Bits of `text` in `table`; an empty field is 0
+constexpr std::optional<std::uint16_t>
+Lookup(std::span<const Mnemonic> table, std::string_view text)
+{
+    if (text.empty()) {
+        return 0;
+    }
+    for (const Mnemonic& m : table) {
+        if (m.text == text) {
+            return m.bits;
+        }
+    }
+    return std::nullopt;
+}
+
+// Text of `bits` in `table`; empty when there is none
+constexpr std::string_view
+Lookup(std::span<const Mnemonic> table, std::uint16_t bits)
+{
+    for (const Mnemonic& m : table) {
+        if (m.bits == bits) {
+            return m.text;
+        }
+    }
+    return {};
+}
+
+// The 16 bit word of a C-instruction given by its fields
+constexpr std::optional<std::uint16_t>
+EncodeC(std::string_view dest, std::string_view comp, std::string_view jump)
+{
+    const auto d = Lookup(DESTS, dest);
+    const auto c = Lookup(COMPS, comp);
+    const auto j = Lookup(JUMPS, jump);
+    if (comp.empty() || !d || !c || !j) {
+        return std::nullopt;
+    }
+    return static_cast<std::uint16_t>(0b111 << 13 | *c << 6 | *d << 3 | *j);
+}
+
+// The word of `dest=comp;jump`, dest= and ;jump being optional
+constexpr std::optional<std::uint16_t>
+EncodeC(std::string_view text)
+{
+    std::string_view dest, jump;
+    if (const auto eq = text.find('='); eq != std::string_view::npos) {
+        dest = text.substr(0, eq);
+        text.remove_prefix(eq + 1);
+    }
+    if (const auto semicolon = text.find(';'); semicolon != std::string_view::npos) {
+        jump = text.substr(semicolon + 1);
+        text = text.substr(0, semicolon);
+    }
+    return EncodeC(dest, text, jump);
+}
+
+constexpr std::string_view
+DestOf(std::uint16_t word)
+{
+    return Lookup(DESTS, static_cast<std::uint16_t>(word >> 3 & 0b111));
+}
+
+constexpr std::string_view
+CompOf(std::uint16_t word)
+{
+    return Lookup(COMPS, static_cast<std::uint16_t>(word >> 6 & 0b1111111));
+}
+
+constexpr std::string_view
+JumpOf(std::uint16_t word)
+{
+    return Lookup(JUMPS, static_cast<std::uint16_t>(word & 0b111));
+}
+
+// One line of Hack assembly with its symbol resolved to an index.
+// A C-instruction is kept as its machine word.
+struct Instruction
+{
+    enum class Kind : std::uint8_t
+    {
+        Literal, // @123
+        At,      // @symbol
+        C,       // dest=comp;jump
+        Label    // (symbol)
+    };
+
+    Kind kind{ Kind::Literal };
+    std::uint16_t word{ 0 }; // value of a literal, or the C-instruction
+    Symbol symbol{ 0 };      // At and Label
+};
+
+// Cost of each Kind: every instruction is one ROM word and one cycle when
+// it runs, a label is neither
+inline constexpr int INSTRUCTION_COST[] = { 1, 1, 1, 0 };
+
+constexpr int
+Cost(std::span<const Instruction> code)
+{
+    int cost = 0;
+    for (const Instruction& i : code) {
+        cost += INSTRUCTION_COST[static_cast<std::size_t>(i.kind)];
+    }
+    return cost;
+}
+
+constexpr Instruction
+Literal(std::uint16_t value)
+{
+    return { Instruction::Kind::Literal, static_cast<std::uint16_t>(value & 0x7FFF), 0 };
+}
+
+constexpr Instruction
+At(Symbol symbol)
+{
+    return { Instruction::Kind::At, 0, symbol };
+}
+
+constexpr Instruction
+Label(Symbol symbol)
+{
+    return { Instruction::Kind::Label, 0, symbol };
+}
+
+// A C-instruction checked and encoded at compile time: C("AM=M-1")
+consteval Instruction
+C(std::string_view text)
+{
+    const auto word = EncodeC(text);
+    if (!word) {
+        throw "not a C-instruction";
+    }
+    return { Instruction::Kind::C, *word, 0 };
+}
+
+} // namespace Asm
+
+#endif
@@ -0,0 +1,132 @@
+#include "listing.h"
+
+#include <bit>
+#include <charconv>
+#include <functional>
+#include <iterator>
+#include <string>
+
+namespace Asm {
+
+Listing::Listing()
+  : _code(_arena)
+{
+    Clear();
+}
+
+std::size_t
+Listing::Slot(std::string_view name) const
+{
+    const std::size_t mask = _slots.size() - 1;
+    std::size_t i          = std::hash<std::string_view>{}(name) & mask;
+    while (_slots[i] != FREE && _names[_slots[i]] != name) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+void
+Listing::Rehash(std::size_t size)
+{
+    _slots.assign(size, FREE);
+    for (std::size_t s = 0; s < _names.size(); s++) {
+        _slots[Slot(_names[s])] = static_cast<Symbol>(s);
+    }
+}
+
+Symbol
+Listing::Intern(std::string_view name)
+{
+    const std::size_t slot = Slot(name);
+    if (_slots[slot] != FREE) {
+        return _slots[slot];
+    }
+
+    const Symbol s = static_cast<Symbol>(_names.size());
+    _names.push_back(_arena.Copy(name));
+    _slots[slot] = s;
+    if (2 * _names.size() > _slots.size()) {
+        Rehash(2 * _slots.size());
+    }
+    return s;
+}
+
+void
+Listing::Clear()
+{
+    if (_names.empty()) {
+        _names.assign(std::begin(PREDEFINED_NAMES), std::end(PREDEFINED_NAMES));
+        Rehash(std::bit_ceil(4 * _names.size()));
+    }
+    // latest first: each leaves the table as it was before it was added, so
+    // the probes of the ones before still find them
+    for (std::size_t s = _names.size(); s-- > PREDEFINED_COUNT;) {
+        _slots[Slot(_names[s])] = FREE;
+    }
+    _names.resize(PREDEFINED_COUNT);
+    _code.clear();
+    _arena.Reset();
+}
+
+static void
+AppendLine(const Listing& listing, const Instruction& i, std::string& buf)
+{
+    switch (i.kind) {
+        case Instruction::Kind::Literal: {
+            char digits[8];
+            const auto r = std::to_chars(digits, digits + sizeof(digits), i.word);
+            buf += '@';
+            buf.append(digits, static_cast<std::size_t>(r.ptr - digits));
+        } break;
+        case Instruction::Kind::At:
+            buf += '@';
+            buf.append(listing.Name(i.symbol));
+            break;
+        case Instruction::Kind::Label:
+            buf += '(';
+            buf.append(listing.Name(i.symbol));
+            buf += ')';
+            break;
+        case Instruction::Kind::C: {
+            const std::string_view dest = DestOf(i.word);
+            const std::string_view jump = JumpOf(i.word);
+            if (!dest.empty()) {
+                buf.append(dest);
+                buf += '=';
+            }
+            buf.append(CompOf(i.word));
+            if (!jump.empty()) {
+                buf += ';';
+                buf.append(jump);
+            }
+        } break;
+    }
+    buf += '\n';
+}
+
+void
+WriteAsm(const Listing& listing, const Sink& out)
+{
+    // lines are collected and written in blocks
+    std::string buf;
+    buf.reserve(64 * 1024);
+
+    for (const Instruction& i : listing.Code()) {
+        AppendLine(listing, i, buf);
+        if (buf.size() > 60 * 1024) {
+            out(buf);
+            buf.clear();
+        }
+    }
+    out(buf);
+}
+
+void
+AppendAsm(const Listing& listing, std::string& text)
+{
+    for (const Instruction& i : listing.Code()) {
+        AppendLine(listing, i, text);
+    }
+}
+
+} // namespace Asm
@@ -0,0 +1,87 @@
+#ifndef ASM_LISTING_HH
+#define ASM_LISTING_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "arena.h"
+#include "instruction.h"
+
+namespace Asm {
+
+// A Hack program as instructions, the form in which the VM translator
+// hands code to the assembler without printing and parsing text.
+// Instructions and symbol names live in an arena; symbols are interned,
+// so an instruction refers to a name by its index.
+class Listing
+{
+  public:
+    Listing();
+    Listing(const Listing&)            = delete;
+    Listing& operator=(const Listing&) = delete;
+
+    // Index of `name`, adding it on first use
+    Symbol Intern(std::string_view name);
+    std::string_view Name(Symbol symbol) const { return _names[symbol]; }
+    std::size_t SymbolCount() const { return _names.size(); }
+
+    void Append(const Instruction& instruction) { _code.push_back(instruction); }
+    void Append(std::span<const Instruction> instructions)
+    {
+        for (const Instruction& i : instructions) {
+            _code.push_back(i);
+        }
+    }
+    void Append(std::initializer_list<Instruction> instructions)
+    {
+        Append(std::span<const Instruction>{ instructions.begin(), instructions.size() });
+    }
+
+    void At(Symbol symbol) { Append(Asm::At(symbol)); }
+    void At(std::string_view name) { Append(Asm::At(Intern(name))); }
+    void Label(std::string_view name) { Append(Asm::Label(Intern(name))); }
+    void C(std::uint16_t word) { Append({ Instruction::Kind::C, word, 0 }); }
+
+    const ArenaVector<Instruction>& Code() const { return _code; }
+
+    // Drops the instructions and every symbol but the predefined ones
+    void Clear();
+
+    // Bytes held by the arena
+    std::size_t Capacity() const { return _arena.Capacity(); }
+
+  private:
+    static constexpr Symbol FREE = static_cast<Symbol>(-1);
+
+    // The slot of `name` in _slots, or the free one where it belongs
+    std::size_t Slot(std::string_view name) const;
+    void Rehash(std::size_t size);
+
+    Arena _arena;
+    ArenaVector<Instruction> _code;
+    std::vector<std::string_view> _names;
+    // Symbols by name with linear probing, at most half full. The table is
+    // kept over Clear(), so interning stops allocating once it has grown.
+    std::vector<Symbol> _slots;
+};
+
+// Receives output text, a block at a time
+using Sink = std::function<void(std::string_view)>;
+
+// Prints the listing as Hack assembly, one instruction per line
+void
+WriteAsm(const Listing& listing, const Sink& out);
+
+// The same appended to `text`, for a writer that keeps its own buffer
+void
+AppendAsm(const Listing& listing, std::string& text);
+
+} // namespace Asm
+
+#endif
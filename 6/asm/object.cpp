@@ -0,0 +1,239 @@
+#include "object.h"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+
+namespace Asm {
+
+void
+Compile(const Listing& listing, Object& object)
+{
+    static constexpr std::uint32_t NONE = UINT32_MAX;
+
+    // listing symbol -> index into object.symbols
+    std::vector<std::uint32_t> index(listing.SymbolCount(), NONE);
+    const auto symbol = [&](Asm::Symbol s) {
+        if (index[s] == NONE) {
+            index[s] = static_cast<std::uint32_t>(object.symbols.size());
+            object.symbols.push_back({ std::string{ listing.Name(s) }, Object::Symbol::UNDEFINED });
+        }
+        return index[s];
+    };
+
+    for (const Instruction& i : listing.Code()) {
+        const auto offset = static_cast<std::uint32_t>(object.code.size());
+        switch (i.kind) {
+            case Instruction::Kind::Literal:
+            case Instruction::Kind::C: {
+                object.code.push_back(i.word);
+            } break;
+
+            case Instruction::Kind::At: {
+                if (i.symbol < PREDEFINED_COUNT) {
+                    object.code.push_back(PredefinedAddress(i.symbol));
+                } else {
+                    object.relocations.push_back({ offset, symbol(i.symbol) });
+                    object.code.push_back(0);
+                }
+            } break;
+
+            case Instruction::Kind::Label: {
+                // the first definition wins, as in Assemble
+                Object::Symbol& s = object.symbols[symbol(i.symbol)];
+                if (!s.Defined()) {
+                    s.offset = offset;
+                }
+            } break;
+        }
+    }
+}
+
+void
+Link(std::span<const Object> objects, Program& program)
+{
+    std::vector<std::uint32_t> base;
+    std::uint32_t size = 0;
+    for (const Object& o : objects) {
+        base.push_back(size);
+        size += static_cast<std::uint32_t>(o.code.size());
+    }
+
+    // exported labels; the first definition wins
+    std::unordered_map<std::string_view, std::uint32_t> labels;
+    for (std::size_t k = 0; k < objects.size(); k++) {
+        for (const Object::Symbol& s : objects[k].symbols) {
+            if (s.Defined() && labels.emplace(s.name, base[k] + s.offset).second) {
+                program.labels.emplace(s.name, base[k] + s.offset);
+            }
+        }
+    }
+
+    std::unordered_map<std::string_view, std::uint32_t> variables;
+    std::uint32_t next_addr = 16;
+    const auto resolve = [&](const Object::Symbol& s) {
+        if (const auto it = labels.find(s.name); it != labels.end()) {
+            return it->second;
+        }
+        const auto [it, added] = variables.emplace(s.name, next_addr);
+        next_addr += added;
+        return it->second;
+    };
+
+    program.words.reserve(program.words.size() + size);
+    for (std::size_t k = 0; k < objects.size(); k++) {
+        const Object& o = objects[k];
+        const std::size_t first = program.words.size();
+        program.words.insert(program.words.end(), o.code.begin(), o.code.end());
+
+        for (const Object::Relocation& r : o.relocations) {
+            const Object::Symbol& s = o.symbols[r.symbol];
+            const std::uint32_t addr = s.Defined() ? base[k] + s.offset : resolve(s);
+            program.words[first + r.offset] = static_cast<std::uint16_t>(addr & 0x7FFF);
+        }
+    }
+}
+
+void
+WriteObject(const Object& object, const Sink& out)
+{
+    static constexpr char HEX[] = "0123456789abcdef";
+
+    std::string text = "hackobj 1\ncode " + std::to_string(object.code.size()) + "\n";
+    for (const std::uint16_t word : object.code) {
+        for (int shift = 12; shift >= 0; shift -= 4) {
+            text += HEX[word >> shift & 0xF];
+        }
+        text += '\n';
+    }
+
+    text += "symbols " + std::to_string(object.symbols.size()) + "\n";
+    for (const Object::Symbol& s : object.symbols) {
+        text += s.name;
+        text += s.Defined() ? " " + std::to_string(s.offset) + "\n" : " -\n";
+    }
+
+    text += "relocs " + std::to_string(object.relocations.size()) + "\n";
+    for (const Object::Relocation& r : object.relocations) {
+        text += std::to_string(r.offset) + " " + std::to_string(r.symbol) + "\n";
+    }
+    out(text);
+}
+
+bool
+WriteObject(const Object& object, const std::string& out_path)
+{
+    std::ofstream out{ out_path, std::ios::out | std::ios::trunc | std::ios::binary };
+    if (!out) {
+        std::cerr << "Failed to open the file(" << out_path << ")\n";
+        return false;
+    }
+    WriteObject(object, [&out](std::string_view s) { out.write(s.data(), static_cast<std::streamsize>(s.size())); });
+    return static_cast<bool>(out);
+}
+
+// Splits the text into whitespace separated tokens
+class Tokens
+{
+  public:
+    explicit Tokens(std::string_view text)
+      : _text(text)
+    {
+    }
+
+    std::string_view Next()
+    {
+        const auto begin = std::min(_text.find_first_not_of(" \t\r\n", _pos), _text.size());
+        _pos             = std::min(_text.find_first_of(" \t\r\n", begin), _text.size());
+        return _text.substr(begin, _pos - begin);
+    }
+
+    bool Number(std::uint32_t& value, int base = 10)
+    {
+        const std::string_view t = Next();
+        const auto r             = std::from_chars(t.data(), t.data() + t.size(), value, base);
+        return !t.empty() && r.ec == std::errc{} && r.ptr == t.data() + t.size();
+    }
+
+    bool Expect(std::string_view word) { return Next() == word; }
+
+  private:
+    std::string_view _text;
+    std::size_t _pos{ 0 };
+};
+
+bool
+ParseObject(std::span<const char> source, Object& object)
+{
+    Tokens t{ std::string_view{ source.data(), source.size() } };
+    std::uint32_t n = 0;
+    // every entry takes a line, so no count may exceed the size of the text
+    const auto count = [&t, &n, &source](std::string_view section) {
+        return t.Expect(section) && t.Number(n) && n <= source.size();
+    };
+
+    if (!t.Expect("hackobj") || !t.Expect("1") || !count("code")) {
+        return false;
+    }
+    object.code.resize(n);
+    for (std::uint16_t& word : object.code) {
+        std::uint32_t w = 0;
+        if (!t.Number(w, 16) || w > 0xFFFF) {
+            return false;
+        }
+        word = static_cast<std::uint16_t>(w);
+    }
+
+    if (!count("symbols")) {
+        return false;
+    }
+    object.symbols.resize(n);
+    for (Object::Symbol& s : object.symbols) {
+        s.name                     = t.Next();
+        const std::string_view off = t.Next();
+        if (s.name.empty() || off.empty()) {
+            return false;
+        }
+        if (off != "-") {
+            const auto r = std::from_chars(off.data(), off.data() + off.size(), s.offset);
+            if (r.ec != std::errc{} || s.offset > object.code.size()) {
+                return false;
+            }
+        }
+    }
+
+    if (!count("relocs")) {
+        return false;
+    }
+    object.relocations.resize(n);
+    for (Object::Relocation& r : object.relocations) {
+        if (!t.Number(r.offset) || !t.Number(r.symbol) || r.offset >= object.code.size() ||
+            r.symbol >= object.symbols.size()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+ReadObject(const std::string& in_path, Object& object)
+{
+    std::ifstream in{ in_path, std::ios::binary };
+    if (!in) {
+        std::cerr << "Failed to open file: " << in_path << std::endl;
+        return false;
+    }
+    const std::string text{ std::istreambuf_iterator<char>{ in }, std::istreambuf_iterator<char>{} };
+    if (!ParseObject(text, object)) {
+        std::cerr << "Not a Hack object: " << in_path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace Asm
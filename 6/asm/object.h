@@ -0,0 +1,78 @@
+#ifndef ASM_OBJECT_HH
+#define ASM_OBJECT_HH
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "assembler.h"
+#include "listing.h"
+
+namespace Asm {
+
+// Relocatable machine code: a listing assembled on its own, so that code
+// translated once (the OS of project 12) can be linked into many programs.
+// Literals, C-instructions and predefined symbols are final words; every
+// other @symbol is a relocation, left for the linker to fill in.
+struct Object
+{
+    struct Symbol
+    {
+        static constexpr std::uint32_t UNDEFINED = UINT32_MAX;
+
+        std::string name;
+        // offset of the (LABEL) in `code`, or UNDEFINED for an import
+        std::uint32_t offset{ UNDEFINED };
+
+        bool Defined() const { return offset != UNDEFINED; }
+    };
+
+    struct Relocation
+    {
+        std::uint32_t offset; // word of `code` to patch
+        std::uint32_t symbol; // index into `symbols`
+    };
+
+    std::vector<std::uint16_t> code;
+    // labels defined here (exports) and symbols used but not defined
+    // (imports), in order of first appearance
+    std::vector<Symbol> symbols;
+    // in code order
+    std::vector<Relocation> relocations;
+};
+
+// Assembles `listing` without resolving its symbols
+void
+Compile(const Listing& listing, Object& object);
+
+// Lays the objects out one after another and resolves their symbols:
+//  - a symbol defined in the same object is that object's label, so
+//    generated labels such as JEQ_TRUE_0 may repeat across objects
+//  - an import is the label of the first object that defines it
+//  - an import nobody defines is a variable (the VM's static variables),
+//    allocated from RAM[16] in order of first use
+// Linking the objects of some .asm files gives the words of assembling
+// the files concatenated, as long as no label is defined twice.
+void
+Link(std::span<const Object> objects, Program& program);
+
+// Text form of an object, the .o files of `hackasm -c`:
+//   hackobj 1
+//   code <n>       then n words, 4 hex digits each
+//   symbols <n>    then n lines `name offset`, offset - for an import
+//   relocs <n>     then n lines `offset symbol`
+void
+WriteObject(const Object& object, const Sink& out);
+bool
+WriteObject(const Object& object, const std::string& out_path);
+
+// Reads the text form back; false when it is malformed
+bool
+ParseObject(std::span<const char> source, Object& object);
+bool
+ReadObject(const std::string& in_path, Object& object);
+
+} // namespace Asm
+
+#endif
@@ -1,10 +1,13 @@
 #include "parser.h"
 #include <algorithm>
 #include <cctype>
+#include <fstream>
 #include <iostream>
 #include <ranges>
 #include <string_view>
 
+#include "instruction.h"
+
 namespace Asm {
 
 // Must ensure line is a C-instruction
@@ -54,102 +57,67 @@ Validate(const std::string& s)
 static bool
 IsLInstruction(const std::string& line)
 {
-    bool ok = (line.front() == '(') && (line.back() == ')');
+    bool ok = line.size() >= 2 && (line.front() == '(') && (line.back() == ')');
     return ok && Validate(line.substr(1, line.size() - 2));
 }
 
 static bool
 IsAInstruction(const std::string& line)
 {
-    bool ok = line.front() == '@';
+    bool ok = !line.empty() && line.front() == '@';
     return ok && Validate(line.substr(1));
 }
 
 static bool
 IsCInstruction(const std::string& line)
 {
-    constexpr std::string_view jumps[] = { "JGT", "JEQ", "JGE", "JLT", "JNE", "JLE", "JMP" };
-    constexpr std::string_view dests[] = { "M", "D", "DM", "A", "AM", "AD", "ADM" };
-    constexpr std::string_view comps[] = { "0",   "1",   "-1",  "D",   "A",   "!A",  "!D",
-                                           "-D",  "-A",  "D+1", "A+1", "D-1", "A-1", "D+A",
-                                           "D-A", "A-D", "D&A", "D|A", "M",   "!M",  "M+1",
-                                           "M-1", "D+M", "D-M", "M-D", "D&M", "D|M" };
-
-    const auto c_inst = Extract(line);
-
-    // helper: check membership
-    auto contains = [](auto& arr, const std::string& val) {
-        return std::ranges::find(arr, val) != std::end(arr);
-    };
-
-    // comp must always be present and valid
-    if (c_inst.c.empty() || !contains(comps, c_inst.c)) {
-        return false;
-    }
-
-    if (!c_inst.d.empty() && !contains(dests, c_inst.d)) {
-        return false;
-    }
-
-    if (!c_inst.j.empty() && !contains(jumps, c_inst.j)) {
-        return false;
-    }
-
-    return true;
-}
-
-std::string&
-Ltrim(std::string& s)
-{
-    s.erase(s.begin(),
-            std::find_if(s.begin(), s.end(), [](unsigned char ch) { return !std::isspace(ch); }));
-    return s;
-}
-
-std::string&
-Rtrim(std::string& s)
-{
-    s.erase(
-      std::find_if(s.rbegin(), s.rend(), [](unsigned char ch) { return !std::isspace(ch); }).base(),
-      s.end());
-    return s;
-}
-
-std::string&
-Trim(std::string& s)
-{
-    return Ltrim(Rtrim(s));
+    // comp must always be present; all fields must be known mnemonics
+    return EncodeC(line).has_value();
 }
 
 Parser::Parser(const std::string& filepath)
 {
-    in_.open(filepath);
-    if (!in_) {
+    std::ifstream in{ filepath, std::ios::binary };
+    if (!in) {
         std::cerr << "Failed to open file: " << filepath << std::endl;
+        return;
     }
+    file_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    src_ = file_;
 }
 
-Parser::~Parser()
+Parser::Parser(std::span<const char> source)
+  : src_(source.data(), source.size())
 {
-    in_.close();
 }
 
+Parser::~Parser() {}
+
 bool
 Parser::HasMoreLines()
 {
-    return !(in_.peek() == std::char_traits<char>::eof());
+    return pos_ < src_.size();
 }
 
 void
 Parser::Advance()
 {
-    while (HasMoreLines()) {
-        std::string line;
-        std::getline(in_, line);
+    // nothing left but comments and blank lines: no instruction
+    cur_.clear();
 
-        Trim(line);
+    while (HasMoreLines()) {
+        // one line without its '\n'
+        const std::size_t end = std::min(src_.find('\n', pos_), src_.size());
+        std::string line{ src_.substr(pos_, end - pos_) };
+        pos_ = end + 1;
+
+        // drop the comment, then every blank: `D ; JEQ // x` -> `D;JEQ`
+        if (const auto comment = line.find("//"); comment != std::string::npos) {
+            line.erase(comment);
+        }
+        std::erase_if(line, [](unsigned char ch) { return std::isspace(ch); });
 
-        if (line.substr(0, 2) == "//") {
+        if (line.empty()) {
             continue;
         }
 
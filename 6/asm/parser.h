@@ -1,5 +1,7 @@
-#include <fstream>
+#include <cstddef>
+#include <span>
 #include <string>
+#include <string_view>
 
 namespace Asm {
 
@@ -21,7 +23,12 @@ class Parser
         std::string j;
     };
 
+    // Reads the whole file
     explicit Parser(const std::string& filepath);
+    // Parses text in memory; `source` must outlive the parser
+    explicit Parser(std::span<const char> source);
+    Parser(const Parser&)            = delete;
+    Parser& operator=(const Parser&) = delete;
 
     ~Parser();
 
@@ -36,7 +43,9 @@ class Parser
     std::string Current() const;
 
   private:
-    std::ifstream in_;
+    std::string file_; // contents when read from a file
+    std::string_view src_;
+    std::size_t pos_{ 0 };
     std::string cur_;
     std::string d_, c_, j_;
 };
@@ -0,0 +1,108 @@
+// Tests for Asm::Assemble
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unistd.h>
+
+#include "../assembler.h"
+
+// Test fixture for Assemble tests. Creates a temporary file for each test.
+class AssemblerTest : public ::testing::Test
+{
+  protected:
+    std::string tmp_filename;
+
+    void SetUp() override
+    {
+        tmp_filename = std::string("/tmp/asm_assembler_test_") + std::to_string(::getpid()) + "_" +
+                       std::to_string(::rand());
+    }
+
+    void TearDown() override
+    {
+        std::remove(tmp_filename.c_str());
+        std::remove((tmp_filename + ".sym").c_str());
+    }
+
+    void writeFile(const std::string& contents)
+    {
+        std::ofstream out(tmp_filename);
+        out << contents;
+        out.close();
+    }
+};
+
+TEST_F(AssemblerTest, Add)
+{
+    writeFile("// R0 = 2 + 3\n@2\nD=A\n@3\nD=D+A\n@0\nM=D\n");
+
+    Asm::Program program;
+    ASSERT_TRUE(Asm::Assemble(tmp_filename, program));
+
+    const std::vector<std::uint16_t> expected = {
+        0b0000000000000010, 0b1110110000010000, 0b0000000000000011,
+        0b1110000010010000, 0b0000000000000000, 0b1110001100001000,
+    };
+    EXPECT_EQ(program.words, expected);
+    EXPECT_TRUE(program.labels.empty());
+}
+
+TEST_F(AssemblerTest, LabelsAndVariables)
+{
+    writeFile("@i\nM=1\n(LOOP)\n@j\nM=0\n@LOOP\n0;JMP\n(END)\n");
+
+    Asm::Program program;
+    ASSERT_TRUE(Asm::Assemble(tmp_filename, program));
+
+    ASSERT_EQ(program.words.size(), 6u);
+    EXPECT_EQ(program.words[0], 16); // i
+    EXPECT_EQ(program.words[2], 17); // j
+    EXPECT_EQ(program.words[4], 2);  // LOOP
+
+    EXPECT_EQ(program.labels.at("LOOP"), 2u);
+    EXPECT_EQ(program.labels.at("END"), 6u);
+    EXPECT_FALSE(program.labels.contains("i"));
+}
+
+TEST_F(AssemblerTest, WriteSymbols)
+{
+    Asm::Program program;
+    program.labels = { { "END", 6 }, { "LOOP", 2 } };
+    ASSERT_TRUE(Asm::WriteSymbols(program, tmp_filename + ".sym"));
+
+    std::ifstream in(tmp_filename + ".sym");
+    std::string contents{ std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+    EXPECT_EQ(contents, "LOOP 2\nEND 6\n");
+}
+
+TEST_F(AssemblerTest, WriteHack)
+{
+    Asm::Program program;
+    program.words = { 2, 0b1110110000010000 };
+    ASSERT_TRUE(Asm::WriteHack(program, tmp_filename + ".sym"));
+
+    std::ifstream in(tmp_filename + ".sym");
+    std::string contents{ std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+    EXPECT_EQ(contents, "0000000000000010\n1110110000010000\n");
+}
+
+// Each line is one word; the book's spellings assemble like ours
+TEST_F(AssemblerTest, ParseAsm)
+{
+    Asm::Listing listing;
+    Asm::ParseAsm(std::string_view{ "@40000\nMD=M+D\nD; JEQ\n// end\n" }, listing);
+    Asm::Program program;
+    Asm::Assemble(listing, program);
+
+    const std::vector<std::uint16_t> expected{ Asm::C("DM=D+M").word, Asm::C("D;JEQ").word };
+    EXPECT_EQ(program.words, expected);
+}
+
+TEST_F(AssemblerTest, MissingFile)
+{
+    Asm::Program program;
+    EXPECT_FALSE(Asm::Assemble(tmp_filename + ".missing", program));
+}
@@ -0,0 +1,81 @@
+// Tests for Asm::Listing and the instruction encoding
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+
+#include "../assembler.h"
+#include "../listing.h"
+
+static_assert(Asm::C("D=A").word == 0b1110110000010000);
+static_assert(Asm::C("AM=M-1").word == 0b1111110010101000);
+static_assert(Asm::C("0;JMP").word == 0b1110101010000111);
+static_assert(!Asm::EncodeC("MD=X"));
+static_assert(Asm::CompOf(Asm::C("M=D|M").word) == "D|M");
+
+TEST(ListingTest, PredefinedSymbols)
+{
+    Asm::Listing listing;
+    EXPECT_EQ(listing.Intern("SP"), Asm::SP);
+    EXPECT_EQ(listing.Intern("R14"), Asm::R14);
+    EXPECT_EQ(listing.Intern("KBD"), Asm::KBD);
+    EXPECT_EQ(Asm::PredefinedAddress(Asm::R13), 13);
+    EXPECT_EQ(Asm::PredefinedAddress(Asm::THAT), 4);
+    EXPECT_EQ(Asm::PredefinedAddress(Asm::SCREEN), 16384);
+
+    const Asm::Symbol loop = listing.Intern("LOOP");
+    EXPECT_EQ(loop, Asm::PREDEFINED_COUNT);
+    EXPECT_EQ(listing.Intern("LOOP"), loop);
+    EXPECT_EQ(listing.Name(loop), "LOOP");
+
+    listing.Clear();
+    EXPECT_EQ(listing.SymbolCount(), Asm::PREDEFINED_COUNT);
+    EXPECT_EQ(listing.Intern("R14"), Asm::R14);
+}
+
+// The symbol table grows past its first size and is emptied by Clear
+TEST(ListingTest, ManySymbols)
+{
+    Asm::Listing listing;
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < 1000; i++) {
+            EXPECT_EQ(listing.Intern("L" + std::to_string(i)), Asm::PREDEFINED_COUNT + i);
+        }
+        for (int i = 0; i < 1000; i += 7) {
+            EXPECT_EQ(listing.Name(listing.Intern("L" + std::to_string(i))), "L" + std::to_string(i));
+        }
+        EXPECT_EQ(listing.Intern("SCREEN"), Asm::SCREEN);
+        EXPECT_EQ(listing.SymbolCount(), Asm::PREDEFINED_COUNT + 1000);
+        listing.Clear();
+        EXPECT_EQ(listing.SymbolCount(), Asm::PREDEFINED_COUNT);
+    }
+}
+
+// A listing assembles to the same words as its text
+TEST(ListingTest, SameAsText)
+{
+    Asm::Listing listing;
+    listing.At("i");
+    listing.Append({ Asm::C("M=1"), Asm::Label(listing.Intern("LOOP")), Asm::At(Asm::SP), Asm::C("AM=M-1"),
+                     Asm::C("D=M"), Asm::Literal(300), Asm::C("D=D-A") });
+    listing.At("j");
+    listing.Append({ Asm::C("M=D"), Asm::At(Asm::R13), Asm::C("M=0") });
+    listing.At("LOOP");
+    listing.Append(Asm::C("D;JNE"));
+    listing.Label("END");
+
+    std::string text;
+    Asm::WriteAsm(listing, [&text](std::string_view s) { text += s; });
+    EXPECT_EQ(text, "@i\nM=1\n(LOOP)\n@SP\nAM=M-1\nD=M\n@300\nD=D-A\n@j\nM=D\n@R13\nM=0\n@LOOP\nD;JNE\n(END)\n");
+
+    Asm::Listing parsed;
+    Asm::ParseAsm(text, parsed);
+    Asm::Program from_text, from_listing;
+    Asm::Assemble(parsed, from_text);
+    Asm::Assemble(listing, from_listing);
+
+    EXPECT_EQ(from_listing.words, from_text.words);
+    EXPECT_EQ(from_listing.labels, from_text.labels);
+    EXPECT_EQ(from_listing.words[0], 16); // i
+    EXPECT_EQ(from_listing.words[7], 17); // j
+    EXPECT_EQ(from_listing.words[11], 2); // LOOP
+}
@@ -0,0 +1,92 @@
+// Tests for relocatable objects and the linker
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../object.h"
+
+static Asm::Object
+CompileText(std::string_view text)
+{
+    Asm::Listing listing;
+    Asm::ParseAsm(text, listing);
+    Asm::Object object;
+    Asm::Compile(listing, object);
+    return object;
+}
+
+static constexpr std::string_view MAIN{ "@256\nD=A\n@SP\nM=D\n@Math.twice\n0;JMP\n"
+                                        "(Main.ret)\n@x\nM=D\n(END)\n@END\n0;JMP\n" };
+static constexpr std::string_view MATH{ "(Math.twice)\n@y\nM=D\n@x\nD=D+M\n@Main.ret\n0;JMP\n" };
+
+// Linking objects gives the words of the files assembled as one
+TEST(ObjectTest, MatchesFlatAssembly)
+{
+    const std::vector<Asm::Object> objects{ CompileText(MAIN), CompileText(MATH) };
+    Asm::Program linked;
+    Asm::Link(objects, linked);
+
+    Asm::Listing listing;
+    Asm::ParseAsm(std::string{ MAIN } + std::string{ MATH }, listing);
+    Asm::Program flat;
+    Asm::Assemble(listing, flat);
+
+    EXPECT_EQ(linked.words, flat.words);
+    EXPECT_EQ(linked.labels, flat.labels);
+    // x is used first, in Main
+    EXPECT_EQ(linked.words[6], 16);
+    EXPECT_EQ(linked.words[10], 17);
+}
+
+// Predefined symbols are final; only the others are relocated
+TEST(ObjectTest, Relocations)
+{
+    const Asm::Object main = CompileText(MAIN);
+
+    EXPECT_EQ(main.code.size(), 10u);
+    EXPECT_EQ(main.code[2], 0u); // SP
+    ASSERT_EQ(main.relocations.size(), 3u);
+    EXPECT_EQ(main.relocations[0].offset, 4u);
+    EXPECT_EQ(main.symbols[main.relocations[0].symbol].name, "Math.twice");
+    EXPECT_FALSE(main.symbols[main.relocations[0].symbol].Defined());
+    EXPECT_EQ(main.symbols[main.relocations[2].symbol].name, "END");
+    EXPECT_EQ(main.symbols[main.relocations[2].symbol].offset, 8u);
+}
+
+// A label defined in several objects is each object's own
+TEST(ObjectTest, LocalLabelsWin)
+{
+    const std::vector<Asm::Object> objects{ CompileText("(LOOP)\n@LOOP\n0;JMP\n"),
+                                            CompileText("@1\n(LOOP)\n@LOOP\n0;JMP\n@LOOP\n") };
+    Asm::Program program;
+    Asm::Link(objects, program);
+
+    const std::vector<std::uint16_t> expected{ 0, Asm::C("0;JMP").word, 1, 3, Asm::C("0;JMP").word, 3 };
+    EXPECT_EQ(program.words, expected);
+    EXPECT_EQ(program.labels.at("LOOP"), 0u);
+}
+
+// The text form reads back as written, and malformed text is refused
+TEST(ObjectTest, TextForm)
+{
+    const Asm::Object math = CompileText(MATH);
+    std::string text;
+    Asm::WriteObject(math, [&text](std::string_view s) { text += s; });
+
+    Asm::Object read;
+    ASSERT_TRUE(Asm::ParseObject(text, read));
+    EXPECT_EQ(read.code, math.code);
+    ASSERT_EQ(read.symbols.size(), math.symbols.size());
+    for (std::size_t i = 0; i < read.symbols.size(); i++) {
+        EXPECT_EQ(read.symbols[i].name, math.symbols[i].name);
+        EXPECT_EQ(read.symbols[i].offset, math.symbols[i].offset);
+    }
+    ASSERT_EQ(read.relocations.size(), math.relocations.size());
+    EXPECT_EQ(read.relocations[1].offset, math.relocations[1].offset);
+
+    Asm::Object bad;
+    EXPECT_FALSE(Asm::ParseObject(std::string_view{ "hackobj 1\ncode 1\nzzzz\n" }, bad));
+    EXPECT_FALSE(Asm::ParseObject(std::string_view{ "hackobj 1\ncode 99999999\n" }, bad));
+    EXPECT_FALSE(Asm::ParseObject(text.substr(0, text.size() - 3), bad));
+}
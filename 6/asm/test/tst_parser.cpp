@@ -3,6 +3,7 @@
 #include <fstream>
 #include <gtest/gtest.h>
 #include <string>
+#include <string_view>
 
 #include "../parser.h"
 
@@ -31,6 +32,42 @@ class ParserTest : public ::testing::Test
     }
 };
 
+TEST_F(ParserTest, FromFile)
+{
+    writeFile("@0\r\n// comment\nD=A\n");
+    Parser p(tmp_filename);
+
+    p.Advance();
+    EXPECT_EQ(p.Current(), "@0");
+    p.Advance();
+    EXPECT_EQ(p.Current(), "D=A");
+    EXPECT_FALSE(p.HasMoreLines());
+}
+
+// The span constructor parses text held in memory the same way
+TEST_F(ParserTest, FromMemory)
+{
+    Parser p{ std::string_view{ "(LOOP)\r\n@123\n// x\nD=A+1;JGT\nM=D\n" } };
+
+    EXPECT_EQ(p.Current(), "");
+    EXPECT_EQ(p.InstructionType(), Parser::Instruction::Invalid);
+    p.Advance();
+    EXPECT_EQ(p.InstructionType(), Parser::Instruction::L);
+    EXPECT_EQ(p.Symbol(), "LOOP");
+    p.Advance();
+    EXPECT_EQ(p.InstructionType(), Parser::Instruction::A);
+    EXPECT_EQ(p.Symbol(), "123");
+    p.Advance();
+    EXPECT_EQ(p.InstructionType(), Parser::Instruction::C);
+    EXPECT_EQ(p.Dest(), "D");
+    EXPECT_EQ(p.Comp(), "A+1");
+    EXPECT_EQ(p.Jump(), "JGT");
+    EXPECT_TRUE(p.HasMoreLines());
+    p.Advance();
+    EXPECT_EQ(p.Current(), "M=D");
+    EXPECT_FALSE(p.HasMoreLines());
+}
+
 // HasMoreLines - template to verify whether parser reports remaining input correctly
 TEST_F(ParserTest, HasMoreLines)
 {
@@ -143,6 +180,36 @@ TEST_F(ParserTest, Jump)
     EXPECT_EQ(p.Jump(), "JGT");
 }
 
+// Blanks inside an instruction, trailing comments and the book's spellings
+TEST_F(ParserTest, Spellings)
+{
+    Parser p{ std::string_view{ "D ; JEQ // x\nMD=M+D\r\n  @ i\n" } };
+
+    p.Advance();
+    EXPECT_EQ(p.InstructionType(), Parser::Instruction::C);
+    EXPECT_EQ(p.Comp(), "D");
+    EXPECT_EQ(p.Jump(), "JEQ");
+    p.Advance();
+    EXPECT_EQ(p.InstructionType(), Parser::Instruction::C);
+    EXPECT_EQ(p.Dest(), "MD");
+    EXPECT_EQ(p.Comp(), "M+D");
+    p.Advance();
+    EXPECT_EQ(p.Symbol(), "i");
+}
+
+// Comments and blank lines after the last instruction are not an instruction
+TEST_F(ParserTest, TrailingComment)
+{
+    Parser p{ std::string_view{ "D=A\n// end\n\n" } };
+
+    p.Advance();
+    EXPECT_EQ(p.Current(), "D=A");
+    EXPECT_TRUE(p.HasMoreLines());
+    p.Advance();
+    EXPECT_EQ(p.InstructionType(), Parser::Instruction::Invalid);
+    EXPECT_FALSE(p.HasMoreLines());
+}
+
 int
 main(int argc, char** argv)
 {
@@ -0,0 +1,482 @@
+#include "cfg.h"
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <string>
+#include <unordered_map>
+
+namespace Vm {
+
+ControlFlowGraph::ControlFlowGraph(const Function& function)
+{
+    const auto& body = function.body;
+    // the code before the first function falls into it: left alone
+    if (body.empty() || body[0].type != Parser::Cmd::Function) {
+        _valid = false;
+        return;
+    }
+    _head = body[0];
+
+    bool open = false; // the last block takes more commands
+    auto start = [this, &open] {
+        _blocks.emplace_back();
+        open = true;
+    };
+    for (std::size_t i = 1; i < body.size(); i++) {
+        const Command& c = body[i];
+        switch (c.type) {
+            case Parser::Cmd::Label:
+                if (!open || !_blocks.back().code.empty()) {
+                    start();
+                }
+                _blocks.back().labels.push_back(c.arg1);
+                break;
+
+            case Parser::Cmd::Goto:
+            case Parser::Cmd::If:
+            case Parser::Cmd::Return:
+                if (!open) {
+                    start();
+                }
+                _blocks.back().exit   = c.type;
+                _blocks.back().target = c.arg1;
+                open                  = false;
+                break;
+
+            case Parser::Cmd::IfNot:
+            case Parser::Cmd::Function:
+            case Parser::Cmd::Invalid:
+                // already rewritten, or not a function
+                _valid = false;
+                return;
+
+            case Parser::Cmd::Arithmetic:
+            case Parser::Cmd::Push:
+            case Parser::Cmd::Pop:
+            case Parser::Cmd::Call:
+                if (!open) {
+                    start();
+                }
+                _blocks.back().code.push_back(c);
+                break;
+        }
+    }
+    if (_blocks.empty()) {
+        _valid = false;
+        return;
+    }
+
+    std::unordered_map<std::string_view, int> labels;
+    for (std::size_t b = 0; b < _blocks.size(); b++) {
+        for (const std::string_view l : _blocks[b].labels) {
+            if (!labels.emplace(l, static_cast<int>(b)).second) {
+                _valid = false;
+                return;
+            }
+        }
+    }
+    for (std::size_t b = 0; b < _blocks.size(); b++) {
+        Block& k = _blocks[b];
+        if (FallsThrough(k) && b + 1 < _blocks.size()) {
+            k.next = static_cast<int>(b + 1);
+        }
+        if (k.exit == Parser::Cmd::Goto || k.exit == Parser::Cmd::If) {
+            const auto it = labels.find(k.target);
+            k.jump        = it != labels.end() ? it->second : -1;
+        }
+    }
+}
+
+bool
+ControlFlowGraph::FallsThrough(const Block& b) const
+{
+    return b.exit == Parser::Cmd::Invalid || b.exit == Parser::Cmd::If;
+}
+
+// The first block from `block` on that has commands or decides something
+int
+ControlFlowGraph::Resolve(int block) const
+{
+    // a loop of empty blocks stops after one round
+    for (std::size_t steps = 0; block >= 0 && steps < _blocks.size(); steps++) {
+        const Block& b = _blocks[block];
+        if (!b.code.empty()) {
+            break;
+        }
+        if (b.exit == Parser::Cmd::Goto && b.jump >= 0) {
+            block = b.jump;
+        } else if (b.exit == Parser::Cmd::Invalid && b.next >= 0) {
+            block = b.next;
+        } else {
+            break;
+        }
+    }
+    return block;
+}
+
+void
+ControlFlowGraph::ThreadJumps()
+{
+    for (Block& b : _blocks) {
+        if (b.jump >= 0) {
+            b.jump = Resolve(b.jump);
+        }
+        if (b.next >= 0) {
+            b.next = Resolve(b.next);
+        }
+    }
+    _entry = Resolve(_entry);
+}
+
+// How many loops each block is in: a loop is a target of a back edge of
+// the depth-first search from the entry, with the blocks that reach the
+// back edge without passing through it
+std::vector<int>
+ControlFlowGraph::LoopDepths(std::vector<std::pair<int, int>>& back_edges) const
+{
+    const int n = static_cast<int>(_blocks.size());
+    auto successors = [this](int b) {
+        const Block& k = _blocks[b];
+        return std::array<int, 2>{ FallsThrough(k) ? k.next : -1, k.jump };
+    };
+
+    std::vector<std::vector<int>> preds(n);
+    std::vector<int> state(n, 0); // 1: on the path, 2: done
+    std::vector<std::pair<int, int>> path{ { _entry, 0 } };
+    state[_entry] = 1;
+    while (!path.empty()) {
+        auto& [b, i] = path.back();
+        if (i == 2) {
+            state[b] = 2;
+            path.pop_back();
+            continue;
+        }
+        const int s = successors(b)[i++];
+        if (s < 0) {
+            continue;
+        }
+        preds[s].push_back(b);
+        if (state[s] == 1) {
+            back_edges.emplace_back(b, s);
+        } else if (state[s] == 0) {
+            state[s] = 1;
+            path.emplace_back(s, 0);
+        }
+    }
+
+    std::vector<std::vector<bool>> loops(n); // by header
+    for (const auto& [latch, header] : back_edges) {
+        auto& in = loops[header];
+        if (in.empty()) {
+            in.assign(n, false);
+            in[header] = true;
+        }
+        std::vector<int> work{ latch };
+        while (!work.empty()) {
+            const int b = work.back();
+            work.pop_back();
+            if (!in[b]) {
+                in[b] = true;
+                work.insert(work.end(), preds[b].begin(), preds[b].end());
+            }
+        }
+    }
+
+    std::vector<int> depths(n, 0);
+    for (const auto& in : loops) {
+        for (int b = 0; b < static_cast<int>(in.size()); b++) {
+            depths[b] += in[b];
+        }
+    }
+    return depths;
+}
+
+// How often each block ran: a labelled block by its labels, the first by
+// the calls of the function, and any other by the block falling into it,
+// less the jumps its if-goto took where that can be told
+std::vector<std::uint64_t>
+ControlFlowGraph::Counts(const Profile& profile) const
+{
+    const int n = static_cast<int>(_blocks.size());
+    std::vector<int> preds(n, 0);
+    for (const Block& k : _blocks) {
+        if (FallsThrough(k) && k.next >= 0) {
+            preds[k.next]++;
+        }
+        if (k.jump >= 0) {
+            preds[k.jump]++;
+        }
+    }
+
+    std::vector<std::uint64_t> counts(n, 0);
+    counts[0] = profile.Entries(_head.arg1);
+    for (int b = 0; b < n; b++) {
+        for (const std::string_view l : _blocks[b].labels) {
+            counts[b] = std::max(counts[b], profile.Count(l));
+        }
+    }
+    for (int b = 1; b < n; b++) {
+        if (!_blocks[b].labels.empty()) {
+            continue;
+        }
+        const Block& before = _blocks[b - 1];
+        if (!FallsThrough(before)) {
+            continue;
+        }
+        counts[b] = counts[b - 1];
+        // the jump is counted at its target when nothing else leads there
+        const int j = before.jump;
+        if (before.exit == Parser::Cmd::If && j >= 0 && j != b && preds[j] == 1) {
+            counts[b] -= std::min(counts[b], counts[j]);
+        }
+    }
+    return counts;
+}
+
+void
+ControlFlowGraph::Layout(const Profile* profile)
+{
+    const int n = static_cast<int>(_blocks.size());
+    // all zero without a profile, which leaves the order to the loops
+    const std::vector<std::uint64_t> counts = profile ? Counts(*profile) : std::vector<std::uint64_t>(n, 0);
+
+    std::vector<bool> reachable(n, false);
+    std::vector<int> work{ _entry };
+    while (!work.empty()) {
+        const int b = work.back();
+        work.pop_back();
+        if (b < 0 || reachable[b]) {
+            continue;
+        }
+        reachable[b] = true;
+        if (FallsThrough(_blocks[b])) {
+            work.push_back(_blocks[b].next);
+        }
+        work.push_back(_blocks[b].jump);
+    }
+
+    // the block falling off the end stays last
+    int last = -1;
+    for (int b = 0; b < n; b++) {
+        if (reachable[b] && FallsThrough(_blocks[b]) && _blocks[b].next < 0) {
+            last = b;
+        }
+    }
+
+    // edges taken most often first, then those inside loops; of the same
+    // weight, back edges and then fall-throughs
+    struct Edge
+    {
+        int from;
+        int to;
+        std::uint64_t count;
+        int weight;
+        bool back;
+        bool falls;
+    };
+    std::vector<std::pair<int, int>> back_edges;
+    const std::vector<int> depths = LoopDepths(back_edges);
+    auto back = [&back_edges](int from, int to) {
+        return std::ranges::find(back_edges, std::pair{ from, to }) != back_edges.end();
+    };
+    std::vector<Edge> edges;
+    for (int b = 0; b < n; b++) {
+        const Block& k = _blocks[b];
+        if (!reachable[b] || b == last) {
+            continue;
+        }
+        if (FallsThrough(k)) {
+            edges.push_back({ b, k.next, std::min(counts[b], counts[k.next]), std::min(depths[b], depths[k.next]),
+                              back(b, k.next), true });
+        }
+        if (k.jump >= 0) {
+            edges.push_back({ b, k.jump, std::min(counts[b], counts[k.jump]), std::min(depths[b], depths[k.jump]),
+                              back(b, k.jump), false });
+        }
+    }
+    std::ranges::stable_sort(edges, [](const Edge& a, const Edge& b) {
+        if (a.count != b.count) {
+            return a.count > b.count;
+        }
+        if (a.weight != b.weight) {
+            return a.weight > b.weight;
+        }
+        if (a.back != b.back) {
+            return a.back;
+        }
+        return a.falls && !b.falls;
+    });
+
+    // join chains of blocks along the edges, tail to head
+    std::vector<int> succ(n, -1);
+    std::vector<int> pred(n, -1);
+    for (const Edge& e : edges) {
+        if (succ[e.from] >= 0 || pred[e.to] >= 0 || e.from == e.to) {
+            continue;
+        }
+        int tail = e.to;
+        while (succ[tail] >= 0) {
+            tail = succ[tail];
+        }
+        if (tail == e.from) {
+            continue;
+        }
+        succ[e.from] = e.to;
+        pred[e.to]   = e.from;
+    }
+
+    auto head_of = [&pred](int b) {
+        while (b >= 0 && pred[b] >= 0) {
+            b = pred[b];
+        }
+        return b;
+    };
+    const int last_head  = head_of(last);
+    const int entry_head = head_of(_entry);
+    // the entry's chain first, unless it leads to the end; Write jumps to
+    // the entry when it is not the first block
+    std::vector<int> heads;
+    if (entry_head != last_head) {
+        heads.push_back(entry_head);
+    }
+    for (int b = 0; b < n; b++) {
+        if (reachable[b] && pred[b] < 0 && b != entry_head && b != last_head) {
+            heads.push_back(b);
+        }
+    }
+    // cold chains after the hot ones
+    std::stable_sort(heads.begin() + (entry_head != last_head), heads.end(),
+                     [&counts](int a, int b) { return counts[a] > counts[b]; });
+    if (last_head >= 0) {
+        heads.push_back(last_head);
+    }
+
+    _order.clear();
+    for (int b : heads) {
+        for (; b >= 0; b = succ[b]) {
+            _order.push_back(b);
+        }
+    }
+}
+
+void
+ControlFlowGraph::Write(Function& function, Arena& arena) const
+{
+    struct Jump
+    {
+        Parser::Cmd type;
+        int block;
+        std::string_view label; // outside the function
+    };
+
+    // the jumps each block needs where it ends up
+    std::vector<std::vector<Jump>> jumps(_blocks.size());
+    std::vector<bool> targeted(_blocks.size(), false);
+    const bool enter = _order.front() != _entry;
+    targeted[_entry] = enter;
+    auto jump = [&](int b, Parser::Cmd type, int to) {
+        jumps[b].push_back({ type, to, to < 0 ? _blocks[b].target : std::string_view{} });
+        if (to >= 0) {
+            targeted[to] = true;
+        }
+    };
+    for (std::size_t k = 0; k < _order.size(); k++) {
+        const int b         = _order[k];
+        const int following = k + 1 < _order.size() ? _order[k + 1] : -1;
+        const Block& block  = _blocks[b];
+        switch (block.exit) {
+            case Parser::Cmd::Invalid:
+                if (block.next >= 0 && block.next != following) {
+                    jump(b, Parser::Cmd::Goto, block.next);
+                }
+                break;
+            case Parser::Cmd::Goto:
+                if (block.jump < 0 || block.jump != following) {
+                    jump(b, Parser::Cmd::Goto, block.jump);
+                }
+                break;
+            case Parser::Cmd::If:
+                if (block.next < 0 || block.next == following) {
+                    jump(b, Parser::Cmd::If, block.jump);
+                } else if (block.jump >= 0 && block.jump == following) {
+                    jump(b, Parser::Cmd::IfNot, block.next);
+                } else {
+                    jump(b, Parser::Cmd::If, block.jump);
+                    jump(b, Parser::Cmd::Goto, block.next);
+                }
+                break;
+            case Parser::Cmd::Return:
+                jumps[b].push_back({ Parser::Cmd::Return, -1, {} });
+                break;
+            case Parser::Cmd::Arithmetic:
+            case Parser::Cmd::Push:
+            case Parser::Cmd::Pop:
+            case Parser::Cmd::Function:
+            case Parser::Cmd::Call:
+            case Parser::Cmd::Label:
+            case Parser::Cmd::IfNot:
+                break;
+        }
+    }
+
+    // blocks jumped to are named by their first label, or a new one
+    std::vector<std::string_view> names(_blocks.size());
+    for (const int b : _order) {
+        if (!_blocks[b].labels.empty()) {
+            names[b] = _blocks[b].labels.front();
+        } else if (targeted[b]) {
+            names[b] = arena.Copy(std::format("{}$cfg.{}", _head.arg1, b));
+        }
+    }
+
+    auto& body = function.body;
+    body.clear();
+    body.push_back(_head);
+    if (enter) {
+        body.push_back({ Parser::Cmd::Goto, names[_entry], -1 });
+    }
+    for (const int b : _order) {
+        const Block& block = _blocks[b];
+        for (const std::string_view l : block.labels) {
+            body.push_back({ Parser::Cmd::Label, l, -1 });
+        }
+        if (block.labels.empty() && targeted[b]) {
+            body.push_back({ Parser::Cmd::Label, names[b], -1 });
+        }
+        for (const Command& c : block.code) {
+            body.push_back(c);
+        }
+        for (const Jump& j : jumps[b]) {
+            body.push_back({ j.type, j.block >= 0 ? names[j.block] : j.label, -1 });
+        }
+    }
+}
+
+void
+OptimiseControlFlow(Function& function, Arena& arena)
+{
+    ControlFlowGraph cfg{ function };
+    if (!cfg.Valid()) {
+        return;
+    }
+    cfg.ThreadJumps();
+    cfg.Layout();
+    cfg.Write(function, arena);
+}
+
+Pipeline::Pass
+ProfiledControlFlow(const Profile& profile)
+{
+    return [&profile](Function& function, Arena& arena) {
+        ControlFlowGraph cfg{ function };
+        if (!cfg.Valid()) {
+            return;
+        }
+        cfg.ThreadJumps();
+        cfg.Layout(&profile);
+        cfg.Write(function, arena);
+    };
+}
+
+} // namespace Vm
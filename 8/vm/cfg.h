@@ -0,0 +1,76 @@
+#ifndef VM_CFG_HH
+#define VM_CFG_HH
+
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "ir.h"
+#include "pipeline.h"
+#include "profile.h"
+
+namespace Vm {
+
+// Basic blocks of one function and the branches between them.
+// A block is a run of commands entered only at its labels and left only
+// by its last command: goto, if-goto, return, or falling into the next
+// block. Labels are taken to be local to the function, as the VM
+// specification has them; a jump to a label outside it stays as it is.
+class ControlFlowGraph
+{
+  public:
+    explicit ControlFlowGraph(const Function& function);
+
+    // false when the function cannot be rewritten (it repeats a label)
+    bool Valid() const { return _valid; }
+
+    // Branches to an empty block that only jumps on go straight to where
+    // it leads
+    void ThreadJumps();
+    // Orders the blocks reachable from the entry so that the most frequent
+    // branch of each block falls through: the edges inside a loop are taken
+    // before those entering or leaving it, and the jump back to the loop's
+    // test first of all, which puts the test after the body. Unreachable
+    // blocks are left out.
+    // With a profile, the edges between the blocks that ran most often come
+    // first, and the chains of blocks that ran least go to the end.
+    void Layout(const Profile* profile = nullptr);
+    // Replaces the body of `function` with the blocks in their new order,
+    // adding the jumps the order needs
+    void Write(Function& function, Arena& arena) const;
+
+  private:
+    struct Block
+    {
+        std::vector<std::string_view> labels;
+        std::vector<Command> code;            // neither labels nor the last jump
+        Parser::Cmd exit{ Parser::Cmd::Invalid }; // Goto, If, Return; Invalid: falls through
+        std::string_view target;              // of Goto and If
+        int jump{ -1 };                       // block of `target`, -1 outside the function
+        int next{ -1 };                       // falls into, -1 off the end of the function
+    };
+
+    bool FallsThrough(const Block& b) const;
+    int Resolve(int block) const;
+    std::vector<int> LoopDepths(std::vector<std::pair<int, int>>& back_edges) const;
+    std::vector<std::uint64_t> Counts(const Profile& profile) const;
+
+    bool _valid{ true };
+    Command _head;   // the function command
+    int _entry{ 0 }; // the block the function starts at
+    std::vector<Block> _blocks;
+    std::vector<int> _order; // of Layout
+};
+
+// The pass for Pipeline::AddPass: jump threading and block layout
+void
+OptimiseControlFlow(Function& function, Arena& arena);
+
+// The same pass laying out the blocks by `profile`, which must outlive it
+Pipeline::Pass
+ProfiledControlFlow(const Profile& profile);
+
+} // namespace Vm
+
+#endif
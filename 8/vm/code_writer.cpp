@@ -1,103 +1,271 @@
 #include "code_writer.h"
 #include "parser.h"
+#include "superopt_table.h"
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <format>
+#include <initializer_list>
 #include <ios>
 #include <iostream>
-#include <map>
+#include <iterator>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 namespace Vm {
 
 // スタック(RAM[256-2047])とセグメント(RAM[0-255])は別
 // Popはスタックの先頭からセグメントに値をコピー
 // Pushはスタックの先頭にセグメントから値をコピー
 
+using Asm::C;
+using Asm::Literal;
+
+// D = *--SP
+static constexpr Asm::Instruction POP_D[] = { Asm::At(Asm::SP), C("AM=M-1"), C("D=M") };
+// *SP++ = D
+static constexpr Asm::Instruction PUSH_D[] = { Asm::At(Asm::SP), C("A=M"), C("M=D"), Asm::At(Asm::SP),
+                                               C("M=M+1") };
+// *SP++ = D, moving SP first
+static constexpr Asm::Instruction INC_PUSH_D[] = { Asm::At(Asm::SP), C("M=M+1"), C("A=M-1"), C("M=D") };
+
+// Short symbol names such as JEQ_TRUE_3 or Main.2, built without allocating
+template <class... Args>
+static std::string_view
+Format(std::array<char, 128>& buf, std::format_string<Args...> fmt, Args&&... args)
+{
+    const auto r = std::format_to_n(buf.data(), buf.size(), fmt, std::forward<Args>(args)...);
+    return { buf.data(), static_cast<std::size_t>(r.out - buf.data()) };
+}
+
+// A candidate sequence of instructions. A generator keeps its own and
+// clears them for each command, so they stop allocating once warm.
+class Sequence
+{
+  public:
+    Sequence& Clear()
+    {
+        _code.clear();
+        return *this;
+    }
+    Sequence& Append(std::span<const Asm::Instruction> code)
+    {
+        _code.insert(_code.end(), code.begin(), code.end());
+        return *this;
+    }
+    Sequence& Append(std::initializer_list<Asm::Instruction> code)
+    {
+        return Append(std::span<const Asm::Instruction>{ code.begin(), code.size() });
+    }
+    // A sequence of superopt with `param` for its PARAM
+    Sequence& Append(std::span<const Superopt::Step> code, const Asm::Instruction param)
+    {
+        for (const Superopt::Step& s : code) {
+            _code.push_back(s.param ? param : s.instruction);
+        }
+        return *this;
+    }
+    Sequence& Repeat(const Asm::Instruction i, std::size_t n)
+    {
+        _code.insert(_code.end(), n, i);
+        return *this;
+    }
+
+    std::span<const Asm::Instruction> Code() const { return _code; }
+
+  private:
+    std::vector<Asm::Instruction> _code;
+};
+
+// Writes the cheapest of the sequences that do the same, by
+// Asm::INSTRUCTION_COST, and counts what that saved
+class Selector
+{
+  public:
+    // A way to write the command: `code`, then `tail`
+    struct Choice
+    {
+        std::span<const Asm::Instruction> code;
+        std::span<const Asm::Instruction> tail{};
+    };
+
+    void SetSelection(CodeWriter::Selection* selection) { _selection = selection; }
+
+  protected:
+    // Writes the cheapest of `choices`, the first on a tie. The first is the
+    // form written without selection.
+    void Select(Asm::Listing& out, std::initializer_list<Choice> choices);
+
+  private:
+    CodeWriter::Selection* _selection{ nullptr };
+};
+
+void
+Selector::Select(Asm::Listing& out, std::initializer_list<Choice> choices)
+{
+    auto cost = [](const Choice& c) { return Asm::Cost(c.code) + Asm::Cost(c.tail); };
+
+    const Choice* best = choices.begin();
+    const int first    = cost(*best);
+    int least          = first;
+    if (_selection != nullptr && _selection->enabled) {
+        for (const Choice& c : choices) {
+            if (cost(c) < least) {
+                best  = &c;
+                least = cost(c);
+            }
+        }
+    }
+    out.Append(best->code);
+    out.Append(best->tail);
+
+    if (_selection != nullptr) {
+        _selection->commands++;
+        _selection->rewritten += best != choices.begin();
+        _selection->saved += static_cast<std::size_t>(first - least);
+    }
+}
+
 // | SP |
-class RamAccessGenerator
+// What the segment generators share. Each one has WritePush and WritePop,
+// and hides InRange and Direct where its segment differs; the writer calls
+// them on the concrete type (Generators::Visit), so nothing is virtual.
+class RamAccessGenerator : public Selector
 {
   public:
-    virtual ~RamAccessGenerator()                               = default;
-    virtual void WritePush(std::ofstream& out, std::size_t idx) = 0;
-    virtual void WritePop(std::ofstream& out, std::size_t idx)  = 0;
+    // idx fits the segment (and an A-instruction)
+    bool InRange(std::size_t idx) const { return idx <= 0x7FFF; }
+    // @address of the word, for segments at fixed addresses
+    std::optional<Asm::Instruction> Direct(Asm::Listing& out, std::size_t idx)
+    {
+        (void)out;
+        (void)idx;
+        return std::nullopt;
+    }
+
+    // pop idx, push idx at the word `at` from Direct: the top of the stack
+    // stored and left there; false when the segment is not at a fixed address
+    bool WritePopPush(Asm::Listing& out, std::optional<Asm::Instruction> at);
 
     // SPの指すアドレスがスタックの先頭 or スタックの先頭の次？
-    static void Pop(std::ostream& out);
-    static void Push(std::ostream& out);
+    static void Pop(Asm::Listing& out);
+    static void Push(Asm::Listing& out);
+
+  protected:
+    // D loaded by `load`, then pushed either way
+    void SelectPush(Asm::Listing& out, const Sequence& load);
+
+  private:
+    Sequence _separate;
+    Sequence _fused;
 };
 
+bool
+RamAccessGenerator::WritePopPush(Asm::Listing& out, std::optional<Asm::Instruction> at)
+{
+    if (!at) {
+        return false;
+    }
+    _separate.Clear().Append(POP_D).Append({ *at, C("M=D"), *at, C("D=M") }).Append(PUSH_D);
+    _fused.Clear().Append(Superopt::POP_PUSH, *at);
+    Select(out, { { _separate.Code() }, { _fused.Code() } });
+    return true;
+}
+
+void
+RamAccessGenerator::SelectPush(Asm::Listing& out, const Sequence& load)
+{
+    Select(out, { { load.Code(), PUSH_D }, { load.Code(), INC_PUSH_D } });
+}
+
 void
-RamAccessGenerator::Pop(std::ostream& out)
+RamAccessGenerator::Pop(Asm::Listing& out)
 {
-    out << "@SP\n"
-           "AM=M-1\n"
-           "D=M\n";
+    out.Append(POP_D);
 }
 
 void
-RamAccessGenerator::Push(std::ostream& out)
+RamAccessGenerator::Push(Asm::Listing& out)
 {
-    out << "@SP\n"
-           "A=M\n"
-           "M=D\n"
-           "@SP\n"
-           "M=M+1\n";
+    out.Append(PUSH_D);
 }
 
 class StandardSegGenerator : public RamAccessGenerator
 {
   public:
-    StandardSegGenerator(const std::string& seg)
-      : _seg(seg) {};
+    StandardSegGenerator(Asm::Symbol seg)
+      : _seg(seg) {}
 
-    virtual void WritePush(std::ofstream& out, std::size_t idx) override
+    void WritePush(Asm::Listing& out, std::size_t idx)
     {
         // push argument 2
-        // push ARG[2] to stack
-        out << "@" << idx << "\n"
-            << "D=A\n"
-            << "@" + _seg + "\n"
-            << "A=D+M\n"
-               "D=M\n";
-
-        Push(out);
+        // push ARG[2] to stack: by the index, or stepping A to it
+        _indexed.Clear().Append({ Literal(idx), C("D=A"), Asm::At(_seg), C("A=D+M"), C("D=M") });
+        _stepped.Clear().Append({ Asm::At(_seg), C("A=M") }).Repeat(C("A=A+1"), idx).Append({ C("D=M") });
+
+        Select(out, {
+                      { _indexed.Code(), PUSH_D },
+                      { _indexed.Code(), INC_PUSH_D },
+                      { _stepped.Code(), PUSH_D },
+                      { _stepped.Code(), INC_PUSH_D },
+                    });
     }
 
-    virtual void WritePop(std::ofstream& out, std::size_t idx) override
+    void WritePop(Asm::Listing& out, std::size_t idx)
     {
         // pop argument 2
-        // stack to ARG[2]
-        Pop(out); // D = *SP
-        out << "@" << _seg << "\n"
-            << "A=M\n";
-        while (idx--) {
-            out << "A=A+1\n";
-        }
-        out << "M=D\n";
+        // stack to ARG[2]: stepping A to it, through an address in R13, or
+        // with D = address + value, A = D - value, M = D - address
+        _stepped.Clear().Append(POP_D).Append({ Asm::At(_seg), C("A=M") }).Repeat(C("A=A+1"), idx).Append({ C("M=D") });
+        _indexed.Clear()
+          .Append({ Literal(idx), C("D=A"), Asm::At(_seg), C("D=D+M"), Asm::At(Asm::R13), C("M=D") })
+          .Append(POP_D)
+          .Append({ Asm::At(Asm::R13), C("A=M"), C("M=D") });
+        _swapped.Clear().Append({ Literal(idx), C("D=A"), Asm::At(_seg), C("D=D+M"), Asm::At(Asm::SP), C("AM=M-1"),
+                                  C("D=D+M"), C("A=D-M"), C("M=D-A") });
+
+        Select(out, { { _stepped.Code() }, { _indexed.Code() }, { _swapped.Code() } });
     }
 
   private:
-    std::string _seg; // argument, local, this, that
+    Asm::Symbol _seg; // argument, local, this, that
+    Sequence _indexed;
+    Sequence _stepped;
+    Sequence _swapped;
 };
 
 class ConstantGenerator : public RamAccessGenerator
 {
   public:
-    virtual void WritePush(std::ofstream& out, std::size_t idx) override
+    void WritePush(Asm::Listing& out, std::size_t idx)
     {
         // push constant 22
-        out << "@" << idx << "\n"
-            << "D=A\n";
-        Push(out);
+        _load.Clear().Append({ Literal(idx), C("D=A") });
+        if (idx > 1) {
+            SelectPush(out, _load);
+            return;
+        }
+        // 0 and 1 are stored without D
+        const Asm::Instruction store = idx == 0 ? C("M=0") : C("M=1");
+        _store.Clear().Append({ Asm::At(Asm::SP), C("M=M+1"), C("A=M-1"), store });
+        Select(out, { { _load.Code(), PUSH_D }, { _load.Code(), INC_PUSH_D }, { _store.Code() } });
     }
 
-    virtual void WritePop(std::ofstream& out, std::size_t idx) override
+    void WritePop(Asm::Listing& out, std::size_t idx)
     {
         (void)out;
         (void)idx;
     }
+
+  private:
+    Sequence _load;
+    Sequence _store;
 };
 
 class StaticGenerator : public RamAccessGenerator
@@ -106,43 +274,62 @@ class StaticGenerator : public RamAccessGenerator
 
   public:
     StaticGenerator(const std::string& filename)
-      : _filename(filename) {};
+      : _filename(filename) {}
 
-    virtual void WritePush(std::ofstream& out, std::size_t idx) override
+    void WritePush(Asm::Listing& out, std::size_t idx)
     {
-        out << "@" << _filename + "." << idx << "\n"
-            << "D=M\n";
-        Push(out);
-    };
+        std::array<char, 128> buf;
+        _load.Clear().Append({ Asm::At(out.Intern(Format(buf, "{}.{}", _filename, idx))), C("D=M") });
+        SelectPush(out, _load);
+    }
 
-    virtual void WritePop(std::ofstream& out, std::size_t idx) override
+    void WritePop(Asm::Listing& out, std::size_t idx)
     {
+        std::array<char, 128> buf;
         Pop(out);
-        out << "@" << _filename + "." << idx << "\n"
-            << "M=D\n";
+        out.At(Format(buf, "{}.{}", _filename, idx));
+        out.Append(C("M=D"));
+    }
+
+    std::optional<Asm::Instruction> Direct(Asm::Listing& out, std::size_t idx)
+    {
+        std::array<char, 128> buf;
+        return Asm::At(out.Intern(Format(buf, "{}.{}", _filename, idx)));
     }
+
+  private:
+    Sequence _load;
 };
 
 class PointerGenerator : public RamAccessGenerator
 {
-    static constexpr std::string_view SEG[2] = { "THIS", "THAT" };
+    static constexpr Asm::Symbol SEG[2] = { Asm::THIS, Asm::THAT };
 
   public:
-    virtual void WritePush(std::ofstream& out, std::size_t idx) override
+    bool InRange(std::size_t idx) const { return idx < 2; }
+
+    void WritePush(Asm::Listing& out, std::size_t idx)
     {
-        out << "@" << SEG[idx] << "\n"
-            << "D=M\n";
-        Push(out);
+        _load.Clear().Append({ Asm::At(SEG[idx]), C("D=M") });
+        SelectPush(out, _load);
     }
 
-    virtual void WritePop(std::ofstream& out, std::size_t idx) override
+    void WritePop(Asm::Listing& out, std::size_t idx)
     {
         // pop this 6
         // pop that 2
         Pop(out);
-        out << "@" << SEG[idx] << "\n"
-            << "M=D\n";
+        out.Append({ Asm::At(SEG[idx]), C("M=D") });
+    }
+
+    std::optional<Asm::Instruction> Direct(Asm::Listing& out, std::size_t idx)
+    {
+        (void)out;
+        return Asm::At(SEG[idx]);
     }
+
+  private:
+    Sequence _load;
 };
 
 class TempGenerator : public RamAccessGenerator
@@ -150,217 +337,333 @@ class TempGenerator : public RamAccessGenerator
     constexpr static int BASE = 5;
 
   public:
-    virtual void WritePush(std::ofstream& out, std::size_t idx) override
+    bool InRange(std::size_t idx) const { return idx < 8; }
+
+    void WritePush(Asm::Listing& out, std::size_t idx)
     {
         // push temp 6
-        out << "@" << (idx + BASE) << "\n"
-            << "D=M\n";
-        Push(out);
+        _load.Clear().Append({ Literal(idx + BASE), C("D=M") });
+        SelectPush(out, _load);
     }
 
-    virtual void WritePop(std::ofstream& out, std::size_t idx) override
+    void WritePop(Asm::Listing& out, std::size_t idx)
     {
         // pop temp 6
         Pop(out);
-        out << "@" << (idx + BASE) << "\n"
-            << "M=D\n";
+        out.Append({ Literal(idx + BASE), C("M=D") });
     }
+
+    std::optional<Asm::Instruction> Direct(Asm::Listing& out, std::size_t idx)
+    {
+        (void)out;
+        return Literal(idx + BASE);
+    }
+
+  private:
+    Sequence _load;
 };
 
-class ArithmeticGenerator
+// What the operator generators share. Each one has WriteArithmetic and
+// hides the defaults below that apply to it.
+class ArithmeticGenerator : public Selector
 {
   public:
-    ~ArithmeticGenerator()                           = default;
-    virtual void WriteArithmetic(std::ofstream& out) = 0;
-
-  protected:
-    void Pop2DReg(std::ostream& out)
+    // A push and then this command, in one sequence: the push loads D with
+    // `load`, D=A for a constant and D=M for an address. false when superopt
+    // has no sequence for the pair.
+    bool WriteAfterPush(Asm::Listing& out, Asm::Instruction load, bool constant)
     {
-        out << "@SP\n"
-               "AM=M-1\n"
-               "D=M\n";
+        (void)out;
+        (void)load;
+        (void)constant;
+        return false;
     }
+    // Calls a routine written once instead of writing the command in full
+    // where it can; see CodeWriter::SetCompact
+    void SetOutOfLine(bool on) { (void)on; }
+    // The routine, when it has been called and not written yet
+    void WriteRoutine(Asm::Listing& out) { (void)out; }
 
-    void Sub(std::ostream& out)
+  protected:
+    void Pop2DReg(Asm::Listing& out) { out.Append(POP_D); }
+
+    // POP_D and `tail`, or `code` of superopt
+    void WriteStack(Asm::Listing& out, std::span<const Asm::Instruction> tail, std::span<const Superopt::Step> code)
     {
-        out << "@SP\n"
-               "AM=M-1\n"
-               "D=M-D\n";
+        _fused.Clear().Append(code, {});
+        Select(out, { { POP_D, tail }, { _fused.Code() } });
     }
 
-    void PushFalse(std::ostream& out)
+    // The push of WriteAfterPush, POP_D and `tail`; or the sequence of
+    // superopt, `with_constant` or `with_direct`
+    void WritePair(Asm::Listing& out, Asm::Instruction load, bool constant, std::span<const Asm::Instruction> tail,
+                   std::span<const Superopt::Step> with_constant, std::span<const Superopt::Step> with_direct)
     {
-        out << "@SP\n"
-               "A=M\n"
-               "M=0\n";
+        _separate.Clear().Append({ load, constant ? C("D=A") : C("D=M") }).Append(PUSH_D).Append(POP_D).Append(tail);
+        _fused.Clear().Append(constant ? with_constant : with_direct, load);
+        Select(out, { { _separate.Code() }, { _fused.Code() } });
     }
 
-    void PushTrue(const std::string& jump, const int id, std::ostream& out)
+    void Sub(Asm::Listing& out) { out.Append({ Asm::At(Asm::SP), C("AM=M-1"), C("D=M-D") }); }
+
+    void PushFalse(Asm::Listing& out) { out.Append({ Asm::At(Asm::SP), C("A=M"), C("M=0") }); }
+
+    void PushTrue(const std::string_view jump, const std::uint16_t d_jump, const int id, Asm::Listing& out)
     {
-        auto&& true_label      = std::format("({}_{}_{})", jump, "TRUE", id);
-        auto&& end_label       = std::format("({}_{}_{})", jump, "END", id);
-        auto&& call_true_label = std::format("@{}_{}_{}", jump, "TRUE", id);
-        auto&& call_end_label  = std::format("@{}_{}_{}", jump, "END", id);
+        std::array<char, 128> buf;
+        const Asm::Symbol true_label = out.Intern(Format(buf, "{}_{}_{}", jump, "TRUE", id));
+        const Asm::Symbol end_label  = out.Intern(Format(buf, "{}_{}_{}", jump, "END", id));
 
-        out << call_true_label << "\n"
-            << "D;" + jump << "\n"
-            << call_end_label << "\n"
-            << "0;JMP\n";
+        out.Append(Asm::At(true_label));
+        out.C(d_jump);
+        out.Append({ Asm::At(end_label), C("0;JMP") });
 
-        out << true_label << "\n"
-            << "@SP\n"
-               "A=M\n"
-               "M=-1\n";
+        out.Append({ Asm::Label(true_label), Asm::At(Asm::SP), C("A=M"), C("M=-1") });
 
-        out << end_label << "\n"
-            << "@SP\n"
-               "M=M+1\n";
+        out.Append({ Asm::Label(end_label), Asm::At(Asm::SP), C("M=M+1") });
     }
+
+  private:
+    Sequence _separate;
+    Sequence _fused;
 };
 
 // add  : x+y
 class AddGenerator : public ArithmeticGenerator
 {
-    virtual void WriteArithmetic(std::ofstream& out) final
+    static constexpr Asm::Instruction TAIL[] = { Asm::At(Asm::SP), C("A=M-1"), C("M=D+M") };
+
+  public:
+    void WriteArithmetic(Asm::Listing& out) { WriteStack(out, TAIL, Superopt::ADD); }
+
+    bool WriteAfterPush(Asm::Listing& out, Asm::Instruction load, bool constant)
     {
-        Pop2DReg(out);
-        out << "@SP\n"
-               "A=M-1\n"
-               "M=D+M\n";
-    };
+        WritePair(out, load, constant, TAIL, Superopt::PUSH_CONSTANT_ADD, Superopt::PUSH_DIRECT_ADD);
+        return true;
+    }
 };
 
 // sub  : x-y
 class SubGenerator : public ArithmeticGenerator
 {
-    virtual void WriteArithmetic(std::ofstream& out) final
+    static constexpr Asm::Instruction TAIL[] = { Asm::At(Asm::SP), C("A=M-1"), C("M=M-D") };
+
+  public:
+    void WriteArithmetic(Asm::Listing& out) { WriteStack(out, TAIL, Superopt::SUB); }
+
+    bool WriteAfterPush(Asm::Listing& out, Asm::Instruction load, bool constant)
     {
-        Pop2DReg(out);
-        out << "@SP\n"
-               "A=M-1\n"
-               "M=M-D\n";
-    };
+        WritePair(out, load, constant, TAIL, Superopt::PUSH_CONSTANT_SUB, Superopt::PUSH_DIRECT_SUB);
+        return true;
+    }
 };
 
 // neg  : -y
 class NegGenerator : public ArithmeticGenerator
 {
-    virtual void WriteArithmetic(std::ofstream& out) final
-    {
-        Pop2DReg(out);
-        out << "@SP\n"
-               "A=M\n"
-               "M=-D\n"
-               "@SP\n"
-               "M=M+1\n";
-    };
+    static constexpr Asm::Instruction TAIL[] = { Asm::At(Asm::SP), C("A=M"), C("M=-D"), Asm::At(Asm::SP),
+                                                 C("M=M+1") };
+
+  public:
+    void WriteArithmetic(Asm::Listing& out) { WriteStack(out, TAIL, Superopt::NEG); }
 };
 
-// eq   : x == y
-class EqGenerator : public ArithmeticGenerator
+// eq, gt, lt: x - y tested by `d_jump`, such as D;JEQ for eq
+// Out of line, the test is a routine shared by every comparison of the
+// same kind: the call site leaves its return address in D and the routine
+// keeps it in R13. Four instructions instead of twenty, for the jump there
+// and back on every run.
+class CompareGenerator : public ArithmeticGenerator
 {
-    virtual void WriteArithmetic(std::ofstream& out) final
+  public:
+    CompareGenerator(std::string_view jump, std::uint16_t d_jump)
+      : _jump(jump)
+      , _d_jump(d_jump)
     {
-        static int id = 0;
+    }
 
+    void WriteArithmetic(Asm::Listing& out)
+    {
+        if (_out_of_line) {
+            WriteCall(out);
+            return;
+        }
         // pop y into D
         Pop2DReg(out);
         // pop x and compute D = x - y
         Sub(out);
         // default: push false (0)
         PushFalse(out);
-        // if equal, set true (-1)
-        PushTrue("JEQ", id++, out);
-    };
-};
+        // if the test holds, set true (-1)
+        PushTrue(_jump, _d_jump, _id++, out);
+    }
 
-// gt   : x > y
-class GtGenerator : public ArithmeticGenerator
-{
-    virtual void WriteArithmetic(std::ofstream& out) final
-    {
-        static int id = 0;
+    void SetOutOfLine(bool on) { _out_of_line = on; }
 
-        // pop y into D
-        Pop2DReg(out);
-        // pop x and compute D = x - y
-        Sub(out);
-        // default: push false (0)
-        PushFalse(out);
-        // if greater, set true (-1)
-        PushTrue("JGT", id++, out);
-    };
-};
+    void WriteRoutine(Asm::Listing& out)
+    {
+        if (!_called || _written) {
+            return;
+        }
+        std::array<char, 128> buf;
+        const Asm::Symbol routine = out.Intern(Format(buf, "{}_ROUTINE", _jump));
+        const Asm::Symbol end     = out.Intern(Format(buf, "{}_ROUTINE_END", _jump));
+        out.Append({ Asm::Label(routine), Asm::At(Asm::R13), C("M=D") });
+        // x = -1, then 0 unless the test holds; one word less on the stack
+        out.Append({ Asm::At(Asm::SP), C("AM=M-1"), C("D=M"), C("A=A-1"), C("D=M-D"), C("M=-1") });
+        out.Append(Asm::At(end));
+        out.C(_d_jump);
+        out.Append({ Asm::At(Asm::SP), C("A=M-1"), C("M=0") });
+        out.Append({ Asm::Label(end), Asm::At(Asm::R13), C("A=M"), C("0;JMP") });
+        _written = true;
+    }
 
-// lt   : x < y
-class LtGenerator : public ArithmeticGenerator
-{
-    virtual void WriteArithmetic(std::ofstream& out) final
+  private:
+    void WriteCall(Asm::Listing& out)
     {
-        static int id = 0;
+        std::array<char, 128> buf;
+        const Asm::Symbol ret     = out.Intern(Format(buf, "{}_RET_{}", _jump, _id++));
+        const Asm::Symbol routine = out.Intern(Format(buf, "{}_ROUTINE", _jump));
+        out.Append({ Asm::At(ret), C("D=A"), Asm::At(routine), C("0;JMP"), Asm::Label(ret) });
+        _called = true;
+    }
 
-        // pop y into D
-        Pop2DReg(out);
-        // pop x and compute D = x - y
-        Sub(out);
-        // default: push false (0)
-        PushFalse(out);
-        // if less, set true (-1)
-        PushTrue("JLT", id++, out);
-    };
+    std::string_view _jump;
+    std::uint16_t _d_jump;
+    int _id{ 0 }; // labels of this writer
+    bool _out_of_line{ false };
+    bool _called{ false };  // the routine is needed
+    bool _written{ false }; // and has been written
 };
 
 // and  : x & y
 class AndGenerator : public ArithmeticGenerator
 {
-    virtual void WriteArithmetic(std::ofstream& out) final
+    static constexpr Asm::Instruction TAIL[] = { Asm::At(Asm::SP), C("A=M-1"), C("M=D&M") };
+
+  public:
+    void WriteArithmetic(Asm::Listing& out) { WriteStack(out, TAIL, Superopt::AND); }
+
+    bool WriteAfterPush(Asm::Listing& out, Asm::Instruction load, bool constant)
     {
-        Pop2DReg(out);
-        out << "@SP\n"
-               "A=M-1\n"
-               "M=D&M\n";
-    };
+        WritePair(out, load, constant, TAIL, Superopt::PUSH_CONSTANT_AND, Superopt::PUSH_DIRECT_AND);
+        return true;
+    }
 };
 
 // or   : x | y
 class OrGenerator : public ArithmeticGenerator
 {
-    virtual void WriteArithmetic(std::ofstream& out) final
+    static constexpr Asm::Instruction TAIL[] = { Asm::At(Asm::SP), C("A=M-1"), C("M=D|M") };
+
+  public:
+    void WriteArithmetic(Asm::Listing& out) { WriteStack(out, TAIL, Superopt::OR); }
+
+    bool WriteAfterPush(Asm::Listing& out, Asm::Instruction load, bool constant)
     {
-        Pop2DReg(out);
-        out << "@SP\n"
-               "A=M-1\n"
-               "M=D|M\n";
-    };
+        WritePair(out, load, constant, TAIL, Superopt::PUSH_CONSTANT_OR, Superopt::PUSH_DIRECT_OR);
+        return true;
+    }
 };
 
 // not  : !y
 class NotGenerator : public ArithmeticGenerator
 {
-    virtual void WriteArithmetic(std::ofstream& out) final
-    {
-        Pop2DReg(out);
-        out << "@SP\n"
-               "A=M\n"
-               "M=!D\n"
-               "@SP\n"
-               "M=M+1\n";
-    };
+    static constexpr Asm::Instruction TAIL[] = { Asm::At(Asm::SP), C("A=M"), C("M=!D"), Asm::At(Asm::SP),
+                                                 C("M=M+1") };
+
+  public:
+    void WriteArithmetic(Asm::Listing& out) { WriteStack(out, TAIL, Superopt::NOT); }
 };
 
-static const std::map<std::string, std::shared_ptr<ArithmeticGenerator>> ARITH_GENS{
-    { "add", std::make_shared<AddGenerator>() },
-    { "sub", std::make_shared<SubGenerator>() },
-    { "neg", std::make_shared<NegGenerator>() },
-    {  "eq",  std::make_shared<EqGenerator>() },
-    {  "gt",  std::make_shared<GtGenerator>() },
-    {  "lt",  std::make_shared<LtGenerator>() },
-    { "and", std::make_shared<AndGenerator>() },
-    {  "or",  std::make_shared<OrGenerator>() },
-    { "not", std::make_shared<NotGenerator>() },
+// The generators of a writer, each as its own type: dispatch on the enums
+// of the parser is a switch, and every call it makes is bound at compile
+// time
+struct Generators
+{
+    explicit Generators(const std::string& filename)
+      : statics(filename)
+    {
+    }
+
+    StandardSegGenerator argument{ Asm::ARG };
+    StandardSegGenerator local{ Asm::LCL };
+    StaticGenerator statics;
+    ConstantGenerator constant;
+    StandardSegGenerator this_{ Asm::THIS };
+    StandardSegGenerator that{ Asm::THAT };
+    PointerGenerator pointer;
+    TempGenerator temp;
+
+    // eq/gt/lt number their labels per writer
+    AddGenerator add;
+    SubGenerator sub;
+    NegGenerator neg;
+    CompareGenerator eq{ "JEQ", C("D;JEQ").word };
+    CompareGenerator gt{ "JGT", C("D;JGT").word };
+    CompareGenerator lt{ "JLT", C("D;JLT").word };
+    AndGenerator and_;
+    OrGenerator or_;
+    NotGenerator not_;
+
+    // f(generator of seg); nothing for Segment::Invalid
+    template <class F>
+    decltype(auto) Visit(Parser::Segment seg, F&& f)
+    {
+        using R = decltype(f(constant));
+        switch (seg) {
+            case Parser::Segment::Argument: return f(argument);
+            case Parser::Segment::Local: return f(local);
+            case Parser::Segment::Static: return f(statics);
+            case Parser::Segment::Constant: return f(constant);
+            case Parser::Segment::This: return f(this_);
+            case Parser::Segment::That: return f(that);
+            case Parser::Segment::Pointer: return f(pointer);
+            case Parser::Segment::Temp: return f(temp);
+            case Parser::Segment::Invalid: break;
+        }
+        return R();
+    }
+
+    // f(generator of op); nothing for Op::Invalid
+    template <class F>
+    decltype(auto) Visit(Parser::Op op, F&& f)
+    {
+        using R = decltype(f(add));
+        switch (op) {
+            case Parser::Op::Add: return f(add);
+            case Parser::Op::Sub: return f(sub);
+            case Parser::Op::Neg: return f(neg);
+            case Parser::Op::Eq: return f(eq);
+            case Parser::Op::Gt: return f(gt);
+            case Parser::Op::Lt: return f(lt);
+            case Parser::Op::And: return f(and_);
+            case Parser::Op::Or: return f(or_);
+            case Parser::Op::Not: return f(not_);
+            case Parser::Op::Invalid: break;
+        }
+        return R();
+    }
+
+    // in the order of Parser::OP_NAMES
+    template <class F>
+    void ForEachOp(F&& f)
+    {
+        for (std::size_t i = 0; i < std::size(Parser::OP_NAMES); i++) {
+            Visit(static_cast<Parser::Op>(i), f);
+        }
+    }
+    template <class F>
+    void ForEachSegment(F&& f)
+    {
+        for (std::size_t i = 0; i < std::size(Parser::SEGMENT_NAMES); i++) {
+            Visit(static_cast<Parser::Segment>(i), f);
+        }
+    }
 };
 
 CodeWriter::CodeWriter(const std::string& out_path)
+  : _listing(_text)
 {
     // open output file
     try {
@@ -369,27 +672,50 @@ CodeWriter::CodeWriter(const std::string& out_path)
         std::cerr << e.what() << '\n';
         std::exit(1);
     }
+    _sink = [this](std::string_view text) { _out.write(text.data(), static_cast<std::streamsize>(text.size())); };
 
-    _stack_gens.emplace("argument", std::make_shared<StandardSegGenerator>("ARG"));
-    _stack_gens.emplace("local", std::make_shared<StandardSegGenerator>("LCL"));
-    _stack_gens.emplace("this", std::make_shared<StandardSegGenerator>("THIS"));
-    _stack_gens.emplace("that", std::make_shared<StandardSegGenerator>("THAT"));
-    _stack_gens.emplace("constant", std::make_shared<ConstantGenerator>());
-    _stack_gens.emplace("static", std::make_shared<StaticGenerator>(_filename));
-    _stack_gens.emplace("pointer", std::make_shared<PointerGenerator>());
-    _stack_gens.emplace("temp", std::make_shared<TempGenerator>());
+    Init(true);
+}
+
+CodeWriter::CodeWriter(Asm::Sink sink)
+  : _sink(std::move(sink))
+  , _listing(_text)
+{
+    Init(true);
+}
+
+CodeWriter::CodeWriter(Asm::Listing& listing, bool bootstrap)
+  : _listing(listing)
+{
+    Init(bootstrap);
+}
+
+void
+CodeWriter::Init(bool bootstrap)
+{
+    _gens = std::make_unique<Generators>(_filename);
+    if (_sink) {
+        _asm.reserve(ASM_BLOCK + ASM_BLOCK / 4);
+    }
+    _gens->ForEachSegment([this](auto& gen) { gen.SetSelection(&_selection); });
+    _gens->ForEachOp([this](auto& gen) { gen.SetSelection(&_selection); });
+
+    _program = bootstrap;
+    if (!bootstrap) {
+        return;
+    }
 
     // boot strap code
-    _out << "@256\n"
-            "D=A\n"
-            "@SP\n"
-            "M=D\n";
+    _listing.Append({ Literal(256), C("D=A"), Asm::At(Asm::SP), C("M=D") });
 
     // call sys.init
     WriteCall("Sys.init", 0);
 }
 
-CodeWriter::~CodeWriter() {}
+CodeWriter::~CodeWriter()
+{
+    Close();
+}
 
 void
 CodeWriter::SetFileName(const std::string& filename)
@@ -398,133 +724,334 @@ CodeWriter::SetFileName(const std::string& filename)
 }
 
 void
-CodeWriter::WriteArithmetic(const std::string& cmd_line)
+CodeWriter::WriteArithmetic(std::string_view cmd_line)
+{
+    const Parser::Op op = Parser::ToOp(cmd_line);
+    if (op == Parser::Op::Invalid) {
+        std::cerr << "Invalid command: " << cmd_line << "\n";
+        return;
+    }
+    WriteArithmetic(op);
+}
+
+void
+CodeWriter::WriteArithmetic(Parser::Op op)
+{
+    _gens->Visit(op, [this](auto& gen) { gen.WriteArithmetic(_listing); });
+}
+
+void
+CodeWriter::WritePushPop(Parser::Cmd cmd, std::string_view seg, const size_t idx)
+{
+    const Parser::Segment segment = Parser::ToSegment(seg);
+    if (segment == Parser::Segment::Invalid) {
+        std::cerr << "Invalid segment: " << seg << " " << idx << "\n";
+        return;
+    }
+    WritePushPop(cmd, segment, idx);
+}
+
+void
+CodeWriter::WritePushPop(Parser::Cmd cmd, Parser::Segment seg, const size_t idx)
+{
+    _gens->Visit(seg, [&](auto& gen) {
+        if (!gen.InRange(idx)) {
+            std::cerr << "Invalid segment: " << Parser::SEGMENT_NAMES[static_cast<int>(seg)] << " " << idx << "\n";
+            return;
+        }
+
+        switch (cmd) {
+            case Parser::Cmd::Push: {
+                gen.WritePush(_listing, idx);
+            } break;
+
+            case Parser::Cmd::Pop: {
+                gen.WritePop(_listing, idx);
+            } break;
+
+            case Parser::Cmd::Call:
+            case Parser::Cmd::Function:
+            case Parser::Cmd::Return:
+            case Parser::Cmd::Arithmetic:
+            case Parser::Cmd::Goto:
+            case Parser::Cmd::If:
+            case Parser::Cmd::IfNot:
+            case Parser::Cmd::Label:
+            case Parser::Cmd::Invalid:
+                break;
+        }
+    });
+}
+
+void
+CodeWriter::WritePushArithmetic(std::string_view seg, const size_t idx, std::string_view cmd)
 {
-    auto&& gen = ARITH_GENS.at(cmd_line);
-    gen->WriteArithmetic(_out);
+    const Parser::Segment segment = Parser::ToSegment(seg);
+    const Parser::Op op           = Parser::ToOp(cmd);
+    if (segment == Parser::Segment::Invalid || op == Parser::Op::Invalid) {
+        WritePushPop(Parser::Cmd::Push, seg, idx);
+        WriteArithmetic(cmd);
+        return;
+    }
+    WritePushArithmetic(segment, idx, op);
 }
 
 void
-CodeWriter::WritePushPop(Parser::Cmd cmd, const std::string& seg, const size_t idx)
+CodeWriter::WritePushArithmetic(Parser::Segment seg, const size_t idx, Parser::Op op)
 {
-    switch (cmd) {
-        case Parser::Cmd::Push: {
-            auto&& gen = _stack_gens.at(seg);
-            gen->WritePush(_out, idx);
-        } break;
+    const bool fused = _gens->Visit(seg, [&](auto& stack) {
+        if (!stack.InRange(idx)) {
+            return false;
+        }
+        const bool constant = seg == Parser::Segment::Constant;
+        const auto load     = constant ? Literal(idx) : stack.Direct(_listing, idx);
+        return load && _gens->Visit(op, [&](auto& arith) { return arith.WriteAfterPush(_listing, *load, constant); });
+    });
+    if (fused) {
+        return;
+    }
+    WritePushPop(Parser::Cmd::Push, seg, idx);
+    WriteArithmetic(op);
+}
 
-        case Parser::Cmd::Pop: {
-            auto&& gen = _stack_gens.at(seg);
-            gen->WritePop(_out, idx);
-        } break;
+void
+CodeWriter::WritePopPush(std::string_view seg, const size_t idx)
+{
+    const Parser::Segment segment = Parser::ToSegment(seg);
+    if (segment == Parser::Segment::Invalid) {
+        WritePushPop(Parser::Cmd::Pop, seg, idx);
+        WritePushPop(Parser::Cmd::Push, seg, idx);
+        return;
+    }
+    WritePopPush(segment, idx);
+}
 
-        case Parser::Cmd::Call:
-        case Parser::Cmd::Function:
-        case Parser::Cmd::Return:
-        case Parser::Cmd::Arithmetic:
-        case Parser::Cmd::Goto:
-        case Parser::Cmd::If:
-        case Parser::Cmd::Label:
-        case Parser::Cmd::Invalid:
-            break;
+void
+CodeWriter::WritePopPush(Parser::Segment seg, const size_t idx)
+{
+    const bool fused = _gens->Visit(seg, [&](auto& gen) {
+        return gen.InRange(idx) && gen.WritePopPush(_listing, gen.Direct(_listing, idx));
+    });
+    if (fused) {
+        return;
     }
+    WritePushPop(Parser::Cmd::Pop, seg, idx);
+    WritePushPop(Parser::Cmd::Push, seg, idx);
 }
 
 void
-CodeWriter::WriteLabel(const std::string& label)
+CodeWriter::WriteLabel(std::string_view label)
 {
-    _out << std::format("({})\n", label);
+    _listing.Label(label);
 }
 
 void
-CodeWriter::WriteGoto(const std::string& label)
+CodeWriter::WriteGoto(std::string_view label)
 {
-    _out << '@' << label << '\n' << "0;JMP\n";
+    _listing.At(label);
+    _listing.Append(C("0;JMP"));
 }
 
 void
-CodeWriter::WriteIf(const std::string& label)
+CodeWriter::WriteIf(std::string_view label)
 {
+    _listing.Append(POP_D);
+    _listing.At(label);
+    _listing.Append(C("D;JNE"));
+}
 
-    _out << "@SP\n"
-            "AM=M-1\n"
-            "D=M\n"
-         << "@" << label << '\n'
-         << "D;JNE\n";
+void
+CodeWriter::WriteIfNot(std::string_view label)
+{
+    _listing.Append(POP_D);
+    _listing.At(label);
+    _listing.Append(C("D;JEQ"));
 }
 
 void
-CodeWriter::WriteFuntion(const std::string& function_name, const int n_vars)
+CodeWriter::WriteFuntion(std::string_view function_name, const int n_vars)
 {
-    _out << std::format("({})\n", function_name);
-    for (int i = 0; i < n_vars; i++) {
-        _out << "@SP\n"
-                "A=M\n"
-                "M=0\n"
-                "@SP\n"
-                "M=M+1\n";
+    _listing.Label(function_name);
+    _function = function_name;
+    _frame    = Callee(function_name);
+
+    if (n_vars == 1) {
+        _listing.Append({ Asm::At(Asm::SP), C("A=M"), C("M=0"), Asm::At(Asm::SP), C("M=M+1") });
+    } else if (n_vars > 1) {
+        // zero the locals in a row, then move SP once
+        _listing.Append({ Asm::At(Asm::SP), C("A=M"), C("M=0") });
+        for (int i = 1; i < n_vars; i++) {
+            _listing.Append({ C("A=A+1"), C("M=0") });
+        }
+        _listing.Append({ C("D=A+1"), Asm::At(Asm::SP), C("M=D") });
     }
 }
 
-std::string
-MakeReturnSymbol(const std::string& filename, const std::string& label, const int idx)
+void
+CodeWriter::SetConventions(const Conventions* conventions)
+{
+    _conventions = conventions;
+}
+
+Frame
+CodeWriter::Callee(std::string_view function_name) const
+{
+    return _conventions != nullptr ? _conventions->Of(function_name) : Frame{};
+}
+
+// File.f$ret.3 into `out`, which keeps its capacity from call to call
+static std::string_view
+MakeReturnSymbol(std::string& out, std::string_view filename, std::string_view label, const int idx)
 {
+    out.clear();
     if (filename.empty()) {
-        return std::format("{}$ret.{}", label, idx);
+        std::format_to(std::back_inserter(out), "{}$ret.{}", label, idx);
+    } else {
+        std::format_to(std::back_inserter(out), "{}.{}$ret.{}", filename, label, idx);
     }
-
-    return std::format("{}.{}$ret.{}", filename, label, idx);
+    return out;
 }
 
 void
-CodeWriter::WriteCall(const std::string& function_name, const int n_vars)
+CodeWriter::WriteCall(std::string_view function_name, const int n_vars)
 {
-    // call count in runtime
-    static int idx = 0;
+    const Frame frame = Callee(function_name);
 
     // push return address
-    const auto symbol = MakeReturnSymbol(_filename, function_name, idx);
-    _out << "@" << symbol << "\n"
-         << "D=A\n";
-    RamAccessGenerator::Push(_out);
+    const Asm::Symbol symbol = _listing.Intern(MakeReturnSymbol(_symbol, _filename, function_name, _calls));
+    _listing.Append({ Asm::At(symbol), C("D=A") });
+    RamAccessGenerator::Push(_listing);
 
     // push LCL ARG THIS THAT
-    // 親の値を保存しておく
-    auto push_label = [](std::ofstream& out, const std::string& label) {
-        out << "@" << label << "\n"
-            << "D=M\n";
+    // 親の値を保存しておく (callee が変えないものは省く)
+    auto push_label = [](Asm::Listing& out, const Asm::Symbol label) {
+        out.Append({ Asm::At(label), C("D=M") });
         RamAccessGenerator::Push(out);
     };
 
-    push_label(_out, "LCL");
-    push_label(_out, "ARG");
-    push_label(_out, "THIS");
-    push_label(_out, "THAT");
+    if (frame.lcl) {
+        push_label(_listing, Asm::LCL);
+    }
+    push_label(_listing, Asm::ARG);
+    if (frame.this_that) {
+        push_label(_listing, Asm::THIS);
+        push_label(_listing, Asm::THAT);
+    }
 
     // 関数内のデータに上書き
-    // ARG = SP-5-nArgs
-    _out << "@" << 5 + n_vars
-         << "\n"
-            "D=A\n"
-            "@SP\n"
-            "D=M-D\n"
-            "@ARG\n"
-            "M=D\n";
+    // ARG = SP-frame-nArgs
+    _listing.Append({ Literal(frame.Size() + n_vars), C("D=A"), Asm::At(Asm::SP), C("D=M-D"), Asm::At(Asm::ARG),
+                      C("M=D") });
 
     // LCL = SP
-    _out << "@SP\n"
-            "D=M\n"
-            "@LCL\n"
-            "M=D\n";
+    if (frame.lcl) {
+        _listing.Append({ Asm::At(Asm::SP), C("D=M"), Asm::At(Asm::LCL), C("M=D") });
+    }
 
     // goto f
     this->WriteGoto(function_name);
 
     // (return symbol)
-    _out << '(' << symbol << ")\n";
+    _listing.Append(Asm::Label(symbol));
 
     // Increment for next call
-    idx++;
+    _calls++;
+}
+
+void
+CodeWriter::WriteTailCall(std::string_view function_name, const int n_vars)
+{
+    // self-recursion: the frame stays where it is, so the arguments are
+    // overwritten and the function starts over (and zeroes its locals again)
+    if (function_name == _function && _frame.n_args == n_vars) {
+        for (int i = n_vars - 1; i >= 0; i--) {
+            _listing.Append(POP_D);
+            _listing.Append({ Asm::At(Asm::ARG), C("A=M") });
+            for (int k = 0; k < i; k++) {
+                _listing.Append(C("A=A+1"));
+            }
+            _listing.Append(C("M=D"));
+        }
+        // SP = end of the frame
+        if (_frame.lcl) {
+            _listing.Append({ Asm::At(Asm::LCL), C("D=M") });
+        } else {
+            _listing.Append({ Asm::At(Asm::ARG), C("D=M"), Literal(n_vars + _frame.Size()), C("D=D+A") });
+        }
+        _listing.Append({ Asm::At(Asm::SP), C("M=D") });
+        WriteGoto(function_name);
+        return;
+    }
+
+    const Frame frame = Callee(function_name);
+    // the callee would not restore THIS/THAT changed here for our caller
+    if (_frame.this_that && !frame.this_that) {
+        WriteCall(function_name, n_vars);
+        WriteReturn();
+        return;
+    }
+
+    // R13 = end of our frame, the one our caller built
+    if (_frame.lcl) {
+        _listing.Append({ Asm::At(Asm::LCL), C("D=M"), Asm::At(Asm::R13), C("M=D") });
+    } else {
+        _listing.Append({ Asm::At(Asm::ARG), C("D=M"), Literal(_frame.n_args + _frame.Size()), C("D=D+A"),
+                          Asm::At(Asm::R13), C("M=D") });
+    }
+
+    // build the callee's frame above its arguments from the saved values;
+    // what our frame does not hold is still in its register
+    int offset      = _frame.Size();
+    auto load_saved = [this, &offset] {
+        _listing.Append({ Asm::At(Asm::R13), C("D=M"), Literal(offset), C("A=D-A"), C("D=M") });
+        offset--;
+    };
+
+    load_saved(); // retAddr
+    RamAccessGenerator::Push(_listing);
+    if (_frame.lcl) {
+        load_saved();
+        if (frame.lcl) {
+            RamAccessGenerator::Push(_listing);
+        } else {
+            // the callee leaves LCL alone: our caller's goes back below
+            _listing.Append({ Asm::At(Asm::R15), C("M=D") });
+        }
+    } else if (frame.lcl) {
+        _listing.Append({ Asm::At(Asm::LCL), C("D=M") });
+        RamAccessGenerator::Push(_listing);
+    }
+    load_saved(); // ARG
+    RamAccessGenerator::Push(_listing);
+    if (frame.this_that) {
+        for (const Asm::Symbol seg : { Asm::THIS, Asm::THAT }) {
+            if (_frame.this_that) {
+                load_saved();
+            } else {
+                _listing.Append({ Asm::At(seg), C("D=M") });
+            }
+            RamAccessGenerator::Push(_listing);
+        }
+    }
+
+    // move the arguments and the frame down to ARG, which the callee shares
+    const int words = n_vars + frame.Size();
+    _listing.Append({ Asm::At(Asm::SP), C("D=M"), Literal(words), C("D=D-A"), Asm::At(Asm::R13), C("M=D"),
+                      Asm::At(Asm::ARG), C("D=M"), Asm::At(Asm::R14), C("M=D") });
+    for (int i = 0; i < words; i++) {
+        _listing.Append({ Asm::At(Asm::R13), C("M=M+1"), C("A=M-1"), C("D=M"), Asm::At(Asm::R14), C("M=M+1"),
+                          C("A=M-1"), C("M=D") });
+    }
+
+    // SP = ARG+words
+    _listing.Append({ Asm::At(Asm::R14), C("D=M"), Asm::At(Asm::SP), C("M=D") });
+    if (frame.lcl) {
+        _listing.Append({ Asm::At(Asm::LCL), C("M=D") });
+    } else if (_frame.lcl) {
+        _listing.Append({ Asm::At(Asm::R15), C("D=M"), Asm::At(Asm::LCL), C("M=D") });
+    }
+
+    WriteGoto(function_name);
 }
 
 void
@@ -536,65 +1063,80 @@ CodeWriter::WriteReturn()
     // ★ R13-R15 VM変換器の生成コードに変数が必要な場合、これらのレジスタを使用可能（本書p.175）
 
     // LCL = HEAD = SP
-    // frame: R13 = LCL
-    _out << "@LCL\n"
-            "D=M\n"
-            "@R13\n"
-            "M=D\n";
-
-    // retAddr: R14 = *(frame-5)
-    _out << "@5\n"
-            "A=D-A\n"
-            "D=M\n"
-            "@R14\n"
-            "M=D\n";
+    // frame: R13 = LCL, or ARG+nArgs+size when the callee has no LCL
+    if (_frame.lcl) {
+        _listing.Append({ Asm::At(Asm::LCL), C("D=M"), Asm::At(Asm::R13), C("M=D") });
+    } else {
+        _listing.Append({ Asm::At(Asm::ARG), C("D=M"), Literal(_frame.n_args + _frame.Size()), C("D=D+A"),
+                          Asm::At(Asm::R13), C("M=D") });
+    }
+
+    // retAddr: R14 = *(frame-size)
+    _listing.Append({ Literal(_frame.Size()), C("A=D-A"), C("D=M"), Asm::At(Asm::R14), C("M=D") });
 
     // D=pop()
-    RamAccessGenerator::Pop(_out);
+    RamAccessGenerator::Pop(_listing);
 
     // *ARG=pop() (= *ARG=D)
-    _out << "@ARG\n"
-            "A=M\n"
-            "M=D\n";
+    _listing.Append({ Asm::At(Asm::ARG), C("A=M"), C("M=D") });
 
     // SP = ARG+1
-    _out << "@ARG\n"
-            "D=M+1\n"
-            "@SP\n"
-            "M=D\n";
+    _listing.Append({ Asm::At(Asm::ARG), C("D=M+1"), Asm::At(Asm::SP), C("M=D") });
 
     // THAT=*(frame-1)
     // THIS=*(frame-2)
     // ARG=*(frame-3)
     // LCL=*(frame-4)
-    auto deref = []() {
-        return "@R13\n"
-               "AM=M-1\n" // D=frame-1; @R13=frame-1
-               "D=M";     // D=*(frame-offset)
+    auto deref = [this](const Asm::Symbol seg) {
+        _listing.Append({ Asm::At(Asm::R13),
+                          C("AM=M-1"), // D=frame-1; @R13=frame-1
+                          C("D=M"),    // D=*(frame-offset)
+                          Asm::At(seg), C("M=D") });
     };
 
-    _out << deref() << "\n"
-         << "@THAT\n"
-            "M=D\n"; // THAT=*(frame-1)
-    _out << deref() << "\n"
-         << "@THIS\n"
-            "M=D\n"; // THAT=*(frame-2)
-    _out << deref() << "\n"
-         << "@ARG\n"
-            "M=D\n"; // THAT=*(frame-3)
-    _out << deref() << "\n"
-         << "@LCL\n"
-            "M=D\n"; // THAT=*(frame-4)
+    if (_frame.this_that) {
+        deref(Asm::THAT); // THAT=*(frame-1)
+        deref(Asm::THIS); // THIS=*(frame-2)
+    }
+    deref(Asm::ARG); // ARG=*(frame-3)
+    if (_frame.lcl) {
+        deref(Asm::LCL); // LCL=*(frame-4)
+    }
 
     // goto retAddr
-    _out << "@R14\n"
-            "A=M\n"
-            "0;JMP\n";
+    _listing.Append({ Asm::At(Asm::R14), C("A=M"), C("0;JMP") });
+}
+
+void
+CodeWriter::SetCompact(bool on)
+{
+    _gens->ForEachOp([this, on](auto& gen) { gen.SetOutOfLine(on && _program); });
+}
+
+void
+CodeWriter::Flush()
+{
+    // after the function, which never falls through its end
+    _gens->ForEachOp([this](auto& gen) { gen.WriteRoutine(_listing); });
+    if (_sink) {
+        Asm::AppendAsm(_listing, _asm);
+        _listing.Clear();
+        if (_asm.size() >= ASM_BLOCK) {
+            _sink(_asm);
+            _asm.clear();
+        }
+    }
 }
 
 void
 CodeWriter::Close()
 {
+    Flush();
+    if (_sink && !_asm.empty()) {
+        _sink(_asm);
+        _asm.clear();
+    }
+    _sink = nullptr;
     if (_out.is_open()) {
         _out.close();
     }
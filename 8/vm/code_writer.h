@@ -1,38 +1,100 @@
 #ifndef VM_CODE_WRITER_HH
 
+#include <cstddef>
 #include <fstream>
-#include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 
+#include "../../6/asm/listing.h"
+#include "frame.h"
 #include "parser.h"
 
 namespace Vm {
 
-class RamAccessGenerator;
+struct Generators;
 class CodeWriter
 {
   public:
+    // Instruction selection for push, pop, arithmetic and the pairs of
+    // superopt_table.h: of the sequences that do the same, the one cheapest
+    // in Asm::INSTRUCTION_COST is written
+    struct Selection
+    {
+        bool enabled{ true }; // false: always the first form, as before
+        std::size_t commands{ 0 };
+        std::size_t rewritten{ 0 }; // written in a form other than the first
+        std::size_t saved{ 0 };     // instructions, which are also cycles
+    };
+
+    // Writes Hack assembly text to out_path
     CodeWriter(const std::string& out_path);
+    // Passes Hack assembly text to `sink` in blocks
+    explicit CodeWriter(Asm::Sink sink);
+    // Appends the instructions to `listing`, for the assembler to take as they are.
+    // Without the bootstrap the code is a library to link with a program.
+    explicit CodeWriter(Asm::Listing& listing, bool bootstrap = true);
     ~CodeWriter();
 
     void SetFileName(const std::string& filename);
+    // Calling conventions of the program's functions; full frames without
+    void SetConventions(const Conventions* conventions);
+    void SetSelection(bool on) { _selection.enabled = on; }
+    const Selection& GetSelection() const { return _selection; }
+    // Code size over speed for the commands written from now on: eq, gt
+    // and lt call a routine shared by the whole program, for code that
+    // seldom runs. Only a program with the bootstrap has such routines; a
+    // library would repeat them.
+    void SetCompact(bool on);
 
-    void WriteArithmetic(const std::string& cmd_line);
-    void WritePushPop(Parser::Cmd cmd, const std::string& seg, const size_t idx);
-    void WriteLabel(const std::string& label);
-    void WriteGoto(const std::string& label);
-    void WriteIf(const std::string& label);
-    void WriteFuntion(const std::string& function_name, const int n_vars);
-    void WriteCall(const std::string& label, const int n_vars);
+    // By name, as in the VM code; an unknown name is reported and skipped
+    void WriteArithmetic(std::string_view cmd_line);
+    void WritePushPop(Parser::Cmd cmd, std::string_view seg, const size_t idx);
+    // push seg idx, then cmd; one sequence when superopt found one for the pair
+    void WritePushArithmetic(std::string_view seg, const size_t idx, std::string_view cmd);
+    // pop seg idx, then push seg idx; likewise
+    void WritePopPush(std::string_view seg, const size_t idx);
+    // The same by the enums of the parser, without looking names up
+    void WriteArithmetic(Parser::Op op);
+    void WritePushPop(Parser::Cmd cmd, Parser::Segment seg, const size_t idx);
+    void WritePushArithmetic(Parser::Segment seg, const size_t idx, Parser::Op op);
+    void WritePopPush(Parser::Segment seg, const size_t idx);
+    void WriteLabel(std::string_view label);
+    void WriteGoto(std::string_view label);
+    void WriteIf(std::string_view label);
+    void WriteIfNot(std::string_view label);
+    void WriteFuntion(std::string_view function_name, const int n_vars);
+    void WriteCall(std::string_view label, const int n_vars);
     void WriteReturn();
+    // `call f n` right before `return`: f takes over the current frame and
+    // returns straight to our caller; a self call becomes a jump
+    void WriteTailCall(std::string_view function_name, const int n_vars);
 
+    // Ends a function: writes the routines of SetCompact it called for the
+    // first time, then writes out the instructions so far when writing text
+    void Flush();
     void Close();
 
   private:
+    static constexpr std::size_t ASM_BLOCK = 64 * 1024;
+
+    void Init(bool bootstrap);
+    Frame Callee(std::string_view function_name) const;
+
     std::ofstream _out;
+    Asm::Sink _sink;
+    Asm::Listing _text; // instructions not passed to _sink yet
+    std::string _asm;   // their text, passed on in blocks of ASM_BLOCK
+    Asm::Listing& _listing;
     std::string _filename;
-    std::map<std::string, std::shared_ptr<RamAccessGenerator>> _stack_gens;
+    std::unique_ptr<Generators> _gens;
+    int _calls{ 0 }; // call count in runtime
+    std::string _symbol; // return address being named, kept for its capacity
+    bool _program{ true }; // written with the bootstrap
+    const Conventions* _conventions{ nullptr };
+    Selection _selection;
+    std::string _function; // being written
+    Frame _frame;          // of the function being written
 };
 
 } // namespace Vm
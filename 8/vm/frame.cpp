@@ -0,0 +1,102 @@
+#include "frame.h"
+
+#include "parser.h"
+
+namespace Vm {
+
+void
+Conventions::Scan(const std::string& path)
+{
+    Parser p{ path };
+    Scan(p);
+}
+
+void
+Conventions::Scan(std::span<const char> source)
+{
+    Parser p{ source };
+    Scan(p);
+}
+
+void
+Conventions::Scan(Parser& p)
+{
+    // code before the first function belongs to no function
+    Summary* current = nullptr;
+    while (p.HasMoreLines()) {
+        p.Advance();
+
+        const auto type = p.CommandType();
+        switch (type) {
+            case Parser::Cmd::Function: {
+                const std::string_view name = p.Arg1();
+                const int n_vars            = p.Arg2();
+                current                     = nullptr;
+                if (!name.empty() && n_vars >= 0) {
+                    current = &At(name);
+                    current->definitions++;
+                    current->n_vars = n_vars;
+                }
+            } break;
+
+            case Parser::Cmd::Call: {
+                const std::string_view name = p.Arg1();
+                const int n_args            = p.Arg2();
+                if (!name.empty() && n_args >= 0) {
+                    Summary& s = At(name);
+                    s.n_args   = s.n_args == -1 || s.n_args == n_args ? n_args : -2;
+                }
+            } break;
+
+            case Parser::Cmd::Push:
+            case Parser::Cmd::Pop: {
+                if (current != nullptr) {
+                    const Parser::Segment seg = p.SegmentType();
+                    current->uses_local |= seg == Parser::Segment::Local;
+                    current->pops_pointer |= type == Parser::Cmd::Pop && seg == Parser::Segment::Pointer;
+                }
+            } break;
+
+            case Parser::Cmd::Arithmetic:
+            case Parser::Cmd::Label:
+            case Parser::Cmd::Goto:
+            case Parser::Cmd::If:
+            case Parser::Cmd::IfNot:
+            case Parser::Cmd::Return:
+            case Parser::Cmd::Invalid:
+                break;
+        }
+    }
+}
+
+Conventions::Summary&
+Conventions::At(std::string_view function)
+{
+    const auto it = _functions.find(function);
+    if (it != _functions.end()) {
+        return it->second;
+    }
+    return _functions.emplace(function, Summary{}).first->second;
+}
+
+Frame
+Conventions::Of(std::string_view function) const
+{
+    const auto it = _functions.find(function);
+    if (it == _functions.end() || function == "Sys.init") {
+        return {};
+    }
+
+    const Summary& s = it->second;
+    if (s.definitions != 1 || s.n_args < 0) {
+        return {};
+    }
+
+    Frame f;
+    f.lcl       = s.n_vars > 0 || s.uses_local;
+    f.this_that = s.pops_pointer;
+    f.n_args    = s.n_args;
+    return f;
+}
+
+} // namespace Vm
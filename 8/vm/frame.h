@@ -0,0 +1,62 @@
+#ifndef VM_FRAME_HH
+#define VM_FRAME_HH
+
+#include <functional>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace Vm {
+
+class Parser;
+
+// What a call saves below the callee's stack: always the return address
+// and ARG, LCL only when the callee has a local segment, THIS and THAT only
+// when the callee may change them (`pop pointer`).
+//
+//   full:        retAddr LCL ARG THIS THAT
+//   reduced:     retAddr [LCL] ARG [THIS THAT]
+//
+// Without LCL the callee finds its frame from ARG and its argument count.
+struct Frame
+{
+    bool lcl{ true };
+    bool this_that{ true };
+    int n_args{ -1 }; // -1: unknown, for full frames
+
+    int Size() const { return 2 + lcl + 2 * this_that; }
+};
+
+// Whole-program analysis for reduced calling conventions. Every .vm file
+// of the program is scanned before any is translated; a function keeps the
+// full frame when it is not defined in the program, is defined twice, is
+// called with different argument counts or is Sys.init, so that code from
+// elsewhere (a linked object, the bootstrap) may still call it.
+class Conventions
+{
+  public:
+    void Scan(const std::string& path);
+    void Scan(std::span<const char> source);
+
+    Frame Of(std::string_view function) const;
+
+  private:
+    struct Summary
+    {
+        int definitions{ 0 };
+        int n_vars{ 0 };
+        bool uses_local{ false };
+        bool pops_pointer{ false };
+        int n_args{ -1 }; // from the calls; -2 when they disagree
+    };
+
+    void Scan(Parser& p);
+    Summary& At(std::string_view function);
+
+    std::map<std::string, Summary, std::less<>> _functions;
+};
+
+} // namespace Vm
+
+#endif
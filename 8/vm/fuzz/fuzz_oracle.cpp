@@ -0,0 +1,242 @@
+// The optimising translator against the original one on generated programs.
+// The input bytes choose the commands of Sys.init and of one function it
+// calls, which in turn calls a leaf (a tail call when it ends the body), and
+// the arguments of a self-recursive function. Branches come as the Jack
+// compiler writes them: if/else, counted while loops and dead code after
+// return. The stack never underflows, segment indices stay inside the
+// frames, this/that are only used once pointer has been set to the heap and
+// every loop is bounded, so each program ends in Sys.init's halt loop.
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../cfg.h"
+#include "../oracle.h"
+#include "../profile.h"
+
+// The passes under test; new optimisations are added here
+static std::vector<Vm::Pipeline::Pass>
+Passes()
+{
+    return { Vm::OptimiseControlFlow };
+}
+
+// A made-up profile of `src`: any count for each label, which only moves
+// blocks around, and the functions of the bits of `cold` without cycles,
+// which writes them for size
+static Vm::Profile
+MakeProfile(const std::string& src, int cold)
+{
+    std::string text = "hackprof 1\ncycles 1000\n";
+    static constexpr const char* FUNCTIONS[]{ "Sys.init", "Main.f", "Main.g", "Main.h" };
+    for (int i = 0; i < 4; i++) {
+        text += std::string{ "function " } + FUNCTIONS[i] + (cold >> i & 1 ? " 1 0\n" : " 1 400\n");
+    }
+    std::istringstream lines{ src };
+    for (std::string line; std::getline(lines, line);) {
+        if (line.starts_with("label ")) {
+            const std::string label = line.substr(6);
+            text += "label " + label + " " + std::to_string(std::hash<std::string>{}(label + src) % 100) + "\n";
+        }
+    }
+    Vm::Profile profile;
+    std::istringstream in{ text };
+    profile.Parse(in);
+    return profile;
+}
+
+class Generator
+{
+  public:
+    Generator(const std::uint8_t* data, std::size_t size)
+      : _data(data)
+      , _size(size)
+    {
+    }
+
+    std::string Program()
+    {
+        std::string src = "function Sys.init 2\n";
+        Body(src, true);
+        src += "label HALT\ngoto HALT\n";
+        // with or without locals, the two frames of Conventions
+        _locals = Next() & 1;
+        src += _locals ? "function Main.f 2\n" : "function Main.f 0\n";
+        Body(src, false);
+        const int tail = Next();
+        if (tail & 1 && _depth > 1) {
+            src += "call Main.g 2\n";
+        }
+        src += _depth > 0 ? "return\n" : "push constant 0\nreturn\n";
+        src += "label DEAD\npush constant 5\npop static 6\ngoto DEAD\n";
+        // the leaf in each of the frames of Conventions
+        src += tail & 2 ? "function Main.g 1\npush argument 0\npop local 0\npush local 0\n"
+                        : "function Main.g 0\npush argument 0\n";
+        if (tail & 4) {
+            src += "push constant 4000\npop pointer 1\npush argument 1\npop that 0\n";
+        }
+        src += "push argument 1\nsub\nreturn\n";
+        // h(n, acc) = n ? h(n-1, acc+n) : acc, its local zeroed on every round
+        src += "function Main.h 1\npush argument 0\nif-goto H_STEP\npush argument 1\nreturn\n"
+               "label H_STEP\npush argument 0\npush constant 1\nsub\n"
+               "push argument 1\npush local 0\nadd\npush argument 0\nadd\npop local 0\npush local 0\n"
+               "call Main.h 2\nreturn\n";
+        return src;
+    }
+
+  private:
+    int Next() { return _pos < _size ? _data[_pos++] : -1; }
+
+    // Main.f without locals has no local segment to use
+    bool Segment(int arg, bool caller) const { return caller || _locals || (arg & 3) != 0; }
+
+    // commands up to the next 0xFF byte or the end of the input
+    void Body(std::string& src, bool caller)
+    {
+        static constexpr const char* BINARY[]{ "add", "sub", "eq", "gt", "lt", "and", "or" };
+        static constexpr const char* SEGMENTS[]{ "local", "argument", "static", "temp" };
+
+        _depth    = 0;
+        _pointers = 0;
+        for (int b = Next(); b >= 0 && b != 0xFF; b = Next()) {
+            const int arg = b >> 4;
+            switch (b & 0xF) {
+                case 0:
+                case 1:
+                    src += "push constant " + std::to_string(arg * 997 % 32768) + "\n";
+                    _depth++;
+                    break;
+                case 2:
+                case 3:
+                    if (Segment(arg, caller)) {
+                        src += std::string{ "push " } + SEGMENTS[arg & 3] + " " + std::to_string(arg >> 2 & 1) + "\n";
+                        _depth++;
+                    }
+                    break;
+                case 4:
+                    if (_depth > 0 && Segment(arg, caller)) {
+                        src += std::string{ "pop " } + SEGMENTS[arg & 3] + " " + std::to_string(arg >> 2 & 1) + "\n";
+                        _depth--;
+                    }
+                    break;
+                case 5:
+                case 6:
+                    if (_depth > 1) {
+                        src += std::string{ BINARY[arg % 7] } + "\n";
+                        _depth--;
+                    }
+                    break;
+                case 7:
+                    if (_depth > 0) {
+                        src += arg & 1 ? "neg\n" : "not\n";
+                    }
+                    break;
+                case 8:
+                    // skip a balanced pair of commands
+                    if (_depth > 0) {
+                        // labels are not scoped by function in this translator
+                        const std::string l = "L" + std::to_string(_label++);
+                        src += "if-goto " + l + "\npush constant " + std::to_string(arg) + "\npop static " +
+                               std::to_string(arg & 7) + "\nlabel " + l + "\n";
+                        _depth--;
+                    }
+                    break;
+                case 9:
+                    if (_depth > 1) {
+                        src += caller ? "call Main.f 2\n" : "call Main.g 2\n";
+                        _depth--;
+                    }
+                    break;
+                case 10:
+                    src += "push constant " + std::to_string(3000 + arg * 16) + "\npop pointer " +
+                           std::to_string(arg & 1) + "\n";
+                    _pointers |= 1 << (arg & 1);
+                    break;
+                case 11:
+                    if (_pointers >> (arg & 1) & 1) {
+                        // indices far enough apart to need each form of pop
+                        const std::string seg = arg & 1 ? "that " : "this ";
+                        const std::string idx = std::to_string((arg >> 2) * 5);
+                        if (arg & 2 && _depth > 0) {
+                            src += "pop " + seg + idx + "\n";
+                            _depth--;
+                        } else {
+                            src += "push " + seg + idx + "\n";
+                            _depth++;
+                        }
+                    }
+                    break;
+                case 12:
+                    if (caller) {
+                        src += "push constant " + std::to_string(arg) + "\npush constant " + std::to_string(arg * 31) +
+                               "\ncall Main.h 2\n";
+                        _depth++;
+                    }
+                    break;
+                case 13: {
+                    // while (temp 1 != 0) { static += 3; temp 1-- }
+                    const std::string n = std::to_string(_label++);
+                    src += "push constant " + std::to_string(arg & 7) + "\npop temp 1\n";
+                    src += "label W" + n + "\npush temp 1\npush constant 0\neq\nif-goto E" + n + "\n";
+                    src += "push static " + std::to_string(arg >> 3) + "\npush constant 3\nadd\npop static " +
+                           std::to_string(arg >> 3) + "\n";
+                    src += "push temp 1\npush constant 1\nsub\npop temp 1\ngoto W" + n + "\nlabel E" + n + "\n";
+                } break;
+                case 14:
+                    // if (x) { static a = .. } else { static b = .. }
+                    if (_depth > 0) {
+                        const std::string n = std::to_string(_label++);
+                        src += "if-goto T" + n + "\ngoto F" + n + "\nlabel T" + n + "\npush constant " +
+                               std::to_string(arg) + "\npop static " + std::to_string(arg & 7) + "\ngoto X" + n +
+                               "\nlabel F" + n + "\npush constant " + std::to_string(arg + 100) + "\npop static " +
+                               std::to_string(arg >> 1) + "\nlabel X" + n + "\n";
+                        _depth--;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    const std::uint8_t* _data;
+    std::size_t _size;
+    std::size_t _pos{ 0 };
+    int _depth{ 0 };
+    int _label{ 0 };
+    int _locals{ 1 };
+    int _pointers{ 0 }; // bit 0: THIS set by this body, bit 1: THAT
+};
+
+extern "C" int
+LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)
+{
+    static const Vm::Oracle oracle{ 1'000'000 };
+    static const Vm::Oracle::Translator candidate = Vm::Oracle::WithPasses(Passes());
+
+    const std::string src = Generator{ data, size }.Program();
+    std::optional<Vm::Oracle::Divergence> d;
+    if (size % 2) {
+        // every other input through a profile
+        const Vm::Profile profile = MakeProfile(src, data[0]);
+        d = oracle.Compare(src, Vm::Oracle::WithPasses({ Vm::ProfiledControlFlow(profile) }, &profile));
+    } else {
+        d = oracle.Compare(src, candidate);
+    }
+    if (d) {
+        std::cerr << src << "\n";
+        if (d->halted) {
+            std::cerr << "RAM[" << d->address << "] = " << d->actual << ", expected " << d->expected << "\n";
+        } else {
+            std::cerr << "did not halt\n";
+        }
+        std::abort();
+    }
+    return 0;
+}
@@ -0,0 +1,20 @@
+// Any text parses without crashing or throwing
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "../parser.h"
+
+extern "C" int
+LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)
+{
+    Vm::Parser p{ std::span<const char>{ reinterpret_cast<const char*>(data), size } };
+    while (p.HasMoreLines()) {
+        p.Advance();
+        if (p.CommandType() != Vm::Parser::Cmd::Return) {
+            (void)p.Arg1();
+        }
+        (void)p.Arg2();
+    }
+    return 0;
+}
@@ -0,0 +1,43 @@
+// vm -> hackasm: any text translates without crashing, and the machine code
+// is the same whether the assembly goes through .asm text or stays in memory
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "../../../6/asm/assembler.h"
+#include "../code_writer.h"
+#include "../pipeline.h"
+
+extern "C" int
+LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)
+{
+    const std::span<const char> source{ reinterpret_cast<const char*>(data), size };
+
+    std::string text;
+    {
+        Vm::CodeWriter writer{ [&text](std::string_view s) { text += s; } };
+        Vm::Pipeline pipeline{ writer };
+        pipeline.Translate(source, "Main");
+    }
+    Asm::Listing parsed;
+    Asm::ParseAsm(text, parsed);
+    Asm::Program from_text;
+    Asm::Assemble(parsed, from_text);
+
+    Asm::Listing listing;
+    {
+        Vm::CodeWriter writer{ listing };
+        Vm::Pipeline pipeline{ writer };
+        pipeline.Translate(source, "Main");
+    }
+    Asm::Program in_memory;
+    Asm::Assemble(listing, in_memory);
+
+    if (in_memory.words != from_text.words || in_memory.labels != from_text.labels) {
+        std::abort();
+    }
+    return 0;
+}
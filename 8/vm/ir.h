@@ -0,0 +1,38 @@
+#ifndef VM_IR_HH
+#define VM_IR_HH
+
+#include <string_view>
+
+#include "../../6/asm/arena.h"
+#include "parser.h"
+
+namespace Vm {
+
+using Asm::Arena;
+using Asm::ArenaVector;
+
+// One VM command; the strings live in the Arena of the unit holding it
+struct Command
+{
+    Parser::Cmd type{ Parser::Cmd::Invalid };
+    std::string_view arg1; // add/sub/..., segment, label or function name
+    int arg2{ -1 };        // index, nVars or nArgs
+};
+
+// The commands of one function, from its `function` command up to the
+// next one. Code before the first function of a file is a unit with an
+// empty name.
+struct Function
+{
+    explicit Function(Arena& arena)
+      : body(arena)
+    {
+    }
+
+    std::string_view name;
+    ArenaVector<Command> body;
+};
+
+} // namespace Vm
+
+#endif
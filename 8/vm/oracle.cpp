@@ -0,0 +1,143 @@
+#include "oracle.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "../../5/emu/computer.h"
+#include "../../6/asm/assembler.h"
+#include "code_writer.h"
+
+namespace Vm {
+
+// RAM ranges a VM program can see besides its static variables, [begin, end)
+static constexpr std::pair<std::uint16_t, std::uint16_t> OBSERVABLE[]{
+    {    3,     5 }, // THIS, THAT
+    { 2048, 24576 }, // heap, SCREEN
+};
+
+struct Run
+{
+    bool halted;
+    std::unique_ptr<Emu::Computer> computer;
+    std::map<std::string, std::uint16_t> variables; // static variables and their addresses
+};
+
+// The addresses Assemble gives the symbols that are not labels: from 16 on,
+// in order of first use
+static std::map<std::string, std::uint16_t>
+Variables(const Asm::Listing& listing, const Asm::Program& program)
+{
+    std::map<std::string, std::uint16_t> variables;
+    for (const Asm::Instruction& i : listing.Code()) {
+        if (i.kind != Asm::Instruction::Kind::At || i.symbol < Asm::PREDEFINED_COUNT) {
+            continue;
+        }
+        std::string name{ listing.Name(i.symbol) };
+        if (!program.labels.contains(name) && !variables.contains(name)) {
+            const auto address = static_cast<std::uint16_t>(16 + variables.size());
+            variables.emplace(std::move(name), address);
+        }
+    }
+    return variables;
+}
+
+static Run
+Execute(std::span<const char> source, const Oracle::Translator& translate, std::uint64_t cycles)
+{
+    Asm::Listing listing;
+    translate(source, listing);
+    Asm::Program program;
+    Asm::Assemble(listing, program);
+
+    // the computer holds 128 KiB of memory
+    auto computer = std::make_unique<Emu::Computer>();
+    if (program.words.size() > Emu::Computer::ROM_SIZE) {
+        return { false, std::move(computer), {} };
+    }
+    computer->LoadRom(program.words);
+    computer->Run(cycles);
+    return { computer->Halted(), std::move(computer), Variables(listing, program) };
+}
+
+Oracle::Oracle(std::uint64_t cycles, Translator reference)
+  : _cycles(cycles)
+  , _reference(std::move(reference))
+{
+}
+
+void
+Oracle::Reference(std::span<const char> source, Asm::Listing& out)
+{
+    // through the .asm text, as vm and hackasm do
+    std::string text;
+    {
+        CodeWriter writer{ [&text](std::string_view s) { text += s; } };
+        writer.SetSelection(false);
+        Pipeline pipeline{ writer };
+        pipeline.Translate(source, "Main");
+    }
+    Asm::ParseAsm(text, out);
+}
+
+Oracle::Translator
+Oracle::WithPasses(std::vector<Pipeline::Pass> passes, const Profile* profile)
+{
+    return [passes = std::move(passes), profile](std::span<const char> source, Asm::Listing& out) {
+        CodeWriter writer{ out };
+        Pipeline pipeline{ writer };
+        for (auto&& pass : passes) {
+            pipeline.AddPass(pass);
+        }
+        pipeline.SetTailCalls(true);
+        pipeline.SetProfile(profile);
+        pipeline.Analyze(source);
+        pipeline.Translate(source, "Main");
+    };
+}
+
+Oracle::Translator
+Oracle::Pinned(std::string text)
+{
+    return [text = std::move(text)](std::span<const char>, Asm::Listing& out) { Asm::ParseAsm(text, out); };
+}
+
+std::optional<Oracle::Divergence>
+Oracle::Compare(std::span<const char> source, const Translator& candidate) const
+{
+    const Run expected = Execute(source, _reference, _cycles);
+    if (!expected.halted) {
+        return std::nullopt;
+    }
+
+    const Run actual = Execute(source, candidate, 2 * _cycles);
+    if (!actual.halted) {
+        return Divergence{ false, 0, 0, 0 };
+    }
+
+    // a variable the candidate no longer uses was only used by dead code
+    for (const auto& [name, address] : expected.variables) {
+        const auto it = actual.variables.find(name);
+        if (it == actual.variables.end()) {
+            continue;
+        }
+        const std::uint16_t e = expected.computer->Read(address);
+        const std::uint16_t a = actual.computer->Read(it->second);
+        if (e != a) {
+            return Divergence{ true, address, e, a };
+        }
+    }
+    for (const auto& [begin, end] : OBSERVABLE) {
+        for (std::uint32_t addr = begin; addr < end; addr++) {
+            const auto a = static_cast<std::uint16_t>(addr);
+            if (expected.computer->Read(a) != actual.computer->Read(a)) {
+                return Divergence{ true, a, expected.computer->Read(a), actual.computer->Read(a) };
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace Vm
@@ -0,0 +1,66 @@
+#ifndef VM_ORACLE_HH
+#define VM_ORACLE_HH
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "../../6/asm/listing.h"
+#include "pipeline.h"
+
+namespace Vm {
+
+// Differential check of a translator against the original one: the plain
+// pipeline writing .asm text that the assembler parses again.
+// That reference shares the command templates with every candidate, so it
+// only checks what passes and instruction selection change; the templates
+// themselves are held to the original translator's output, checked in
+// under test/oracle, by constructing the oracle with a Pinned reference.
+// Both translations are assembled and run on the Hack computer from a
+// cleared RAM until they halt; the runs must leave the same values in the
+// memory a VM program can observe: THIS/THAT, the static variables and
+// everything from the heap up to KBD. Static variables are matched by name,
+// as a pass that removes code may change the order the assembler gives
+// them addresses in. The stack, temp and R13-R15 are the translator's own
+// and may differ.
+class Oracle
+{
+  public:
+    // Translates VM source into Hack instructions
+    using Translator = std::function<void(std::span<const char> source, Asm::Listing& out)>;
+
+    struct Divergence
+    {
+        bool halted{ true };        // false: the candidate ran past its cycle budget
+        std::uint16_t address{ 0 }; // the first observable RAM word that differs, in the reference
+        std::uint16_t expected{ 0 };
+        std::uint16_t actual{ 0 };
+    };
+
+    // The reference runs at most `cycles`; the candidate is allowed twice as many
+    explicit Oracle(std::uint64_t cycles, Translator reference = Reference);
+
+    // The translator the candidates are compared to by default: no passes
+    // and no instruction selection, through text
+    static void Reference(std::span<const char> source, Asm::Listing& out);
+    // Pipeline with whole-program analysis, tail calls and `passes`, straight
+    // into the listing; with `profile`, which must outlive the translator,
+    // as Pipeline::SetProfile
+    static Translator WithPasses(std::vector<Pipeline::Pass> passes, const Profile* profile = nullptr);
+    // Hack assembly translated earlier, whatever the source
+    static Translator Pinned(std::string text);
+
+    // nullopt when the runs agree, or when the reference does not halt in time
+    std::optional<Divergence> Compare(std::span<const char> source, const Translator& candidate) const;
+
+  private:
+    std::uint64_t _cycles;
+    Translator _reference;
+};
+
+} // namespace Vm
+
+#endif
@@ -1,114 +1,96 @@
 #include "parser.h"
 
 #include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <ranges>
 #include <string>
-#include <vector>
+#include <system_error>
 
 namespace Vm {
 
-static std::string_view ARITHMETICS[]{ "add", "sub", "neg", "eq", "gt", "lt", "and", "or", "not" };
-static std::string_view PUSH{ "push" };
-static std::string_view POP{ "pop" };
-static std::string_view FUNCTION{ "function" };
-static std::string_view IF{ "if-goto" };
-static std::string_view CALL{ "call" };
-static std::string_view RETURN{ "return" };
-static std::string_view LABEL{ "label" };
-static std::string_view GOTO{ "goto" };
+static constexpr std::string_view PUSH{ "push" };
+static constexpr std::string_view POP{ "pop" };
+static constexpr std::string_view FUNCTION{ "function" };
+static constexpr std::string_view IF{ "if-goto" };
+static constexpr std::string_view CALL{ "call" };
+static constexpr std::string_view RETURN{ "return" };
+static constexpr std::string_view LABEL{ "label" };
+static constexpr std::string_view GOTO{ "goto" };
 
 static constexpr std::string_view DELIMS{ "\n\r" };
 static constexpr std::string_view SPACES{ " \t" };
 
-struct CmdTokens
+// label, function and call names: letters, digits, _ . : $, not starting with a digit
+static bool
+IsSymbol(std::string_view s)
 {
-    std::string cmd;
-    std::vector<std::string> args;
-};
-
-static CmdTokens
-SplitCmd(const std::string& cmd)
-{
-    CmdTokens t{};
-    for (const auto token : cmd | std::views::split(' ')) {
-        if (t.cmd.empty()) {
-            t.cmd = std::string{ token.begin(), token.end() };
-            continue;
-        }
-
-        t.args.push_back(std::string{ token.begin(), token.end() });
-    }
-    return t;
+    const auto valid = [](unsigned char c) { return std::isalnum(c) || c == '_' || c == '.' || c == ':' || c == '$'; };
+    return !s.empty() && !std::isdigit(static_cast<unsigned char>(s.front())) && std::ranges::all_of(s, valid);
 }
 
 static void
-RemoveComments(std::string& s)
+RemoveComments(std::string_view& s)
 {
-    const auto comment_beg = s.find_first_of("//");
-    if (comment_beg != std::string::npos)
-        s.erase(comment_beg);
+    const auto comment_beg = s.find("//");
+    if (comment_beg != std::string_view::npos)
+        s.remove_suffix(s.size() - comment_beg);
 }
 
 static void
-Trim(std::string& s)
+Trim(std::string_view& s)
 {
     // trim left side
     if (!s.empty()) {
         const auto t_space_end = s.find_first_not_of(SPACES);
-        s.erase(0, t_space_end);
+        s.remove_prefix(std::min(t_space_end, s.size()));
     }
 
     if (!s.empty()) {
         // trim right side
         const auto b_space_start = s.find_last_not_of(SPACES);
-        s.erase(b_space_start + 1);
+        s.remove_suffix(s.size() - b_space_start - 1);
     }
 }
 
 Parser::Parser(const std::string& file)
 {
-    try {
-        _in.open(file);
-    } catch (const std::exception& e) {
-        std::cerr << "[Error] Failed to open the file: ";
-        std::cerr << e.what() << '\n';
+    std::ifstream in{ file, std::ios::binary };
+    if (!in) {
+        std::cerr << "[Error] Failed to open the file: " << file << '\n';
+        return;
     }
+    _file.assign(std::istreambuf_iterator<char>{ in }, std::istreambuf_iterator<char>{});
+    _src = _file;
 }
 
-Parser::~Parser()
+Parser::Parser(std::span<const char> source)
+  : _src(source.data(), source.size())
 {
-    if (_in) {
-        _in.close();
-    }
 }
 
 bool
 Parser::HasMoreLines()
 {
-    return _in.peek() != std::char_traits<char>::eof();
+    return _pos < _src.size();
 }
 
 void
 Parser::Advance()
 {
-
-    char c;
-    std::string line;
     while (HasMoreLines()) {
-        line.clear();
-
-        // 改行文字判定（\n と \r の両方に対応）
-        while ((c = _in.get()) != std::char_traits<char>::eof()) {
-            if (c == '\r' && _in.peek() == '\n') {
-                _in.get();
-            }
-
-            if (DELIMS.contains(c)) {
-                break;
-            }
-
-            line += c;
+        // 改行文字判定（\n, \r\n と \r に対応）
+        const std::size_t end = std::min(_src.find_first_of(DELIMS, _pos), _src.size());
+        std::string_view line = _src.substr(_pos, end - _pos);
+        _pos = end;
+        if (_pos < _src.size() && _src[_pos] == '\r' && _pos + 1 < _src.size() && _src[_pos + 1] == '\n') {
+            _pos++;
+        }
+        if (_pos < _src.size()) {
+            _pos++;
         }
 
         // インラインコメントを削除
@@ -120,65 +102,65 @@ Parser::Advance()
         // 有効な行が見つかったら格納して終了
         if (!line.empty()) {
             _cur = line;
+            Split();
             return;
         }
     }
 }
 
-Parser::Cmd
-Parser::CommandType() const
+void
+Parser::Split()
 {
-    auto tokens = SplitCmd(_cur);
-
-    if (std::ranges::contains(ARITHMETICS, tokens.cmd)) {
-        return Cmd::Arithmetic;
-    }
-
-    if (tokens.cmd == PUSH) {
-        return Cmd::Push;
-    }
-
-    if (tokens.cmd == POP) {
-        return Cmd::Pop;
-    }
-
-    if (tokens.cmd == LABEL) {
-        return Cmd::Label;
-    }
-
-    if (tokens.cmd == FUNCTION) {
-        return Cmd::Function;
-    }
-
-    if (tokens.cmd == GOTO) {
-        return Cmd::Goto;
-    }
-
-    if (tokens.cmd == RETURN) {
-        return Cmd::Return;
-    }
-
-    if (tokens.cmd == IF) {
-        return Cmd::If;
-    }
-
-    if (tokens.cmd == CALL) {
-        return Cmd::Call;
+    // tokens are separated by any run of spaces and tabs
+    const std::string_view cur = _cur;
+    _count          = 0;
+    std::size_t pos = cur.find_first_not_of(SPACES);
+    while (pos != std::string_view::npos) {
+        const std::size_t end = std::min(cur.find_first_of(SPACES, pos), cur.size());
+        if (_count < _tokens.size()) {
+            _tokens[_count] = cur.substr(pos, end - pos);
+        }
+        _count++;
+        pos = cur.find_first_not_of(SPACES, end);
+    }
+
+    const std::string_view cmd = _tokens[0];
+    if (ToOp(cmd) != Op::Invalid) {
+        _type = Cmd::Arithmetic;
+    } else if (cmd == PUSH) {
+        _type = Cmd::Push;
+    } else if (cmd == POP) {
+        _type = Cmd::Pop;
+    } else if (cmd == LABEL) {
+        _type = Cmd::Label;
+    } else if (cmd == FUNCTION) {
+        _type = Cmd::Function;
+    } else if (cmd == GOTO) {
+        _type = Cmd::Goto;
+    } else if (cmd == RETURN) {
+        _type = Cmd::Return;
+    } else if (cmd == IF) {
+        _type = Cmd::If;
+    } else if (cmd == CALL) {
+        _type = Cmd::Call;
+    } else {
+        _type = Cmd::Invalid;
     }
+}
 
-    return Cmd::Invalid;
+Parser::Cmd
+Parser::CommandType() const
+{
+    return _type;
 }
 
-std::string
+std::string_view
 Parser::Arg1() const
 {
-    const Cmd cmd = this->CommandType();
-    switch (cmd) {
+    switch (_type) {
         case Cmd::Arithmetic:
-        case Cmd::Return: {
-            const auto tokens = SplitCmd(_cur);
-            return tokens.cmd;
-        }
+        case Cmd::Return:
+            return _tokens[0];
         case Cmd::Push:
         case Cmd::Pop:
         case Cmd::Label:
@@ -186,9 +168,17 @@ Parser::Arg1() const
         case Cmd::If:
         case Cmd::Call:
         case Cmd::Function: {
-            const auto tokens = SplitCmd(_cur);
-            return tokens.args.front();
+            if (_count < 2) {
+                std::cerr << "Missing argument: " << this->_cur << "\n";
+                break;
+            }
+            if (_type != Cmd::Push && _type != Cmd::Pop && !IsSymbol(_tokens[1])) {
+                std::cerr << "Invalid symbol: " << this->_cur << "\n";
+                break;
+            }
+            return _tokens[1];
         } break;
+        case Cmd::IfNot:
         case Cmd::Invalid: {
             std::cerr << "Invalid command: " << this->_cur << "\n";
         } break;
@@ -196,18 +186,39 @@ Parser::Arg1() const
             break;
     }
 
-    return std::string();
+    return {};
 }
 
 int
 Parser::Arg2() const
 {
-    const auto tokens = SplitCmd(_cur);
-    if (tokens.args.size() == 2UL) {
-        return std::stoi(tokens.args.back());
+    if (_count == 3) {
+        // 0以上の10進数のみ
+        const std::string_view arg = _tokens[2];
+        int v{ -1 };
+        const auto r = std::from_chars(arg.data(), arg.data() + arg.size(), v);
+        if (r.ec == std::errc{} && r.ptr == arg.data() + arg.size() && v >= 0) {
+            return v;
+        }
+        std::cerr << "Invalid index: " << this->_cur << "\n";
+    } else if (_type == Cmd::Push || _type == Cmd::Pop || _type == Cmd::Function || _type == Cmd::Call) {
+        std::cerr << "Missing argument: " << this->_cur << "\n";
     }
 
     return -1;
 }
 
+Parser::Segment
+Parser::SegmentType() const
+{
+    const bool push_pop = (_type == Cmd::Push || _type == Cmd::Pop) && _count >= 2;
+    return push_pop ? ToSegment(_tokens[1]) : Segment::Invalid;
+}
+
+Parser::Op
+Parser::OpType() const
+{
+    return _type == Cmd::Arithmetic ? ToOp(_tokens[0]) : Op::Invalid;
+}
+
 } // namespace Vm
@@ -1,8 +1,12 @@
 #ifndef VM_CODE_PARSER_HH
 #define VM_CODE_PARSER_HH
 
-#include <fstream>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <span>
 #include <string>
+#include <string_view>
 
 namespace Vm {
 
@@ -17,14 +21,54 @@ class Parser
         Label,
         Goto,
         If,
+        IfNot, // never parsed: an inverted if-goto of the passes
         Function,
         Return,
         Call,
         Invalid
     };
 
+    // The segment of push and pop, and the command of Arithmetic, for the
+    // code writer to dispatch on without looking names up
+    enum class Segment
+    {
+        Argument,
+        Local,
+        Static,
+        Constant,
+        This,
+        That,
+        Pointer,
+        Temp,
+        Invalid
+    };
+    enum class Op
+    {
+        Add,
+        Sub,
+        Neg,
+        Eq,
+        Gt,
+        Lt,
+        And,
+        Or,
+        Not,
+        Invalid
+    };
+
+    // by Segment and Op
+    static constexpr std::string_view SEGMENT_NAMES[]{ "argument", "local", "static", "constant",
+                                                       "this",     "that",  "pointer", "temp" };
+    static constexpr std::string_view OP_NAMES[]{ "add", "sub", "neg", "eq", "gt", "lt", "and", "or", "not" };
+
+    static constexpr Segment ToSegment(std::string_view name);
+    static constexpr Op ToOp(std::string_view name);
+
     Parser(const std::string& file);
-    ~Parser();
+    // ソースを直接解析する; sourceは Parser より長く生存すること
+    explicit Parser(std::span<const char> source);
+    Parser(const Parser&)            = delete;
+    Parser& operator=(const Parser&) = delete;
 
     // 次の行があるか
     // 開始は1行目の前から
@@ -37,15 +81,48 @@ class Parser
     Cmd CommandType() const;
 
     // コマンドの初めの引数
-    // Arithmeticの場合、add/subなど
-    std::string Arg1() const;
+    // Arithmeticの場合、add/subなど; 次の Advance まで有効
+    std::string_view Arg1() const;
     int Arg2() const;
+    // Arg1 of push/pop and of Arithmetic as enums; Invalid otherwise
+    Segment SegmentType() const;
+    Op OpType() const;
 
   private:
-    std::string _cur;
-    std::ifstream _in;
+    void Split();
+
+    std::string_view _cur; // the line in _src, without comment and spaces
+    // the line split once by Advance: the command and up to two arguments
+    Cmd _type{ Cmd::Invalid };
+    std::array<std::string_view, 3> _tokens;
+    std::size_t _count{ 0 }; // tokens on the line, more than _tokens holds when malformed
+    std::string _file; // file contents when constructed from a path
+    std::string_view _src;
+    std::size_t _pos{ 0 };
 };
 
+constexpr Parser::Segment
+Parser::ToSegment(std::string_view name)
+{
+    for (std::size_t i = 0; i < std::size(SEGMENT_NAMES); i++) {
+        if (name == SEGMENT_NAMES[i]) {
+            return static_cast<Segment>(i);
+        }
+    }
+    return Segment::Invalid;
+}
+
+constexpr Parser::Op
+Parser::ToOp(std::string_view name)
+{
+    for (std::size_t i = 0; i < std::size(OP_NAMES); i++) {
+        if (name == OP_NAMES[i]) {
+            return static_cast<Op>(i);
+        }
+    }
+    return Op::Invalid;
+}
+
 }
 
 #endif
@@ -0,0 +1,220 @@
+#include "pipeline.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <ranges>
+
+#include "parser.h"
+
+namespace Vm {
+
+Pipeline::Pipeline(CodeWriter& writer)
+  : _writer(writer)
+  , _function(_arena)
+{
+    _writer.SetConventions(&_conventions);
+}
+
+void
+Pipeline::Analyze(const std::string& path)
+{
+    _conventions.Scan(path);
+}
+
+void
+Pipeline::Analyze(std::span<const char> source)
+{
+    _conventions.Scan(source);
+}
+
+void
+Pipeline::AddPass(Pass pass)
+{
+    _passes.push_back(std::move(pass));
+}
+
+void
+Pipeline::Translate(const std::string& path)
+{
+    Parser p{ path };
+    // for static variables
+    Translate(p, std::filesystem::path(path).stem());
+}
+
+void
+Pipeline::Translate(std::span<const char> source, const std::string& filename)
+{
+    Parser p{ source };
+    Translate(p, filename);
+}
+
+void
+Pipeline::Translate(Parser& p, const std::string& filename)
+{
+    _writer.SetFileName(filename);
+    _stats.files++;
+
+    while (p.HasMoreLines()) {
+        p.Advance();
+
+        const auto type = p.CommandType();
+        if (type == Parser::Cmd::Invalid) {
+            std::cerr << "Invalid command: " << static_cast<int>(type) << "\n";
+            continue;
+        }
+
+        if (type == Parser::Cmd::Function) {
+            Flush();
+            _function.name = _arena.Copy(p.Arg1());
+        }
+
+        Command c{ type, {}, -1 };
+        if (type != Parser::Cmd::Return) {
+            c.arg1 = _arena.Copy(p.Arg1());
+        }
+        const bool indexed = type == Parser::Cmd::Push || type == Parser::Cmd::Pop ||
+                             type == Parser::Cmd::Function || type == Parser::Cmd::Call;
+        if (indexed) {
+            c.arg2 = p.Arg2();
+        }
+        // the parser has reported a missing or malformed argument
+        if ((type != Parser::Cmd::Return && c.arg1.empty()) || (indexed && c.arg2 < 0)) {
+            continue;
+        }
+        _function.body.push_back(c);
+    }
+
+    // a function never spans two files
+    Flush();
+}
+
+void
+Pipeline::Flush()
+{
+    if (!_function.body.empty()) {
+        for (auto&& pass : _passes) {
+            pass(_function, _arena);
+        }
+        const bool compact = _profile != nullptr && !_function.name.empty() && !_profile->Hot(_function.name);
+        _writer.SetCompact(compact);
+        _stats.compact += compact;
+
+        const auto& body = _function.body;
+        for (std::size_t i = 0; i < body.size(); i++) {
+            const bool tail = _tail_calls && !_function.name.empty() && body[i].type == Parser::Cmd::Call &&
+                              i + 1 < body.size() && body[i + 1].type == Parser::Cmd::Return;
+            if (tail) {
+                _writer.WriteTailCall(body[i].arg1, body[i].arg2);
+                _stats.tail_calls++;
+                i++;
+                continue;
+            }
+            if (i + 1 < body.size() && EmitPair(body[i], body[i + 1])) {
+                i++;
+                continue;
+            }
+            Emit(body[i]);
+        }
+        _writer.Flush();
+
+        _stats.functions += !_function.name.empty();
+        _stats.commands += _function.body.size();
+        _stats.largest     = std::max(_stats.largest, _function.body.size());
+        _stats.arena_bytes = _arena.Capacity();
+    }
+
+    _arena.Reset();
+    _function.body.clear();
+    _function.name = {};
+}
+
+void
+Pipeline::Emit(const Command& c)
+{
+    switch (c.type) {
+        case Parser::Cmd::Pop:
+        case Parser::Cmd::Push: {
+            _writer.WritePushPop(c.type, c.arg1, c.arg2);
+        } break;
+        case Parser::Cmd::Arithmetic: {
+            _writer.WriteArithmetic(c.arg1);
+        } break;
+        case Parser::Cmd::Label: {
+            _writer.WriteLabel(c.arg1);
+        } break;
+        case Parser::Cmd::Goto: {
+            _writer.WriteGoto(c.arg1);
+        } break;
+        case Parser::Cmd::If: {
+            _writer.WriteIf(c.arg1);
+        } break;
+        case Parser::Cmd::IfNot: {
+            _writer.WriteIfNot(c.arg1);
+        } break;
+        case Parser::Cmd::Function: {
+            _writer.WriteFuntion(c.arg1, c.arg2);
+        } break;
+        case Parser::Cmd::Call: {
+            _writer.WriteCall(c.arg1, c.arg2);
+        } break;
+        case Parser::Cmd::Return: {
+            _writer.WriteReturn();
+        } break;
+        case Parser::Cmd::Invalid:
+            break;
+    }
+}
+
+bool
+Pipeline::EmitPair(const Command& first, const Command& second)
+{
+    if (first.type == Parser::Cmd::Push && second.type == Parser::Cmd::Arithmetic) {
+        _writer.WritePushArithmetic(first.arg1, first.arg2, second.arg1);
+        return true;
+    }
+    if (first.type == Parser::Cmd::Pop && second.type == Parser::Cmd::Push && first.arg1 == second.arg1 &&
+        first.arg2 == second.arg2) {
+        _writer.WritePopPush(first.arg1, first.arg2);
+        return true;
+    }
+    return false;
+}
+
+// path/to/file.ext -> path/to/file
+std::string
+PathToFilename(const std::string& path)
+{
+    namespace fs = std::filesystem;
+    fs::path rel = fs::relative(path);
+
+    if (fs::is_directory(rel)) {
+        return rel / *(--rel.end());
+    } else {
+        return rel.parent_path() / rel.stem();
+    }
+}
+
+std::vector<std::string>
+GetVmFiles(const std::string& path)
+{
+    namespace fs = std::filesystem;
+    fs::path rel = fs::relative(path);
+
+    std::vector<std::string> paths{};
+    if (fs::is_directory(rel)) {
+        auto is_vmfile = [](auto&& f) { return f.path().extension() == ".vm"; };
+
+        for (auto vm_file : fs::directory_iterator{ rel } | std::views::filter(is_vmfile)) {
+            paths.push_back(vm_file.path());
+        }
+    } else {
+        if (rel.extension() == ".vm") {
+            paths.push_back(rel);
+        }
+    }
+
+    return paths;
+}
+
+} // namespace Vm
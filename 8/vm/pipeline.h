@@ -0,0 +1,94 @@
+#ifndef VM_PIPELINE_HH
+#define VM_PIPELINE_HH
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "code_writer.h"
+#include "frame.h"
+#include "ir.h"
+#include "profile.h"
+
+namespace Vm {
+
+// Translation in stages: parse -> per-function IR -> optimise -> emit
+// Commands are collected into a Function until the next `function` command
+// or the end of the file; the passes then run over it, it is written out
+// and its arena is reset. Only one function's IR is alive at a time, so
+// memory does not grow with the number or size of the input files.
+class Pipeline
+{
+  public:
+    // Rewrites a function in place; may allocate from the arena
+    using Pass = std::function<void(Function&, Arena&)>;
+
+    struct Stats
+    {
+        std::size_t files{ 0 };
+        std::size_t functions{ 0 };
+        std::size_t commands{ 0 };
+        std::size_t largest{ 0 };       // commands of the largest function
+        std::size_t arena_bytes{ 0 };   // memory held by the IR arena at its peak
+        std::size_t tail_calls{ 0 };
+        std::size_t compact{ 0 };       // functions written for size, see SetProfile
+    };
+
+    explicit Pipeline(CodeWriter& writer);
+
+    void AddPass(Pass pass);
+
+    // `call f n` followed by `return` reuses the caller's frame, see
+    // CodeWriter::WriteTailCall. Off by default, as the stack then no
+    // longer holds a frame for every active call.
+    void SetTailCalls(bool on) { _tail_calls = on; }
+
+    // Functions the profile does not find hot are written for size, see
+    // CodeWriter::SetCompact. The profile must outlive the translation.
+    void SetProfile(const Profile* profile) { _profile = profile; }
+
+    // Whole-program analysis: scan every file of the program before the
+    // first Translate, and calls use the reduced frames of Conventions.
+    // Leave it out for a library whose functions are called from outside.
+    void Analyze(const std::string& path);
+    void Analyze(std::span<const char> source);
+
+    // Translates one .vm file; its static variables are named after its stem
+    void Translate(const std::string& path);
+    // Translates VM code held in memory; `filename` names its static variables
+    void Translate(std::span<const char> source, const std::string& filename);
+
+    const Stats& GetStats() const { return _stats; }
+
+  private:
+    // optimise and emit the current function, then free its IR
+    void Flush();
+    void Translate(Parser& p, const std::string& filename);
+    void Emit(const Command& c);
+    // Two commands the writer takes together, for the pairs of
+    // superopt_table.h; false when they are not such a pair
+    bool EmitPair(const Command& first, const Command& second);
+
+    CodeWriter& _writer;
+    std::vector<Pass> _passes;
+    Conventions _conventions;
+    Arena _arena;
+    Function _function;
+    Stats _stats;
+    bool _tail_calls{ false };
+    const Profile* _profile{ nullptr };
+};
+
+// The .vm files to translate: `path` itself or the .vm files in it
+std::vector<std::string>
+GetVmFiles(const std::string& path);
+
+// Output path without extension: path/to/file.vm -> path/to/file, path/to/dir -> path/to/dir/dir
+std::string
+PathToFilename(const std::string& path);
+
+} // namespace Vm
+
+#endif
@@ -0,0 +1,86 @@
+#include "profile.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace Vm {
+
+bool
+Profile::Load(const std::string& path)
+{
+    std::ifstream in{ path };
+    if (!in) {
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return false;
+    }
+    return Parse(in);
+}
+
+bool
+Profile::Parse(std::istream& in)
+{
+    std::string line;
+    if (!std::getline(in, line) || line != "hackprof 1") {
+        std::cerr << "Not a profile of version 1: " << line << "\n";
+        return false;
+    }
+
+    std::uint64_t total = 0;
+    for (int n = 2; std::getline(in, line); n++) {
+        std::istringstream fields{ line };
+        std::string kind, name;
+        fields >> kind;
+        bool ok = true;
+        if (kind == "cycles") {
+            ok = static_cast<bool>(fields >> total);
+        } else if (kind == "function") {
+            Function f;
+            ok                       = static_cast<bool>(fields >> name >> f.entries >> f.cycles);
+            _functions[std::move(name)] = f;
+        } else if (kind == "label") {
+            std::uint64_t count = 0;
+            ok                  = static_cast<bool>(fields >> name >> count);
+            _labels[std::move(name)] = count;
+        }
+        if (!ok) {
+            std::cerr << "Invalid profile line " << n << ": " << line << "\n";
+            return false;
+        }
+    }
+
+    // the functions with the most cycles first, until they take HOT of them
+    std::vector<std::pair<std::uint64_t, const std::string*>> by_cycles;
+    for (const auto& [name, f] : _functions) {
+        by_cycles.emplace_back(f.cycles, &name);
+    }
+    std::ranges::stable_sort(by_cycles, std::greater<>{}, [](const auto& p) { return p.first; });
+    std::uint64_t covered = 0;
+    for (const auto& [cycles, name] : by_cycles) {
+        if (cycles == 0 || static_cast<double>(covered) >= HOT * static_cast<double>(total)) {
+            break;
+        }
+        _hot.insert(*name);
+        covered += cycles;
+    }
+    return true;
+}
+
+std::uint64_t
+Profile::Count(std::string_view label) const
+{
+    const auto it = _labels.find(label);
+    return it != _labels.end() ? it->second : 0;
+}
+
+std::uint64_t
+Profile::Entries(std::string_view function) const
+{
+    const auto it = _functions.find(function);
+    return it != _functions.end() ? it->second.entries : 0;
+}
+
+} // namespace Vm
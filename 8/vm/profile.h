@@ -0,0 +1,46 @@
+#ifndef VM_PROFILE_HH
+#define VM_PROFILE_HH
+
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+
+namespace Vm {
+
+// Execution counts of a run of the program, as `hackemu --profile` writes
+// them (see 5/emu/profile.h). Labels are those of the VM code, which this
+// translator writes as they are, so a profile taken of one build still
+// names the blocks of the next. A function or label the profile does not
+// name never ran.
+class Profile
+{
+  public:
+    // The hot functions are the fewest that take this share of the cycles
+    static constexpr double HOT = 0.9;
+
+    bool Load(const std::string& path);
+    // false on a line it cannot read; records of other kinds are skipped
+    bool Parse(std::istream& in);
+
+    std::uint64_t Count(std::string_view label) const;
+    std::uint64_t Entries(std::string_view function) const;
+    bool Hot(std::string_view function) const { return _hot.contains(function); }
+
+  private:
+    struct Function
+    {
+        std::uint64_t entries{ 0 };
+        std::uint64_t cycles{ 0 };
+    };
+
+    std::map<std::string, std::uint64_t, std::less<>> _labels;
+    std::map<std::string, Function, std::less<>> _functions;
+    std::set<std::string, std::less<>> _hot;
+};
+
+} // namespace Vm
+
+#endif
@@ -0,0 +1,591 @@
+// superopt: the shortest Hack sequences for the commonest VM commands.
+//
+// Every sequence of up to N instructions over @SP, the command's constant or
+// address and the 196 C-instructions without a jump is tried against the
+// reference semantics of each pattern below, on a few random machine states.
+// A prefix is dropped when it writes where the command does not, when it has
+// more wrong words left than instructions, or when it reaches a state an
+// earlier prefix of no more instructions has reached. The first sequence that
+// survives is verified on 2^20 random states and on every value of each
+// input with the others random, and written to superopt_table.h, which
+// CodeWriter compiles in.
+//
+// eq, gt and lt are not here: every Hack computation is a T-function (bit i
+// of its result depends only on bits 0..i of its operands), so no sequence
+// without a jump can tell whether all 16 bits of x - y are zero.
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "superopt.h"
+
+namespace {
+
+using Vm::Superopt::Step;
+
+constexpr std::size_t MAX_LENGTH = 8;
+constexpr std::size_t TESTS      = 4; // states each prefix runs on
+constexpr std::uint16_t STACK    = 256;
+constexpr std::uint16_t HEAP     = 2048;
+
+struct Cell
+{
+    std::uint16_t address;
+    std::uint16_t value;
+};
+
+// The inputs of a command; every other word of RAM, A and D come from `seed`
+struct Test
+{
+    std::uint16_t sp;
+    std::uint16_t x;     // RAM[SP-2]
+    std::uint16_t y;     // RAM[SP-1]
+    std::uint16_t param; // the constant or address
+    std::uint64_t seed;
+};
+
+enum class Param
+{
+    None,
+    Constant, // push constant c: 0..32767
+    Address,  // pop/push static, pointer or temp: 3..255
+};
+
+// VM commands and what they do: SP goes down by `pops`, and one word
+// changes. Words above the new SP may be clobbered, nothing else.
+struct Pattern
+{
+    std::string_view name; // in superopt_table.h
+    std::string_view vm;
+    Param param;
+    int pops;
+    Cell (*goal)(const Test&);
+};
+
+constexpr std::uint16_t
+Word(int value)
+{
+    return static_cast<std::uint16_t>(value);
+}
+
+constexpr std::uint64_t
+Mix(std::uint64_t z)
+{
+    // splitmix64
+    z += 0x9E3779B97F4A7C15;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    return z ^ (z >> 31);
+}
+
+std::uint16_t
+Initial(const Test& t, std::uint16_t address)
+{
+    if (address == 0) {
+        return t.sp;
+    }
+    if (address == t.sp - 2) {
+        return t.x;
+    }
+    if (address == t.sp - 1) {
+        return t.y;
+    }
+    return static_cast<std::uint16_t>(Mix(t.seed ^ address));
+}
+
+// s i: static, pointer or temp, whose address is known
+const Pattern PATTERNS[] = {
+    { "ADD", "add", Param::None, 1, [](const Test& t) { return Cell{ Word(t.sp - 2), Word(t.x + t.y) }; } },
+    { "SUB", "sub", Param::None, 1, [](const Test& t) { return Cell{ Word(t.sp - 2), Word(t.x - t.y) }; } },
+    { "AND", "and", Param::None, 1, [](const Test& t) { return Cell{ Word(t.sp - 2), Word(t.x & t.y) }; } },
+    { "OR", "or", Param::None, 1, [](const Test& t) { return Cell{ Word(t.sp - 2), Word(t.x | t.y) }; } },
+    { "NEG", "neg", Param::None, 0, [](const Test& t) { return Cell{ Word(t.sp - 1), Word(-t.y) }; } },
+    { "NOT", "not", Param::None, 0, [](const Test& t) { return Cell{ Word(t.sp - 1), Word(~t.y) }; } },
+    { "PUSH_CONSTANT_ADD", "push constant c; add", Param::Constant, 0,
+      [](const Test& t) { return Cell{ Word(t.sp - 1), Word(t.y + t.param) }; } },
+    { "PUSH_CONSTANT_SUB", "push constant c; sub", Param::Constant, 0,
+      [](const Test& t) { return Cell{ Word(t.sp - 1), Word(t.y - t.param) }; } },
+    { "PUSH_CONSTANT_AND", "push constant c; and", Param::Constant, 0,
+      [](const Test& t) { return Cell{ Word(t.sp - 1), Word(t.y & t.param) }; } },
+    { "PUSH_CONSTANT_OR", "push constant c; or", Param::Constant, 0,
+      [](const Test& t) { return Cell{ Word(t.sp - 1), Word(t.y | t.param) }; } },
+    { "PUSH_DIRECT_ADD", "push s i; add", Param::Address, 0,
+      [](const Test& t) { return Cell{ Word(t.sp - 1), Word(t.y + Initial(t, t.param)) }; } },
+    { "PUSH_DIRECT_SUB", "push s i; sub", Param::Address, 0,
+      [](const Test& t) { return Cell{ Word(t.sp - 1), Word(t.y - Initial(t, t.param)) }; } },
+    { "PUSH_DIRECT_AND", "push s i; and", Param::Address, 0,
+      [](const Test& t) { return Cell{ Word(t.sp - 1), Word(t.y & Initial(t, t.param)) }; } },
+    { "PUSH_DIRECT_OR", "push s i; or", Param::Address, 0,
+      [](const Test& t) { return Cell{ Word(t.sp - 1), Word(t.y | Initial(t, t.param)) }; } },
+    { "POP_PUSH", "pop s i; push s i", Param::Address, 0,
+      [](const Test& t) { return Cell{ t.param, t.y }; } },
+};
+
+// The registers, and the words that differ from Initial by address
+struct State
+{
+    std::uint16_t a{ 0 };
+    std::uint16_t d{ 0 };
+    std::uint8_t n{ 0 };
+    std::array<Cell, MAX_LENGTH> writes{};
+};
+
+State
+Start(const Test& t)
+{
+    return { static_cast<std::uint16_t>(Mix(t.seed + 1)), static_cast<std::uint16_t>(Mix(t.seed + 2)), 0, {} };
+}
+
+std::uint16_t
+Read(const Test& t, const State& s, std::uint16_t address)
+{
+    address &= 0x7FFF;
+    for (std::uint8_t i = 0; i < s.n; i++) {
+        if (s.writes[i].address == address) {
+            return s.writes[i].value;
+        }
+    }
+    return Initial(t, address);
+}
+
+void
+Write(const Test& t, State& s, std::uint16_t address, std::uint16_t value)
+{
+    address &= 0x7FFF;
+    auto* const end = s.writes.begin() + s.n;
+    auto* const it  = std::find_if(s.writes.begin(), end, [address](Cell c) { return c.address >= address; });
+    const bool has  = it != end && it->address == address;
+    if (value == Initial(t, address)) {
+        if (has) {
+            std::copy(it + 1, end, it);
+            s.n--;
+        }
+    } else if (has) {
+        it->value = value;
+    } else {
+        std::copy_backward(it, end, end + 1);
+        *it = { address, value };
+        s.n++;
+    }
+}
+
+// The Hack ALU on its six control bits, zx nx zy ny f no
+constexpr std::uint16_t
+Alu(std::uint16_t bits, std::uint16_t x, std::uint16_t y)
+{
+    if (bits & 0b100000) {
+        x = 0;
+    }
+    if (bits & 0b010000) {
+        x = ~x;
+    }
+    if (bits & 0b001000) {
+        y = 0;
+    }
+    if (bits & 0b000100) {
+        y = ~y;
+    }
+    std::uint16_t out = bits & 0b000010 ? x + y : x & y;
+    if (bits & 0b000001) {
+        out = ~out;
+    }
+    return out;
+}
+
+void
+Execute(const Step& step, const Test& t, State& s)
+{
+    const Asm::Instruction& i = step.instruction;
+    if (step.param) {
+        s.a = t.param;
+        return;
+    }
+    switch (i.kind) {
+        case Asm::Instruction::Kind::At:
+            s.a = Asm::PredefinedAddress(i.symbol);
+            return;
+        case Asm::Instruction::Kind::Literal:
+            s.a = i.word;
+            return;
+        case Asm::Instruction::Kind::Label:
+            return;
+        case Asm::Instruction::Kind::C:
+            break;
+    }
+    const std::uint16_t y   = i.word & 0x1000 ? Read(t, s, s.a) : s.a;
+    const std::uint16_t out = Alu(i.word >> 6 & 0b111111, s.d, y);
+    if (i.word & 0b001000) {
+        Write(t, s, s.a, out);
+    }
+    if (i.word & 0b010000) {
+        s.d = out;
+    }
+    if (i.word & 0b100000) {
+        s.a = out;
+    }
+}
+
+// The words the command should have left in a state of `test`
+struct Goal
+{
+    std::uint16_t sp;
+    Cell cell;
+};
+
+Goal
+GoalOf(const Pattern& p, const Test& t)
+{
+    return { Word(t.sp - p.pops), p.goal(t) };
+}
+
+// Words still wrong in `s`; -1 when a word the command leaves alone has
+// changed
+int
+Wrong(const Test& t, const Goal& g, const State& s)
+{
+    for (std::uint8_t i = 0; i < s.n; i++) {
+        const std::uint16_t a = s.writes[i].address;
+        if (a != 0 && a != g.cell.address && (a < g.sp || a >= HEAP)) {
+            return -1;
+        }
+    }
+    return (Read(t, s, 0) != g.sp) + (Read(t, s, g.cell.address) != g.cell.value);
+}
+
+Test
+RandomTest(const Pattern& p, std::mt19937_64& rng)
+{
+    Test t{ static_cast<std::uint16_t>(STACK + 2 + rng() % (HEAP - STACK - 2)), static_cast<std::uint16_t>(rng()),
+            static_cast<std::uint16_t>(rng()), 0, rng() };
+    switch (p.param) {
+        case Param::None:
+            break;
+        case Param::Constant:
+            t.param = static_cast<std::uint16_t>(rng() & 0x7FFF);
+            break;
+        case Param::Address:
+            t.param = static_cast<std::uint16_t>(3 + rng() % 253);
+            break;
+    }
+    return t;
+}
+
+bool
+Passes(const Pattern& p, std::span<const Step> code, const Test& t)
+{
+    State s = Start(t);
+    for (const Step& step : code) {
+        Execute(step, t, s);
+    }
+    return Wrong(t, GoalOf(p, t), s) == 0;
+}
+
+// On 2^20 random states, then on every value of x, y, the parameter and SP
+// in turn with the rest random
+bool
+Verify(const Pattern& p, std::span<const Step> code, std::uint64_t& states)
+{
+    std::mt19937_64 rng{ 0x5EED };
+    auto run = [&](auto&& set, int from, int to) {
+        for (int v = from; v < to; v++) {
+            Test t = RandomTest(p, rng);
+            set(t, static_cast<std::uint16_t>(v));
+            states++;
+            if (!Passes(p, code, t)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    const int params = p.param == Param::Constant ? 0x8000 : p.param == Param::Address ? 256 : 0;
+    const int first  = p.param == Param::Address ? 3 : 0;
+    return run([](Test&, std::uint16_t) {}, 0, 1 << 20) && run([](Test& t, std::uint16_t v) { t.x = v; }, 0, 0x10000) &&
+           run([](Test& t, std::uint16_t v) { t.y = v; }, 0, 0x10000) &&
+           run([](Test& t, std::uint16_t v) { t.param = v; }, first, params) &&
+           run([](Test& t, std::uint16_t v) { t.sp = v; }, STACK + 2, HEAP);
+}
+
+// The instructions tried: @SP, the parameter, then each computation into
+// each destination
+std::vector<Step>
+Alphabet(const Pattern& p)
+{
+    std::vector<Step> steps{ { Asm::At(Asm::SP) } };
+    if (p.param != Param::None) {
+        steps.push_back(Vm::Superopt::PARAM);
+    }
+    // the first 28 computations are the distinct ones; dest 0 does nothing
+    for (std::size_t c = 0; c < 28; c++) {
+        for (std::uint16_t dest = 1; dest < 8; dest++) {
+            const auto word = static_cast<std::uint16_t>(0b111 << 13 | Asm::COMPS[c].bits << 6 | dest << 3);
+            steps.push_back({ { Asm::Instruction::Kind::C, word, 0 } });
+        }
+    }
+    return steps;
+}
+
+bool
+IsC(const Step& s)
+{
+    return !s.param && s.instruction.kind == Asm::Instruction::Kind::C;
+}
+
+// Depth-first search for sequences of one length that start with one step
+class Search
+{
+  public:
+    Search(const Pattern& pattern, std::span<const Step> alphabet, std::span<const Test, TESTS> tests,
+           std::size_t length)
+      : _pattern(pattern)
+      , _alphabet(alphabet)
+      , _tests(tests)
+      , _length(length)
+    {
+        for (std::size_t t = 0; t < TESTS; t++) {
+            _goals[t]     = GoalOf(pattern, tests[t]);
+            _states[0][t] = Start(tests[t]);
+        }
+    }
+
+    std::optional<std::vector<Step>> Run(std::size_t first)
+    {
+        if (Try(0, first) && (_length == 1 ? Found() : Dfs(1))) {
+            return std::vector<Step>(_code.begin(), _code.begin() + static_cast<std::ptrdiff_t>(_length));
+        }
+        return std::nullopt;
+    }
+
+    std::uint64_t Nodes() const { return _nodes; }
+    std::uint64_t Verified() const { return _verified; }
+
+  private:
+    // Runs step `i` after the first `depth` steps; false if the prefix is dropped
+    bool Try(std::size_t depth, std::size_t i)
+    {
+        const Step& step     = _alphabet[i];
+        const bool last      = depth + 1 == _length;
+        const bool writes_m  = IsC(step) && (step.instruction.word & 0b001000);
+        const bool follows_a = depth > 0 && !IsC(_code[depth - 1]);
+        // A loaded twice, or a last step that leaves RAM as it is
+        if ((!IsC(step) && follows_a) || (last && !writes_m)) {
+            return false;
+        }
+        _nodes++;
+        const int left = static_cast<int>(_length - depth - 1);
+        auto& next     = _states[depth + 1];
+        for (std::size_t t = 0; t < TESTS; t++) {
+            next[t] = _states[depth][t];
+            Execute(step, _tests[t], next[t]);
+            const int wrong = Wrong(_tests[t], _goals[t], next[t]);
+            if (wrong < 0 || wrong > left) {
+                return false;
+            }
+        }
+        _code[depth] = step;
+        if (last) {
+            return true;
+        }
+        // reached before in as few steps
+        const auto [it, added] = _seen.try_emplace(Hash(next), depth + 1);
+        if (!added) {
+            if (it->second <= depth + 1) {
+                return false;
+            }
+            it->second = depth + 1;
+        }
+        return true;
+    }
+
+    bool Dfs(std::size_t depth)
+    {
+        for (std::size_t i = 0; i < _alphabet.size(); i++) {
+            if (Try(depth, i) && (depth + 1 == _length ? Found() : Dfs(depth + 1))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // The sequence passes the search's states; does it pass them all?
+    bool Found()
+    {
+        return Verify(_pattern, std::span{ _code.data(), _length }, _verified);
+    }
+
+    static std::uint64_t Hash(const std::array<State, TESTS>& states)
+    {
+        std::uint64_t h = 0;
+        for (const State& s : states) {
+            h = Mix(h ^ (std::uint64_t{ s.a } << 16 | s.d));
+            for (std::uint8_t i = 0; i < s.n; i++) {
+                h = Mix(h ^ (std::uint64_t{ s.writes[i].address } << 16 | s.writes[i].value));
+            }
+        }
+        return h;
+    }
+
+    const Pattern& _pattern;
+    std::span<const Step> _alphabet;
+    std::span<const Test, TESTS> _tests;
+    std::size_t _length;
+    std::array<Goal, TESTS> _goals{};
+    std::array<std::array<State, TESTS>, MAX_LENGTH + 1> _states{};
+    std::array<Step, MAX_LENGTH> _code{};
+    std::unordered_map<std::uint64_t, std::size_t> _seen; // state hash -> fewest steps
+    std::uint64_t _nodes{ 0 };
+    std::uint64_t _verified{ 0 };
+};
+
+struct Result
+{
+    std::vector<Step> code; // empty: none up to the length searched
+    std::uint64_t nodes{ 0 };
+    std::uint64_t verified{ 0 };
+};
+
+// The shortest sequence for `p`: lengths in turn, each split by its first
+// step over the cores; of the sequences found, the one whose first step
+// comes first in the alphabet
+Result
+Shortest(const Pattern& p, std::size_t max_length)
+{
+    const std::vector<Step> alphabet = Alphabet(p);
+    std::mt19937_64 rng{ 1 };
+    std::array<Test, TESTS> tests;
+    for (Test& t : tests) {
+        t = RandomTest(p, rng);
+    }
+
+    Result result;
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t length = 1; length <= max_length; length++) {
+        std::vector<std::optional<std::vector<Step>>> found(alphabet.size());
+        std::atomic<std::size_t> next{ 0 };
+        std::atomic<std::size_t> best{ alphabet.size() };
+        std::atomic<std::uint64_t> nodes{ 0 };
+        std::atomic<std::uint64_t> verified{ 0 };
+        auto work = [&] {
+            for (std::size_t first = next++; first < best; first = next++) {
+                Search search{ p, alphabet, tests, length };
+                found[first] = search.Run(first);
+                nodes += search.Nodes();
+                verified += search.Verified();
+                if (found[first]) {
+                    for (std::size_t b = best; first < b && !best.compare_exchange_weak(b, first);) {
+                    }
+                }
+            }
+        };
+        std::vector<std::jthread> threads;
+        for (unsigned c = 1; c < cores; c++) {
+            threads.emplace_back(work);
+        }
+        work();
+        threads.clear();
+
+        result.nodes += nodes;
+        result.verified += verified;
+        if (best < alphabet.size()) {
+            result.code = *found[best];
+            break;
+        }
+    }
+    return result;
+}
+
+std::string
+AsmText(const Step& s)
+{
+    if (s.param) {
+        return "@param";
+    }
+    if (s.instruction.kind == Asm::Instruction::Kind::At) {
+        return std::format("@{}", Asm::PREDEFINED_NAMES[s.instruction.symbol]);
+    }
+    return std::format("{}={}", Asm::DestOf(s.instruction.word), Asm::CompOf(s.instruction.word));
+}
+
+std::string
+CppText(const Step& s)
+{
+    if (s.param) {
+        return "PARAM";
+    }
+    if (s.instruction.kind == Asm::Instruction::Kind::At) {
+        return std::format("{{ Asm::At(Asm::{}) }}", Asm::PREDEFINED_NAMES[s.instruction.symbol]);
+    }
+    return std::format("{{ Asm::C(\"{}\") }}", AsmText(s));
+}
+
+void
+Usage()
+{
+    std::cout << "Usage: superopt <superopt_table.h> [max length]\n";
+    std::cout << "  max length : of the sequences searched, 1 to " << MAX_LENGTH << " (default 5)\n";
+}
+
+} // namespace
+
+int
+main(int argc, char const* argv[])
+{
+    if (argc < 2 || argc > 3) {
+        Usage();
+        return -1;
+    }
+    const std::size_t max_length = argc == 3 ? std::stoul(argv[2]) : 5;
+    if (max_length < 1 || max_length > MAX_LENGTH) {
+        Usage();
+        return -1;
+    }
+
+    std::string table;
+    for (const Pattern& p : PATTERNS) {
+        const auto start    = std::chrono::steady_clock::now();
+        const Result result = Shortest(p, max_length);
+        const auto ms =
+          std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        std::cout << p.vm << ": ";
+        if (result.code.empty()) {
+            std::cout << "nothing up to " << max_length << " instructions\n";
+            return 1;
+        }
+        std::string text, code;
+        for (const Step& s : result.code) {
+            text += std::format(" {}", AsmText(s));
+            code += std::format("    {},\n", CppText(s));
+        }
+        std::cout << result.code.size() << " instructions," << text << " (" << result.nodes << " prefixes, "
+                  << result.verified << " states verified, " << ms << " ms)" << std::endl;
+
+        table += std::format("\n// {}:{}\ninline constexpr Step {}[] = {{\n{}}};\n", p.vm, text, p.name, code);
+    }
+
+    std::ofstream out{ argv[1], std::ios::out | std::ios::trunc };
+    out << "// Generated by superopt (superopt.cpp) searching up to " << max_length << " instructions; do not edit.\n"
+        << "// The shortest Hack sequences for these VM commands. Words above the new\n"
+        << "// SP may be left changed; PARAM is the A-instruction of the command's\n"
+        << "// constant or address.\n"
+        << "#ifndef VM_SUPEROPT_TABLE_HH\n#define VM_SUPEROPT_TABLE_HH\n\n#include \"superopt.h\"\n\n"
+        << "namespace Vm::Superopt {\n"
+        << table << "\n} // namespace Vm::Superopt\n\n#endif\n";
+    if (!out) {
+        std::cerr << "cannot write " << argv[1] << "\n";
+        return 1;
+    }
+    return 0;
+}
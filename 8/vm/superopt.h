@@ -0,0 +1,20 @@
+#ifndef VM_SUPEROPT_HH
+#define VM_SUPEROPT_HH
+
+#include "../../6/asm/instruction.h"
+
+namespace Vm::Superopt {
+
+// One instruction of a sequence found by superopt: the instruction itself,
+// or the A-instruction of the constant or address the VM command names
+struct Step
+{
+    Asm::Instruction instruction{};
+    bool param{ false };
+};
+
+inline constexpr Step PARAM{ {}, true };
+
+} // namespace Vm::Superopt
+
+#endif
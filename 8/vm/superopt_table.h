@@ -0,0 +1,145 @@
+// Generated by superopt (superopt.cpp) searching up to 5 instructions; do not edit.
+// The shortest Hack sequences for these VM commands. Words above the new
+// SP may be left changed; PARAM is the A-instruction of the command's
+// constant or address.
+#ifndef VM_SUPEROPT_TABLE_HH
+#define VM_SUPEROPT_TABLE_HH
+
+#include "superopt.h"
+
+namespace Vm::Superopt {
+
+// add: @SP AM=M-1 D=M A=A-1 M=D+M
+inline constexpr Step ADD[] = {
+    { Asm::At(Asm::SP) },
+    { Asm::C("AM=M-1") },
+    { Asm::C("D=M") },
+    { Asm::C("A=A-1") },
+    { Asm::C("M=D+M") },
+};
+
+// sub: @SP AM=M-1 D=M A=A-1 M=M-D
+inline constexpr Step SUB[] = {
+    { Asm::At(Asm::SP) },
+    { Asm::C("AM=M-1") },
+    { Asm::C("D=M") },
+    { Asm::C("A=A-1") },
+    { Asm::C("M=M-D") },
+};
+
+// and: @SP AM=M-1 D=M A=A-1 M=D&M
+inline constexpr Step AND[] = {
+    { Asm::At(Asm::SP) },
+    { Asm::C("AM=M-1") },
+    { Asm::C("D=M") },
+    { Asm::C("A=A-1") },
+    { Asm::C("M=D&M") },
+};
+
+// or: @SP AM=M-1 D=M A=A-1 M=D|M
+inline constexpr Step OR[] = {
+    { Asm::At(Asm::SP) },
+    { Asm::C("AM=M-1") },
+    { Asm::C("D=M") },
+    { Asm::C("A=A-1") },
+    { Asm::C("M=D|M") },
+};
+
+// neg: @SP A=M-1 M=-M
+inline constexpr Step NEG[] = {
+    { Asm::At(Asm::SP) },
+    { Asm::C("A=M-1") },
+    { Asm::C("M=-M") },
+};
+
+// not: @SP A=M-1 M=!M
+inline constexpr Step NOT[] = {
+    { Asm::At(Asm::SP) },
+    { Asm::C("A=M-1") },
+    { Asm::C("M=!M") },
+};
+
+// push constant c; add: @param D=A @SP A=M-1 M=D+M
+inline constexpr Step PUSH_CONSTANT_ADD[] = {
+    PARAM,
+    { Asm::C("D=A") },
+    { Asm::At(Asm::SP) },
+    { Asm::C("A=M-1") },
+    { Asm::C("M=D+M") },
+};
+
+// push constant c; sub: @param D=A @SP A=M-1 M=M-D
+inline constexpr Step PUSH_CONSTANT_SUB[] = {
+    PARAM,
+    { Asm::C("D=A") },
+    { Asm::At(Asm::SP) },
+    { Asm::C("A=M-1") },
+    { Asm::C("M=M-D") },
+};
+
+// push constant c; and: @param D=A @SP A=M-1 M=D&M
+inline constexpr Step PUSH_CONSTANT_AND[] = {
+    PARAM,
+    { Asm::C("D=A") },
+    { Asm::At(Asm::SP) },
+    { Asm::C("A=M-1") },
+    { Asm::C("M=D&M") },
+};
+
+// push constant c; or: @param D=A @SP A=M-1 M=D|M
+inline constexpr Step PUSH_CONSTANT_OR[] = {
+    PARAM,
+    { Asm::C("D=A") },
+    { Asm::At(Asm::SP) },
+    { Asm::C("A=M-1") },
+    { Asm::C("M=D|M") },
+};
+
+// push s i; add: @param D=M @SP A=M-1 M=D+M
+inline constexpr Step PUSH_DIRECT_ADD[] = {
+    PARAM,
+    { Asm::C("D=M") },
+    { Asm::At(Asm::SP) },
+    { Asm::C("A=M-1") },
+    { Asm::C("M=D+M") },
+};
+
+// push s i; sub: @param D=M @SP A=M-1 M=M-D
+inline constexpr Step PUSH_DIRECT_SUB[] = {
+    PARAM,
+    { Asm::C("D=M") },
+    { Asm::At(Asm::SP) },
+    { Asm::C("A=M-1") },
+    { Asm::C("M=M-D") },
+};
+
+// push s i; and: @param D=M @SP A=M-1 M=D&M
+inline constexpr Step PUSH_DIRECT_AND[] = {
+    PARAM,
+    { Asm::C("D=M") },
+    { Asm::At(Asm::SP) },
+    { Asm::C("A=M-1") },
+    { Asm::C("M=D&M") },
+};
+
+// push s i; or: @param D=M @SP A=M-1 M=D|M
+inline constexpr Step PUSH_DIRECT_OR[] = {
+    PARAM,
+    { Asm::C("D=M") },
+    { Asm::At(Asm::SP) },
+    { Asm::C("A=M-1") },
+    { Asm::C("M=D|M") },
+};
+
+// pop s i; push s i: @SP A=M-1 D=M @param M=D
+inline constexpr Step POP_PUSH[] = {
+    { Asm::At(Asm::SP) },
+    { Asm::C("A=M-1") },
+    { Asm::C("D=M") },
+    PARAM,
+    { Asm::C("M=D") },
+};
+
+} // namespace Vm::Superopt
+
+#endif
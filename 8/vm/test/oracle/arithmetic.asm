@@ -0,0 +1,7817 @@
+@256
+D=A
+@SP
+M=D
+@Sys.init$ret.0
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@LCL
+D=M
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@ARG
+D=M
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@THIS
+D=M
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@THAT
+D=M
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@5
+D=A
+@SP
+D=M-D
+@ARG
+M=D
+@SP
+D=M
+@LCL
+M=D
+@Sys.init
+0;JMP
+(Sys.init$ret.0)
+(Sys.init)
+@3000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+M=D
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@8
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D+M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+M=D
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@8
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=M-D
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+M=D
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@8
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JEQ_TRUE_0
+D;JEQ
+@JEQ_END_0
+0;JMP
+(JEQ_TRUE_0)
+@SP
+A=M
+M=-1
+(JEQ_END_0)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+M=D
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@8
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JGT_TRUE_0
+D;JGT
+@JGT_END_0
+0;JMP
+(JGT_TRUE_0)
+@SP
+A=M
+M=-1
+(JGT_END_0)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+M=D
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@8
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JLT_TRUE_0
+D;JLT
+@JLT_END_0
+0;JMP
+(JLT_TRUE_0)
+@SP
+A=M
+M=-1
+(JLT_END_0)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@8
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D&M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@8
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D|M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@8
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D+M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@8
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=M-D
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@8
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JEQ_TRUE_1
+D;JEQ
+@JEQ_END_1
+0;JMP
+(JEQ_TRUE_1)
+@SP
+A=M
+M=-1
+(JEQ_END_1)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@8
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JGT_TRUE_1
+D;JGT
+@JGT_END_1
+0;JMP
+(JGT_TRUE_1)
+@SP
+A=M
+M=-1
+(JGT_END_1)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@8
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JLT_TRUE_1
+D;JLT
+@JLT_END_1
+0;JMP
+(JLT_TRUE_1)
+@SP
+A=M
+M=-1
+(JLT_END_1)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@8
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D&M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@8
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D|M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D+M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=M-D
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JEQ_TRUE_2
+D;JEQ
+@JEQ_END_2
+0;JMP
+(JEQ_TRUE_2)
+@SP
+A=M
+M=-1
+(JEQ_END_2)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JGT_TRUE_2
+D;JGT
+@JGT_END_2
+0;JMP
+(JGT_TRUE_2)
+@SP
+A=M
+M=-1
+(JGT_END_2)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JLT_TRUE_2
+D;JLT
+@JLT_END_2
+0;JMP
+(JLT_TRUE_2)
+@SP
+A=M
+M=-1
+(JLT_END_2)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D&M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@7
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D|M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D+M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=M-D
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JEQ_TRUE_3
+D;JEQ
+@JEQ_END_3
+0;JMP
+(JEQ_TRUE_3)
+@SP
+A=M
+M=-1
+(JEQ_END_3)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JGT_TRUE_3
+D;JGT
+@JGT_END_3
+0;JMP
+(JGT_TRUE_3)
+@SP
+A=M
+M=-1
+(JGT_END_3)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JLT_TRUE_3
+D;JLT
+@JLT_END_3
+0;JMP
+(JLT_TRUE_3)
+@SP
+A=M
+M=-1
+(JLT_END_3)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D&M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D|M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D+M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=M-D
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JEQ_TRUE_4
+D;JEQ
+@JEQ_END_4
+0;JMP
+(JEQ_TRUE_4)
+@SP
+A=M
+M=-1
+(JEQ_END_4)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JGT_TRUE_4
+D;JGT
+@JGT_END_4
+0;JMP
+(JGT_TRUE_4)
+@SP
+A=M
+M=-1
+(JGT_END_4)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JLT_TRUE_4
+D;JLT
+@JLT_END_4
+0;JMP
+(JLT_TRUE_4)
+@SP
+A=M
+M=-1
+(JLT_END_4)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D&M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D|M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D+M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=M-D
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JEQ_TRUE_5
+D;JEQ
+@JEQ_END_5
+0;JMP
+(JEQ_TRUE_5)
+@SP
+A=M
+M=-1
+(JEQ_END_5)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JGT_TRUE_5
+D;JGT
+@JGT_END_5
+0;JMP
+(JGT_TRUE_5)
+@SP
+A=M
+M=-1
+(JGT_END_5)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JLT_TRUE_5
+D;JLT
+@JLT_END_5
+0;JMP
+(JLT_TRUE_5)
+@SP
+A=M
+M=-1
+(JLT_END_5)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D&M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D|M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D+M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=M-D
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JEQ_TRUE_6
+D;JEQ
+@JEQ_END_6
+0;JMP
+(JEQ_TRUE_6)
+@SP
+A=M
+M=-1
+(JEQ_END_6)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JGT_TRUE_6
+D;JGT
+@JGT_END_6
+0;JMP
+(JGT_TRUE_6)
+@SP
+A=M
+M=-1
+(JGT_END_6)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JLT_TRUE_6
+D;JLT
+@JLT_END_6
+0;JMP
+(JLT_TRUE_6)
+@SP
+A=M
+M=-1
+(JLT_END_6)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D&M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D|M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D+M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=M-D
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JEQ_TRUE_7
+D;JEQ
+@JEQ_END_7
+0;JMP
+(JEQ_TRUE_7)
+@SP
+A=M
+M=-1
+(JEQ_END_7)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JGT_TRUE_7
+D;JGT
+@JGT_END_7
+0;JMP
+(JGT_TRUE_7)
+@SP
+A=M
+M=-1
+(JGT_END_7)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JLT_TRUE_7
+D;JLT
+@JLT_END_7
+0;JMP
+(JLT_TRUE_7)
+@SP
+A=M
+M=-1
+(JLT_END_7)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D&M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D|M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D+M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=M-D
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JEQ_TRUE_8
+D;JEQ
+@JEQ_END_8
+0;JMP
+(JEQ_TRUE_8)
+@SP
+A=M
+M=-1
+(JEQ_END_8)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JGT_TRUE_8
+D;JGT
+@JGT_END_8
+0;JMP
+(JGT_TRUE_8)
+@SP
+A=M
+M=-1
+(JGT_END_8)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JLT_TRUE_8
+D;JLT
+@JLT_END_8
+0;JMP
+(JLT_TRUE_8)
+@SP
+A=M
+M=-1
+(JLT_END_8)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D&M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@20000
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D|M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@0
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@0
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D+M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@0
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@0
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=M-D
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@0
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@0
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JEQ_TRUE_9
+D;JEQ
+@JEQ_END_9
+0;JMP
+(JEQ_TRUE_9)
+@SP
+A=M
+M=-1
+(JEQ_END_9)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@0
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@0
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JGT_TRUE_9
+D;JGT
+@JGT_END_9
+0;JMP
+(JGT_TRUE_9)
+@SP
+A=M
+M=-1
+(JGT_END_9)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@0
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@0
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JLT_TRUE_9
+D;JLT
+@JLT_END_9
+0;JMP
+(JLT_TRUE_9)
+@SP
+A=M
+M=-1
+(JLT_END_9)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@0
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@0
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D&M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@0
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@0
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D|M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@5
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@5
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D+M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@5
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@5
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=M-D
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@5
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@5
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JEQ_TRUE_10
+D;JEQ
+@JEQ_END_10
+0;JMP
+(JEQ_TRUE_10)
+@SP
+A=M
+M=-1
+(JEQ_END_10)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@5
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@5
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JGT_TRUE_10
+D;JGT
+@JGT_END_10
+0;JMP
+(JGT_TRUE_10)
+@SP
+A=M
+M=-1
+(JGT_END_10)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@5
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@5
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JLT_TRUE_10
+D;JLT
+@JLT_END_10
+0;JMP
+(JLT_TRUE_10)
+@SP
+A=M
+M=-1
+(JLT_END_10)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@5
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@5
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D&M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@5
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@5
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D|M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D+M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=M-D
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JEQ_TRUE_11
+D;JEQ
+@JEQ_END_11
+0;JMP
+(JEQ_TRUE_11)
+@SP
+A=M
+M=-1
+(JEQ_END_11)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JGT_TRUE_11
+D;JGT
+@JGT_END_11
+0;JMP
+(JGT_TRUE_11)
+@SP
+A=M
+M=-1
+(JGT_END_11)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+AM=M-1
+D=M-D
+@SP
+A=M
+M=0
+@JLT_TRUE_11
+D;JLT
+@JLT_END_11
+0;JMP
+(JLT_TRUE_11)
+@SP
+A=M
+M=-1
+(JLT_END_11)
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D&M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M-1
+M=D|M
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@0
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@0
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=!D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=!D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@1
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=!D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=!D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+@32767
+D=A
+@SP
+A=M
+M=D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=-D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@SP
+A=M
+M=!D
+@SP
+M=M+1
+@SP
+AM=M-1
+D=M
+@THAT
+A=M
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+A=A+1
+M=D
+(HALT)
+@HALT
+0;JMP
@@ -0,0 +1,130 @@
+// Control flow graph tests
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../cfg.h"
+#include "../code_writer.h"
+#include "../oracle.h"
+#include "../pipeline.h"
+
+// The commands of each function after the pass, one string per command
+static std::vector<std::string>
+Optimise(std::string_view source)
+{
+    static constexpr const char* NAMES[]{ "",         "push",  "pop",    "label", "goto",
+                                          "if-goto",  "ifnot", "function", "return", "call" };
+    std::vector<std::string> out;
+    Vm::CodeWriter writer{ [](std::string_view) {} };
+    Vm::Pipeline pipeline{ writer };
+    pipeline.AddPass(Vm::OptimiseControlFlow);
+    pipeline.AddPass([&out](Vm::Function& f, Vm::Arena&) {
+        for (const Vm::Command& c : f.body) {
+            std::string s = c.type == Vm::Parser::Cmd::Arithmetic ? std::string{ c.arg1 }
+                                                                  : NAMES[static_cast<int>(c.type)];
+            if (c.type != Vm::Parser::Cmd::Arithmetic && !c.arg1.empty()) {
+                s += " " + std::string{ c.arg1 };
+            }
+            if (c.arg2 >= 0) {
+                s += " " + std::to_string(c.arg2);
+            }
+            out.push_back(s);
+        }
+    });
+    pipeline.Translate(source, "Main");
+    return out;
+}
+
+// A while loop as the Jack compiler writes it gets its test at the bottom
+TEST(CfgTest, RotatesLoops)
+{
+    const auto body = Optimise("function Main.count 1\n"
+                               "push constant 10\npop local 0\n"
+                               "label WHILE_EXP0\npush local 0\nnot\nif-goto WHILE_END0\n"
+                               "push local 0\npush constant 1\nsub\npop local 0\n"
+                               "goto WHILE_EXP0\n"
+                               "label WHILE_END0\npush constant 0\nreturn\n");
+
+    const std::vector<std::string> expected{
+        "function Main.count 1",
+        "push constant 10",
+        "pop local 0",
+        "goto WHILE_EXP0",
+        "label Main.count$cfg.2",
+        "push local 0",
+        "push constant 1",
+        "sub",
+        "pop local 0",
+        "label WHILE_EXP0",
+        "push local 0",
+        "not",
+        "ifnot Main.count$cfg.2",
+        "label WHILE_END0",
+        "push constant 0",
+        "return",
+    };
+    EXPECT_EQ(body, expected);
+}
+
+// Jumps to jumps go straight to the end, and code after return is dropped
+TEST(CfgTest, ThreadsJumps)
+{
+    const auto body = Optimise("function Main.sign 0\n"
+                               "push argument 0\nif-goto IF_TRUE0\ngoto IF_FALSE0\n"
+                               "label IF_TRUE0\npush constant 1\npop static 0\ngoto IF_END0\n"
+                               "label IF_FALSE0\ngoto SKIP\n"
+                               "label SKIP\npush constant 2\npop static 0\n"
+                               "label IF_END0\npush constant 0\nreturn\n"
+                               "label DEAD\npush constant 3\npop static 0\ngoto IF_END0\n");
+
+    const std::vector<std::string> expected{
+        "function Main.sign 0",
+        "push argument 0",
+        "if-goto IF_TRUE0",
+        "label SKIP",
+        "push constant 2",
+        "pop static 0",
+        "label IF_END0",
+        "push constant 0",
+        "return",
+        "label IF_TRUE0",
+        "push constant 1",
+        "pop static 0",
+        "goto IF_END0",
+    };
+    EXPECT_EQ(body, expected);
+}
+
+// Code outside any function and functions repeating a label stay as they are
+TEST(CfgTest, LeavesAlone)
+{
+    const std::string_view source{ "label L\npush constant 1\ngoto L\n"
+                                   "function Main.f 0\nlabel L\ngoto M\nlabel M\nlabel L\ngoto L\n" };
+    const std::vector<std::string> expected{
+        "label L", "push constant 1", "goto L",  "function Main.f 0", "label L",
+        "goto M",  "label M",         "label L", "goto L",
+    };
+    EXPECT_EQ(Optimise(source), expected);
+}
+
+// The rearranged code computes what the original does
+TEST(CfgTest, AgreesWithOriginal)
+{
+    static constexpr std::string_view PROGRAM{ "function Sys.init 0\n"
+                                               "push constant 7\ncall Main.sum 1\npop static 0\n"
+                                               "push constant 0\ncall Main.sign 1\npop static 1\n"
+                                               "label HALT\ngoto HALT\n"
+                                               "function Main.sum 1\n"
+                                               "label WHILE_EXP0\npush argument 0\npush constant 0\neq\n"
+                                               "if-goto WHILE_END0\npush local 0\npush argument 0\nadd\npop local 0\n"
+                                               "push argument 0\npush constant 1\nsub\npop argument 0\n"
+                                               "goto WHILE_EXP0\n"
+                                               "label WHILE_END0\npush local 0\nreturn\n"
+                                               "function Main.sign 0\n"
+                                               "push argument 0\nif-goto IF_TRUE0\ngoto IF_FALSE0\n"
+                                               "label IF_TRUE0\npush constant 1\nreturn\n"
+                                               "label IF_FALSE0\npush constant 2\nreturn\n" };
+    const Vm::Oracle oracle{ 100000 };
+    EXPECT_FALSE(oracle.Compare(PROGRAM, Vm::Oracle::WithPasses({ Vm::OptimiseControlFlow })));
+}
@@ -0,0 +1,104 @@
+// CodeWriter tests
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "../../../6/asm/assembler.h"
+#include "../code_writer.h"
+
+static void
+Translate(Vm::CodeWriter& w)
+{
+    w.SetFileName("Main");
+    w.WriteFuntion("Main.main", 2);
+    w.WritePushPop(Vm::Parser::Cmd::Push, "constant", 7);
+    w.WritePushPop(Vm::Parser::Cmd::Push, "static", 3);
+    w.WriteArithmetic("lt");
+    w.WriteIf("Main$IF_TRUE0");
+    w.WritePushPop(Vm::Parser::Cmd::Pop, "local", 1);
+    w.WriteLabel("Main$IF_TRUE0");
+    w.WriteCall("Main.f", 1);
+    w.WriteReturn();
+}
+
+// Instructions handed over in memory assemble to the same words as the .asm text
+TEST(CodeWriterTest, ListingMatchesText)
+{
+    std::string text;
+    {
+        Vm::CodeWriter writer{ [&text](std::string_view s) { text += s; } };
+        Translate(writer);
+    }
+    Asm::Listing parsed;
+    Asm::ParseAsm(text, parsed);
+    Asm::Program from_text;
+    Asm::Assemble(parsed, from_text);
+
+    Asm::Listing listing;
+    {
+        Vm::CodeWriter writer{ listing };
+        Translate(writer);
+    }
+    Asm::Program in_memory;
+    Asm::Assemble(listing, in_memory);
+
+    EXPECT_EQ(in_memory.words, from_text.words);
+    EXPECT_EQ(in_memory.labels.at("Main.main"), from_text.labels.at("Main.main"));
+    EXPECT_GT(in_memory.words.size(), 100u);
+}
+
+// Each push and pop is written in its cheapest form, and the savings are counted
+TEST(CodeWriterTest, SelectsCheapestForm)
+{
+    const auto translate = [](bool select) {
+        Asm::Listing listing;
+        Vm::CodeWriter writer{ listing, false };
+        writer.SetSelection(select);
+        writer.WritePushPop(Vm::Parser::Cmd::Pop, "local", 40);   // 46 stepping A, 9 with D = address + value
+        writer.WritePushPop(Vm::Parser::Cmd::Push, "local", 40);  // 10, 9 moving SP first
+        writer.WritePushPop(Vm::Parser::Cmd::Push, "constant", 0); // 7, 4 storing 0 directly
+        writer.WritePushPop(Vm::Parser::Cmd::Pop, "local", 0);    // 6 either way
+        return std::pair{ listing.Code().size(), writer.GetSelection() };
+    };
+
+    const auto [original, unchanged] = translate(false);
+    EXPECT_EQ(original, 46u + 10 + 7 + 6);
+    EXPECT_EQ(unchanged.commands, 4u);
+    EXPECT_EQ(unchanged.rewritten, 0u);
+    EXPECT_EQ(unchanged.saved, 0u);
+
+    const auto [selected, selection] = translate(true);
+    EXPECT_EQ(selected, 9u + 9 + 4 + 6);
+    EXPECT_EQ(selection.commands, 4u);
+    EXPECT_EQ(selection.rewritten, 3u);
+    EXPECT_EQ(selection.saved, original - selected);
+}
+
+// Arithmetic and the pairs of superopt_table.h take the sequences superopt found
+TEST(CodeWriterTest, SuperoptimisedSequences)
+{
+    const auto translate = [](bool select) {
+        Asm::Listing listing;
+        Vm::CodeWriter writer{ listing, false };
+        writer.SetFileName("Main");
+        writer.SetSelection(select);
+        writer.WriteArithmetic("add");                    // 6, 5
+        writer.WriteArithmetic("not");                    // 8, 3
+        writer.WritePushArithmetic("constant", 7, "sub"); // 7 + 6, 5
+        writer.WritePushArithmetic("static", 2, "or");    // 7 + 6, 5
+        writer.WritePopPush("temp", 3);                   // 5 + 7, 5
+        writer.WritePushArithmetic("local", 1, "neg");    // no pair: 10 + 8, 8 + 3
+        return std::pair{ listing.Code().size(), writer.GetSelection() };
+    };
+
+    const auto [original, unchanged] = translate(false);
+    EXPECT_EQ(original, 6u + 8 + 13 + 13 + 12 + 18);
+    EXPECT_EQ(unchanged.rewritten, 0u);
+
+    const auto [selected, selection] = translate(true);
+    EXPECT_EQ(selected, 5u + 3 + 5 + 5 + 5 + 11);
+    EXPECT_EQ(selection.commands, 7u);
+    EXPECT_EQ(selection.rewritten, 7u);
+    EXPECT_EQ(selection.saved, original - selected);
+}
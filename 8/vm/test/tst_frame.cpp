@@ -0,0 +1,114 @@
+// Calling convention and tail call tests
+#include <gtest/gtest.h>
+#include <string_view>
+
+#include "../../../5/emu/computer.h"
+#include "../../../6/asm/assembler.h"
+#include "../frame.h"
+#include "../oracle.h"
+
+using Vm::Conventions;
+using Vm::Frame;
+
+static constexpr std::string_view PROGRAM{ "function Sys.init 0\n"
+                                           "push constant 5\ncall Main.fib 1\npop static 0\n"
+                                           "push constant 3000\ncall Main.set 1\n"
+                                           "push constant 1\npush constant 2\ncall Main.sum 2\npop static 1\n"
+                                           "label HALT\ngoto HALT\n"
+                                           "function Main.fib 0\n"
+                                           "push argument 0\npush constant 2\nlt\nif-goto BASE\n"
+                                           "push argument 0\npush constant 1\nsub\ncall Main.fib 1\n"
+                                           "push argument 0\npush constant 2\nsub\ncall Main.fib 1\n"
+                                           "add\nreturn\n"
+                                           "label BASE\npush argument 0\nreturn\n"
+                                           "function Main.set 0\n"
+                                           "push argument 0\npop pointer 0\npush constant 9\npop this 1\n"
+                                           "push constant 0\nreturn\n"
+                                           "function Main.sum 1\n"
+                                           "push argument 0\npush argument 1\nadd\npop local 0\n"
+                                           "push local 0\nreturn\n" };
+
+// Callees keep only what they change
+TEST(FrameTest, Reduced)
+{
+    Conventions c;
+    c.Scan(PROGRAM);
+
+    const Frame fib = c.Of("Main.fib");
+    EXPECT_FALSE(fib.lcl);
+    EXPECT_FALSE(fib.this_that);
+    EXPECT_EQ(fib.n_args, 1);
+    EXPECT_EQ(fib.Size(), 2);
+
+    const Frame set = c.Of("Main.set");
+    EXPECT_FALSE(set.lcl);
+    EXPECT_TRUE(set.this_that);
+    EXPECT_EQ(set.Size(), 4);
+
+    const Frame sum = c.Of("Main.sum");
+    EXPECT_TRUE(sum.lcl);
+    EXPECT_FALSE(sum.this_that);
+    EXPECT_EQ(sum.Size(), 3);
+}
+
+// Functions that may be called from outside the scanned code keep the full frame
+TEST(FrameTest, Full)
+{
+    Conventions c;
+    c.Scan(PROGRAM);
+    c.Scan(std::string_view{ "function Lib.f 0\npush constant 1\nreturn\n"
+                             "function Lib.g 0\npush constant 1\nreturn\n"
+                             "function Main.h 0\ncall Lib.g 0\ncall Lib.g 1\nreturn\n" });
+
+    EXPECT_EQ(c.Of("Sys.init").Size(), 5);
+    EXPECT_EQ(c.Of("Lib.f").Size(), 5);     // never called
+    EXPECT_EQ(c.Of("Lib.g").Size(), 5);     // called with different counts
+    EXPECT_EQ(c.Of("Main.none").Size(), 5); // not defined
+}
+
+// Reduced frames compute what full frames do
+TEST(FrameTest, AgreesWithFullFrames)
+{
+    const Vm::Oracle oracle{ 100000 };
+    EXPECT_FALSE(oracle.Compare(PROGRAM, Vm::Oracle::WithPasses({})));
+}
+
+// h(n, acc) = n ? h(n-1, acc+n) : acc, with a local, and a caller with
+// locals whose tail call goes to a leaf without
+static constexpr std::string_view TAIL_CALLS{ "function Sys.init 2\n"
+                                              "push constant 7\npop local 1\n"
+                                              "push constant 9\npush constant 4\ncall Main.f 2\npop static 0\n"
+                                              "push constant 1000\npush constant 0\ncall Main.h 2\npop static 1\n"
+                                              "push local 1\npop static 2\n"
+                                              "label HALT\ngoto HALT\n"
+                                              "function Main.f 2\n"
+                                              "push argument 0\npush argument 1\ncall Main.g 2\nreturn\n"
+                                              "function Main.g 0\n"
+                                              "push argument 0\npush argument 1\nsub\nreturn\n"
+                                              "function Main.h 1\n"
+                                              "push argument 0\nif-goto STEP\npush argument 1\nreturn\n"
+                                              "label STEP\npush argument 0\npush constant 1\nsub\n"
+                                              "push argument 1\npush local 0\nadd\npush argument 0\nadd\n"
+                                              "pop local 0\npush local 0\ncall Main.h 2\nreturn\n" };
+
+// A thousand levels of recursion in a constant stack, and the caller's
+// frame back in place after the leaf returns straight to it
+TEST(FrameTest, TailCalls)
+{
+    Asm::Listing listing;
+    Vm::Oracle::WithPasses({})(TAIL_CALLS, listing);
+    Asm::Program program;
+    Asm::Assemble(listing, program);
+
+    Emu::Computer computer;
+    computer.LoadRom(program.words);
+    computer.Run(1'000'000);
+    ASSERT_TRUE(computer.Halted());
+
+    EXPECT_EQ(computer.Read(16), 5);
+    EXPECT_EQ(computer.Read(17), static_cast<std::uint16_t>(1000 * 1001 / 2));
+    EXPECT_EQ(computer.Read(18), 7);
+    // the full frames of 1000 calls would reach far beyond 2048
+    EXPECT_LT(computer.Read(0), 300); // SP
+    EXPECT_EQ(computer.Read(2048), 0);
+}
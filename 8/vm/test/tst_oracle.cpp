@@ -0,0 +1,86 @@
+// Oracle tests
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include "../oracle.h"
+
+using Vm::Oracle;
+
+static constexpr std::string_view PROGRAM{ "function Sys.init 1\n"
+                                           "push constant 6\npush constant 7\ncall Main.mul 2\npop static 0\n"
+                                           "push constant 3000\npop pointer 1\npush static 0\npop that 2\n"
+                                           "label HALT\ngoto HALT\n"
+                                           "function Main.mul 1\n"
+                                           "label LOOP\npush argument 1\nif-goto BODY\npush local 0\nreturn\n"
+                                           "label BODY\npush local 0\npush argument 0\nadd\npop local 0\n"
+                                           "push argument 1\npush constant 1\nsub\npop argument 1\ngoto LOOP\n" };
+
+// The in-memory pipeline computes what the original translator does
+TEST(OracleTest, AgreesWithoutPasses)
+{
+    const Oracle oracle{ 100000 };
+    EXPECT_FALSE(oracle.Compare(PROGRAM, Oracle::WithPasses({})));
+}
+
+// A pass that changes the result is caught at the first word it changes
+TEST(OracleTest, CatchesWrongPass)
+{
+    const Oracle oracle{ 100000 };
+    const auto wrong = Oracle::WithPasses({ [](Vm::Function& f, Vm::Arena&) {
+        for (auto&& c : f.body) {
+            if (c.type == Vm::Parser::Cmd::Push && c.arg1 == "constant" && c.arg2 == 7) {
+                c.arg2 = 8;
+            }
+        }
+    } });
+
+    const auto d = oracle.Compare(PROGRAM, wrong);
+    ASSERT_TRUE(d);
+    EXPECT_TRUE(d->halted);
+    EXPECT_EQ(d->address, 16);
+    EXPECT_EQ(d->expected, 42);
+    EXPECT_EQ(d->actual, 48);
+}
+
+// A candidate that loops where the original halts diverges too
+TEST(OracleTest, CatchesNonTermination)
+{
+    const Oracle oracle{ 100000 };
+    const auto loops = Oracle::WithPasses({ [](Vm::Function& f, Vm::Arena& arena) {
+        for (auto&& c : f.body) {
+            if (c.type == Vm::Parser::Cmd::Return) {
+                c = { Vm::Parser::Cmd::Goto, arena.Copy("LOOP"), -1 };
+            }
+        }
+    } });
+
+    const auto d = oracle.Compare(PROGRAM, loops);
+    ASSERT_TRUE(d);
+    EXPECT_FALSE(d->halted);
+}
+
+static std::string
+ReadFile(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return { std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+}
+
+// The templates the reference shares with the candidates compute what the
+// original translator's checked-in output does
+TEST(OracleTest, AgreesWithPinnedOutput)
+{
+    for (const char* name : { "arithmetic", "segments", "calls" }) {
+        const std::string source = ReadFile(ORACLE_DIR "/" + std::string(name) + ".vm");
+        const std::string pinned = ReadFile(ORACLE_DIR "/" + std::string(name) + ".asm");
+        ASSERT_FALSE(source.empty()) << name;
+        ASSERT_FALSE(pinned.empty()) << name;
+
+        const Oracle oracle{ 1000000, Oracle::Pinned(pinned) };
+        EXPECT_FALSE(oracle.Compare(source, Oracle::Reference)) << name;
+        EXPECT_FALSE(oracle.Compare(source, Oracle::WithPasses({}))) << name;
+    }
+}
@@ -3,6 +3,7 @@
 #include <fstream>
 #include <gtest/gtest.h>
 #include <string>
+#include <string_view>
 
 #include "../parser.h"
 
@@ -31,6 +32,45 @@ class ParserTest : public ::testing::Test
     }
 };
 
+// The file constructor reads the same lines, with \r\n and \r line ends
+TEST_F(ParserTest, FromFile)
+{
+    writeFile("push constant 7\r\n// comment\rpush local 0 // x\nadd");
+    Parser p(tmp_filename);
+
+    p.Advance();
+    EXPECT_EQ(p.Arg2(), 7);
+    p.Advance();
+    EXPECT_EQ(p.Arg1(), "local");
+    p.Advance();
+    EXPECT_EQ(p.Arg1(), "add");
+    EXPECT_FALSE(p.HasMoreLines());
+}
+
+// The span constructor parses text held in memory the same way
+TEST_F(ParserTest, FromMemory)
+{
+    Parser p{ std::string_view{ "// push x\npush local 8\r\nlt // y\rcall Main.f 2\n\n" } };
+
+    EXPECT_EQ(p.CommandType(), Parser::Cmd::Invalid);
+    EXPECT_TRUE(p.HasMoreLines());
+    p.Advance();
+    EXPECT_EQ(p.CommandType(), Parser::Cmd::Push);
+    EXPECT_EQ(p.Arg1(), "local");
+    EXPECT_EQ(p.Arg2(), 8);
+    p.Advance();
+    EXPECT_EQ(p.CommandType(), Parser::Cmd::Arithmetic);
+    EXPECT_EQ(p.Arg1(), "lt");
+    EXPECT_EQ(p.Arg2(), -1);
+    p.Advance();
+    EXPECT_EQ(p.CommandType(), Parser::Cmd::Call);
+    EXPECT_EQ(p.Arg1(), "Main.f");
+    EXPECT_EQ(p.Arg2(), 2);
+    EXPECT_TRUE(p.HasMoreLines());
+    p.Advance();
+    EXPECT_FALSE(p.HasMoreLines());
+}
+
 // HasMoreLines - template to verify whether parser reports remaining input correctly
 TEST_F(ParserTest, HasMoreLines)
 {
@@ -98,6 +138,47 @@ TEST_F(ParserTest, Arg2)
     EXPECT_EQ(p.Arg2(), 8);
 }
 
+// Malformed arguments are reported as missing instead of throwing
+TEST_F(ParserTest, Malformed)
+{
+    Parser p{ std::string_view{ "push  constant\t7 // a/b\npush constant 7x\npush constant\nlabel 1a\nlabel a/b\n" } };
+
+    p.Advance();
+    EXPECT_EQ(p.Arg1(), "constant");
+    EXPECT_EQ(p.Arg2(), 7);
+    p.Advance();
+    EXPECT_EQ(p.Arg2(), -1);
+    p.Advance();
+    EXPECT_EQ(p.Arg1(), "constant");
+    EXPECT_EQ(p.Arg2(), -1);
+    p.Advance();
+    EXPECT_EQ(p.Arg1(), "");
+    p.Advance();
+    EXPECT_EQ(p.CommandType(), Parser::Cmd::Label);
+    EXPECT_EQ(p.Arg1(), "");
+}
+
+// SegmentType/OpType - Arg1 as the enums the code writer dispatches on
+TEST_F(ParserTest, Types)
+{
+    Parser p{ std::string_view{ "push that 2\nnot\npop heap 0\ncall Main.f 0\n" } };
+
+    p.Advance();
+    EXPECT_EQ(p.SegmentType(), Parser::Segment::That);
+    EXPECT_EQ(p.OpType(), Parser::Op::Invalid);
+    p.Advance();
+    EXPECT_EQ(p.SegmentType(), Parser::Segment::Invalid);
+    EXPECT_EQ(p.OpType(), Parser::Op::Not);
+    p.Advance();
+    EXPECT_EQ(p.SegmentType(), Parser::Segment::Invalid);
+    p.Advance();
+    EXPECT_EQ(p.SegmentType(), Parser::Segment::Invalid);
+    EXPECT_EQ(p.OpType(), Parser::Op::Invalid);
+
+    static_assert(Parser::ToOp("lt") == Parser::Op::Lt);
+    static_assert(Parser::ToSegment("temp") == Parser::Segment::Temp);
+}
+
 int
 main(int argc, char** argv)
 {
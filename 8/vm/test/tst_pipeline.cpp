@@ -0,0 +1,179 @@
+// Pipeline and Arena tests
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../../../6/asm/assembler.h"
+#include "../code_writer.h"
+#include "../ir.h"
+#include "../pipeline.h"
+
+using Vm::Arena;
+using Vm::Pipeline;
+
+TEST(ArenaTest, ResetReusesChunks)
+{
+    Arena arena;
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 10000; i++) {
+            const std::string_view s = arena.Copy("push constant 1");
+            EXPECT_EQ(s, "push constant 1");
+        }
+        arena.Reset();
+    }
+    const std::size_t capacity = arena.Capacity();
+    EXPECT_GE(capacity, 10000u * 15);
+
+    for (int i = 0; i < 10000; i++) {
+        arena.Copy("push constant 1");
+    }
+    EXPECT_EQ(arena.Capacity(), capacity);
+}
+
+TEST(ArenaTest, LargeAndAligned)
+{
+    Arena arena;
+    arena.Copy("x");
+    auto* big = arena.AllocateArray<std::uint64_t>(Arena::CHUNK_SIZE);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(big) % alignof(std::uint64_t), 0u);
+    big[Arena::CHUNK_SIZE - 1] = 1;
+
+    Vm::ArenaVector<int> v{ arena };
+    for (int i = 0; i < 1000; i++) {
+        v.push_back(i);
+    }
+    ASSERT_EQ(v.size(), 1000u);
+    EXPECT_EQ(v[999], 999);
+}
+
+class PipelineTest : public ::testing::Test
+{
+  protected:
+    std::string dir;
+
+    void SetUp() override
+    {
+        dir = std::string("/tmp/vm_pipeline_test_") + std::to_string(::getpid()) + "_" + std::to_string(::rand());
+    }
+
+    void TearDown() override
+    {
+        std::remove((dir + ".vm").c_str());
+        std::remove((dir + ".asm").c_str());
+    }
+
+    void writeFile(const std::string& contents)
+    {
+        std::ofstream out(dir + ".vm");
+        out << contents;
+    }
+
+    std::string readOutput()
+    {
+        std::ifstream in(dir + ".asm");
+        std::stringstream ss;
+        ss << in.rdbuf();
+        return ss.str();
+    }
+};
+
+// Passes see one function at a time, with the code before the first function as its own unit
+TEST_F(PipelineTest, GroupsByFunction)
+{
+    writeFile("push constant 1\n"
+              "function Main.main 1\npush local 0\nreturn\n"
+              "function Main.f 0\ncall Main.main 0\nreturn\n");
+
+    std::vector<std::pair<std::string, std::size_t>> seen;
+    {
+        Vm::CodeWriter writer{ dir + ".asm" };
+        Pipeline pipeline{ writer };
+        pipeline.AddPass([&seen](Vm::Function& f, Arena&) { seen.emplace_back(f.name, f.body.size()); });
+        pipeline.Translate(dir + ".vm");
+
+        EXPECT_EQ(pipeline.GetStats().functions, 2u);
+        EXPECT_EQ(pipeline.GetStats().commands, 7u);
+        EXPECT_EQ(pipeline.GetStats().largest, 3u);
+    }
+
+    const std::vector<std::pair<std::string, std::size_t>> expected{
+        {          "", 1 },
+        { "Main.main", 3 },
+        {    "Main.f", 3 },
+    };
+    EXPECT_EQ(seen, expected);
+    EXPECT_NE(readOutput().find("(Main.f)"), std::string::npos);
+}
+
+// IR memory depends on the largest function, not on the size of the input
+TEST_F(PipelineTest, BoundedMemory)
+{
+    const auto peak = [this](int functions) {
+        std::string src;
+        for (int f = 0; f < functions; f++) {
+            src += "function Main.f" + std::to_string(f) + " 2\n";
+            for (int i = 0; i < 200; i++) {
+                src += "push local 1\npush constant 7\nadd\npop local 0\n";
+            }
+            src += "return\n";
+        }
+        Vm::CodeWriter writer{ [](std::string_view) {} };
+        Pipeline pipeline{ writer };
+        pipeline.Translate(src, "Main");
+        EXPECT_EQ(pipeline.GetStats().functions, static_cast<std::size_t>(functions));
+        return pipeline.GetStats().arena_bytes;
+    };
+
+    EXPECT_EQ(peak(1), peak(200));
+}
+
+// A pass may rewrite the function, allocating from the arena
+TEST_F(PipelineTest, PassRewrites)
+{
+    std::string text;
+    {
+        Vm::CodeWriter writer{ [&text](std::string_view s) { text += s; } };
+        Pipeline pipeline{ writer };
+        pipeline.AddPass([](Vm::Function& f, Arena& arena) {
+            for (auto&& c : f.body) {
+                if (c.type == Vm::Parser::Cmd::Push) {
+                    c.arg1 = arena.Copy("temp");
+                }
+            }
+        });
+        pipeline.Translate(std::string_view{ "function Main.main 0\npush constant 1\nreturn\n" }, "Main");
+    }
+    EXPECT_NE(text.find("@6\nD=M\n"), std::string::npos);
+}
+
+// In memory the whole program is kept for the assembler, and assembles like the text
+TEST_F(PipelineTest, IntoListing)
+{
+    const std::string_view source{ "function Main.main 1\npush constant 3\ncall Main.f 1\npop local 0\nlabel L\ngoto L\n"
+                                   "function Main.f 0\npush argument 0\npush constant 1\ngt\nreturn\n" };
+    std::string text;
+    {
+        Vm::CodeWriter writer{ [&text](std::string_view s) { text += s; } };
+        Pipeline pipeline{ writer };
+        pipeline.Translate(source, "Main");
+    }
+    Asm::Listing parsed;
+    Asm::ParseAsm(text, parsed);
+    Asm::Program from_text;
+    Asm::Assemble(parsed, from_text);
+
+    Asm::Listing listing;
+    {
+        Vm::CodeWriter writer{ listing };
+        Pipeline pipeline{ writer };
+        pipeline.Translate(source, "Main");
+    }
+    Asm::Program in_memory;
+    Asm::Assemble(listing, in_memory);
+
+    EXPECT_EQ(in_memory.words, from_text.words);
+    EXPECT_EQ(in_memory.labels.size(), from_text.labels.size());
+}
@@ -0,0 +1,100 @@
+// Profile-guided translation tests
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../cfg.h"
+#include "../code_writer.h"
+#include "../oracle.h"
+#include "../pipeline.h"
+#include "../profile.h"
+
+// as 5/emu's hackemu --profile writes it
+static constexpr std::string_view PROFILE{ "hackprof 1\n"
+                                           "cycles 1000\n"
+                                           "function Main.f 100 60\n"
+                                           "function Main.g 5 900\n"
+                                           "function Sys.init 1 40\n"
+                                           "label HALT 1\n"
+                                           "label RARE 100\n" };
+
+static Vm::Profile
+Parse(std::string_view text)
+{
+    Vm::Profile profile;
+    std::istringstream in{ std::string{ text } };
+    EXPECT_TRUE(profile.Parse(in));
+    return profile;
+}
+
+TEST(ProfileTest, Parse)
+{
+    const Vm::Profile profile = Parse(PROFILE);
+    EXPECT_EQ(profile.Count("RARE"), 100);
+    EXPECT_EQ(profile.Count("NEVER"), 0);
+    EXPECT_EQ(profile.Entries("Main.f"), 100);
+    EXPECT_EQ(profile.Entries("Main.h"), 0);
+    // 900 of 1000 cycles are in Main.g
+    EXPECT_TRUE(profile.Hot("Main.g"));
+    EXPECT_FALSE(profile.Hot("Main.f"));
+    EXPECT_FALSE(profile.Hot("Sys.init"));
+
+    Vm::Profile other;
+    std::istringstream bad{ "hackprof 2\n" };
+    EXPECT_FALSE(other.Parse(bad));
+}
+
+// The branch the profile has taken every time falls through, the one it
+// never took goes to the end
+TEST(ProfileTest, ColdBlockLast)
+{
+    const Vm::Profile profile = Parse(PROFILE);
+    std::vector<std::string> out;
+    Vm::CodeWriter writer{ [](std::string_view) {} };
+    Vm::Pipeline pipeline{ writer };
+    pipeline.AddPass(Vm::ProfiledControlFlow(profile));
+    pipeline.AddPass([&out](Vm::Function& f, Vm::Arena&) {
+        for (const Vm::Command& c : f.body) {
+            out.push_back(std::string{ c.arg1 });
+        }
+    });
+    pipeline.Translate("function Main.f 0\npush argument 0\nif-goto RARE\n"
+                       "push constant 1\nreturn\n"
+                       "label RARE\npush constant 2\nreturn\n",
+                       "Main");
+
+    const std::vector<std::string> expected{ "Main.f", "argument", "Main.f$cfg.1", "RARE", "constant", "",
+                                             "Main.f$cfg.1", "constant", "" };
+    EXPECT_EQ(out, expected);
+}
+
+// Comparisons of a cold function call a shared routine: fewer
+// instructions, same results
+TEST(ProfileTest, CompactComparisons)
+{
+    static constexpr std::string_view PROGRAM{
+        "function Sys.init 0\n"
+        "push constant 3\npush constant 5\ncall Main.f 2\npop static 0\n"
+        "push constant 5\npush constant 3\ncall Main.f 2\npop static 1\n"
+        "push constant 4\npush constant 4\ncall Main.f 2\npop static 2\n"
+        "label HALT\ngoto HALT\n"
+        "function Main.f 0\n"
+        "push argument 0\npush argument 1\neq\n"
+        "push argument 0\npush argument 1\ngt\n"
+        "push argument 0\npush argument 1\nlt\n"
+        "push argument 0\npush argument 1\nlt\n"
+        "add\nadd\nadd\nreturn\n"
+    };
+    const Vm::Profile profile = Parse(PROFILE);
+    const Vm::Oracle oracle{ 100000 };
+    const auto compact = Vm::Oracle::WithPasses({}, &profile);
+    EXPECT_FALSE(oracle.Compare(PROGRAM, compact));
+
+    Asm::Listing full;
+    Asm::Listing small;
+    Vm::Oracle::WithPasses({})(PROGRAM, full);
+    compact(PROGRAM, small);
+    EXPECT_LT(small.Code().size(), full.Code().size());
+}
@@ -0,0 +1,169 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../../6/asm/assembler.h"
+#include "../../6/asm/object.h"
+#include "cfg.h"
+#include "code_writer.h"
+#include "pipeline.h"
+#include "profile.h"
+
+static void
+Usage()
+{
+    std::cout << "Usage: vmhack <input.vm|dir> [lib.o...] [options]\n";
+    std::cout << "  translates VM code and assembles it in one process\n";
+    std::cout << "  lib.o            : objects of `vmhack -c` to link, e.g. a prebuilt OS\n";
+    std::cout << "  -c               : write a relocatable object without bootstrap instead\n";
+    std::cout << "  -o out.hack      : machine code (default: <input>.hack or .o, like vm's .asm)\n";
+    std::cout << "  --asm out.asm    : also write the assembly\n";
+    std::cout << "  --sym out.sym    : write the label addresses\n";
+    std::cout << "  --profile prof   : of `hackemu --profile` on an earlier build: hot paths fall\n";
+    std::cout << "                     through and cold functions are written for size\n";
+}
+
+struct Options
+{
+    std::string in_path;
+    std::string hack_path;
+    std::string asm_path;
+    std::string sym_path;
+    std::string profile_path;
+    std::vector<std::string> objects;
+    bool compile{ false };
+};
+
+static bool
+ParseArgs(int argc, char const* argv[], Options& opt)
+{
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            opt.hack_path = argv[++i];
+        } else if (arg == "--asm" && i + 1 < argc) {
+            opt.asm_path = argv[++i];
+        } else if (arg == "--sym" && i + 1 < argc) {
+            opt.sym_path = argv[++i];
+        } else if (arg == "--profile" && i + 1 < argc) {
+            opt.profile_path = argv[++i];
+        } else if (arg == "-c") {
+            opt.compile = true;
+        } else if (arg.ends_with(".o")) {
+            opt.objects.push_back(arg);
+        } else if (!arg.empty() && arg.front() != '-' && opt.in_path.empty()) {
+            opt.in_path = arg;
+        } else {
+            return false;
+        }
+    }
+    return !opt.in_path.empty();
+}
+
+int
+main(int argc, char const* argv[])
+{
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        Usage();
+        return -1;
+    }
+
+    // dir or .vm
+    const std::vector<std::string> target_vm = Vm::GetVmFiles(opt.in_path);
+    if (target_vm.empty()) {
+        Usage();
+        return -1;
+    }
+    if (opt.hack_path.empty()) {
+        opt.hack_path = Vm::PathToFilename(opt.in_path).append(opt.compile ? ".o" : ".hack");
+    }
+
+    // read the libraries first: a bad object is reported before any work
+    std::vector<Asm::Object> objects(opt.objects.size() + 1);
+    for (std::size_t i = 0; i < opt.objects.size(); i++) {
+        if (!Asm::ReadObject(opt.objects[i], objects[i + 1])) {
+            return -1;
+        }
+    }
+
+    Vm::Profile profile;
+    if (!opt.profile_path.empty() && !profile.Load(opt.profile_path)) {
+        return -1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // the translator appends instructions, the assembler reads them as they are
+    Asm::Listing listing;
+    Vm::CodeWriter::Selection selection;
+    Vm::Pipeline::Stats stats;
+    {
+        Vm::CodeWriter writer{ listing, !opt.compile };
+        Vm::Pipeline pipeline{ writer };
+        if (opt.profile_path.empty()) {
+            pipeline.AddPass(Vm::OptimiseControlFlow);
+        } else {
+            pipeline.AddPass(Vm::ProfiledControlFlow(profile));
+            pipeline.SetProfile(&profile);
+        }
+        pipeline.SetTailCalls(true);
+        // an object's functions may be called from other objects with full frames
+        if (!opt.compile) {
+            for (auto&& path : target_vm) {
+                pipeline.Analyze(path);
+            }
+        }
+        for (auto&& path : target_vm) {
+            pipeline.Translate(path);
+        }
+        selection = writer.GetSelection();
+        stats     = pipeline.GetStats();
+    }
+
+    if (opt.compile) {
+        Asm::Compile(listing, objects.front());
+        return Asm::WriteObject(objects.front(), opt.hack_path) ? 0 : -1;
+    }
+
+    // the program comes first, its bootstrap at address 0
+    Asm::Program program;
+    if (opt.objects.empty()) {
+        Asm::Assemble(listing, program);
+    } else {
+        Asm::Compile(listing, objects.front());
+        Asm::Link(objects, program);
+    }
+    if (!Asm::WriteHack(program, opt.hack_path)) {
+        return -1;
+    }
+    if (!opt.sym_path.empty() && !Asm::WriteSymbols(program, opt.sym_path)) {
+        return -1;
+    }
+    if (!opt.asm_path.empty()) {
+        std::ofstream out{ opt.asm_path, std::ios::out | std::ios::trunc };
+        Asm::WriteAsm(listing, [&out](std::string_view text) {
+            out.write(text.data(), static_cast<std::streamsize>(text.size()));
+        });
+    }
+
+    const double ms =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << target_vm.size() << " files, " << opt.objects.size() << " objects, " << program.words.size()
+              << " instructions, " << listing.SymbolCount() << " symbols in " << ms << " ms\n";
+    std::cout << "selection: " << selection.rewritten << " of " << selection.commands
+              << " in cheaper forms, saving " << selection.saved << " instructions\n";
+    if (!opt.profile_path.empty()) {
+        std::cout << "profile: " << stats.compact << " of " << stats.functions << " functions written for size\n";
+    }
+    std::cout << "out: " << opt.hack_path << "\n";
+    if (program.words.size() > 32768) {
+        std::cerr << "warning: " << program.words.size() << " instructions do not fit in ROM32K\n";
+    }
+
+    return 0;
+}